@@ -12,6 +12,7 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <cmath>
 
 #include "VecND.h"
 #include "Geometry.h"
@@ -35,6 +36,21 @@ enum class BdryType
   INTERIOR 
 }; 
 
+/********************************************************************* 
+* The geometric description of a boundary, which is approximated 
+* by its straight edges
+* > Polygon: The edges are the exact boundary
+* > Circle:  The edges are chords of a circle
+* > Spline:  The edges are chords of a smooth curve through the 
+*            boundary vertices, which is only broken at corners
+*********************************************************************/
+enum class BdryCurve
+{
+  POLYGON,
+  CIRCLE,
+  SPLINE
+};
+
 class Domain;
 
 
@@ -172,6 +188,79 @@ public:
   { return (btype_ == BdryType::EXTERIOR); }
   bool is_interior() const
   { return (btype_ == BdryType::INTERIOR); }
+  BdryCurve curve() const { return curve_; }
+  double corner_angle() const { return corner_angle_; }
+
+  /*------------------------------------------------------------------
+  | Describe the boundary by a smooth curve through its vertices, 
+  | e.g. for airfoils that are defined from a list of coordinates. 
+  | The curve is broken at vertices, where the boundary turns by 
+  | more than <corner_angle> (in radians).
+  ------------------------------------------------------------------*/
+  void set_curve_spline(double corner_angle = M_PI / 6.0)
+  {
+    curve_        = BdryCurve::SPLINE;
+    corner_angle_ = corner_angle;
+  }
+
+  /*------------------------------------------------------------------
+  | Describe the boundary by its straight edges
+  ------------------------------------------------------------------*/
+  void set_curve_polygon() { curve_ = BdryCurve::POLYGON; }
+
+  /*------------------------------------------------------------------
+  | Get the location on the boundary curve, that corresponds to the
+  | location xy(t) = (1-t) * v1 + t * v2 on a given edge of this 
+  | boundary, where 0 <= t <= 1
+  ------------------------------------------------------------------*/
+  Vec2d curve_point(const Edge& e, double t) const
+  {
+    const Vec2d& p = e.v1().xy();
+    const Vec2d& q = e.v2().xy();
+
+    if ( curve_ == BdryCurve::CIRCLE )
+    {
+      // Interpolate the angle, in order to map equidistant
+      // locations on the chord to equidistant locations on the arc
+      const Vec2d a = p - circle_xy_;
+      const Vec2d b = q - circle_xy_;
+      const double phi = t * std::atan2( cross(a, b), dot(a, b) );
+      const double c = std::cos( phi );
+      const double s = std::sin( phi );
+      const Vec2d d { c * a.x - s * a.y, s * a.x + c * a.y };
+
+      return circle_xy_ + circle_r_ / d.norm() * d;
+    }
+
+    if ( curve_ == BdryCurve::SPLINE )
+    {
+      // Cubic hermite interpolation with tangents, whose length
+      // equals the edge length
+      const double l = ( q - p ).norm();
+      const Vec2d  d = ( q - p ) / l;
+      Vec2d d1 = d;
+      Vec2d d2 = d;
+
+      const Edge* e_prev = e.get_prev_edge();
+      const Edge* e_next = e.get_next_edge();
+
+      if ( e_prev )
+        d1 = curve_tangent( e_prev->v1().xy(), p, q, d1 );
+      if ( e_next )
+        d2 = curve_tangent( p, q, e_next->v2().xy(), d2 );
+
+      const double t2 = t * t;
+      const double t3 = t2 * t;
+
+      return (  2.0*t3 - 3.0*t2 + 1.0 ) * p
+           + ( -2.0*t3 + 3.0*t2       ) * q
+           + l * ( t3 - 2.0*t2 + t    ) * d1
+           + l * ( t3 - t2            ) * d2;
+    }
+
+    return (1.0 - t) * p + t * q;
+
+  } // Boundary::curve_point()
 
   /*------------------------------------------------------------------
   | Override insert_edge() method of parent EdgeList, since all 
@@ -245,7 +334,9 @@ public:
                           const Vec2d& xy, double a,
                           double mesh_size=0.0, double mesh_range=0.0)
   {
+    const BdryCurve curve = curve_;
     set_shape_circle(marker, xy, a/sqrt(3), 3, mesh_size, mesh_range);
+    curve_ = curve;
 
   } // Boundary::set_shape_square()
 
@@ -289,6 +380,8 @@ public:
     if ( n < 3 ) 
       return;
 
+    const bool is_empty = ( edges_.size() == 0 );
+
     std::vector<Vec2d> v_shape;
     std::vector<Vec2d> v_properties;
     std::vector<int>   e_markers;
@@ -307,11 +400,37 @@ public:
 
     create_boundary_shape(v_shape, v_properties, e_markers);
 
+    if ( is_empty )
+    {
+      curve_     = BdryCurve::CIRCLE;
+      circle_xy_ = xy;
+      circle_r_  = r;
+    }
+
   } // Boundary::set_shape_Circle()
 
 
 private:
 
+  /*------------------------------------------------------------------
+  | The unit tangent of the spline curve at vertex q, which is 
+  | located between the vertices p and r. The one-sided tangent
+  | <d> is returned at corners.
+  ------------------------------------------------------------------*/
+  Vec2d curve_tangent(const Vec2d& p, const Vec2d& q, const Vec2d& r,
+                      const Vec2d& d) const
+  {
+    const Vec2d a = ( q - p ) / ( q - p ).norm();
+    const Vec2d b = ( r - q ) / ( r - q ).norm();
+
+    if ( std::acos( MAX(-1.0, MIN(1.0, dot(a, b))) ) > corner_angle_ )
+      return d;
+
+    const Vec2d c = a + b;
+    return c / c.norm();
+
+  } // Boundary::curve_tangent()
+
   /*------------------------------------------------------------------
   | Create the boundary from a given shape
   ------------------------------------------------------------------*/
@@ -377,6 +496,11 @@ private:
   BdryType  btype_;
   Vertices* domain_vertices_;
 
+  BdryCurve curve_        { BdryCurve::POLYGON };
+  double    corner_angle_ { M_PI / 6.0 };
+  Vec2d     circle_xy_    { 0.0, 0.0 };
+  double    circle_r_     { 0.0 };
+
 
 }; // Boundary
 
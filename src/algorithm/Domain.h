@@ -12,8 +12,14 @@
 #include <utility>        // std::move
 #include <array>          // std::array
 #include <functional>     // std::function
+#include <algorithm>      // std::count
+#include <cmath>          // std::ceil, std::log, std::sqrt
+#include <cfloat>         // DBL_MAX
 
 #include "Boundary.h"
+#include "SizeFunctionProfiler.h"
+#include "SizeFunctionTree.h"
+#include "MeshTransformation.h"
 
 namespace TQMesh {
 namespace TQAlgorithm {
@@ -25,6 +31,29 @@ using namespace CppUtils;
 *********************************************************************/
 using UserSizeFunction = std::function<double(const Vec2d& xy)>;
 
+/*********************************************************************
+* Methods to distribute vertices along the domain boundary edges
+* - PredictorCorrector: March along the edge with steps of the
+*                       local mesh size
+* - Quadrature:         Integrate 1/size along the edge with adaptive
+*                       Gauss-Kronrod quadrature and place vertices 
+*                       at equal increments of the integral
+*********************************************************************/
+enum class EdgeDiscretization { PredictorCorrector, Quadrature };
+
+/*********************************************************************
+* A pair of periodic boundaries: The <transformation> maps the edges 
+* with the <source_marker> onto the edges with the <target_marker>.
+* Since both boundaries are oriented counter-clockwise, a source 
+* edge (v1,v2) is mapped onto a target edge (v2,v1).
+*********************************************************************/
+struct PeriodicPair
+{
+  int                source_marker;
+  int                target_marker;
+  MeshTransformation transformation;
+};
+
 
 /*********************************************************************
 * This class defines the local mesh size
@@ -42,6 +71,20 @@ public:
   ------------------------------------------------------------------*/
   const UserSizeFunction& user_size_function() const { return f_; }
   UserSizeFunction& user_size_function() { return f_; }
+  const SizeFunctionTree& tree() const { return tree_; }
+  SizeFunctionTree& tree() { return tree_; }
+
+  /*------------------------------------------------------------------
+  | Evaluate the user size function - use its tree approximation
+  | if possible
+  ------------------------------------------------------------------*/
+  inline double evaluate_user(const Vec2d& xy) const
+  {
+    double h;
+    if ( tree_.lookup(xy, h) )
+      return h;
+    return f_(xy);
+  }
 
   /*------------------------------------------------------------------
   | Evaluate the domain's size function at a given point
@@ -51,7 +94,7 @@ public:
                          const Domain& domain) const
   {
     // The underlying size function
-    const double h_fun = f_(xy);
+    const double h_fun = evaluate_user(xy);
 
     if ( h_fun <= 0.0 )
       TERMINATE("SizeFunction::evaluate(): Encountered invalid value (<=0).");
@@ -177,10 +220,312 @@ private:
   | Attributes
   ------------------------------------------------------------------*/
   UserSizeFunction f_;
+  SizeFunctionTree tree_ {};
 
 }; // SizeFunction
 
 
+
+/*********************************************************************
+* A cartesian background grid that stores per-cell bounds of the
+* minimum and maximum of the user size function. Cells, in which the
+* size varies less than a given relative tolerance and which are not 
+* affected by the blending of boundary vertices or fixed vertices, 
+* are marked as uniform. For points inside of these cells, the size 
+* function is returned directly from the grid, which avoids the 
+* evaluation of all boundary contributions.
+*
+* The user size function is sampled on <n_sub> x <n_sub> sub-cells
+* of every cell. Each point of a cell is located within half of a
+* sub-cell diagonal to its closest sample. Hence, for a user size
+* function with Lipschitz constant <lipschitz>, the sampled extrema
+* are widened by the margin lipschitz * sub-cell diagonal / 2, which
+* turns them into strict bounds. For a vanishing Lipschitz constant,
+* the bounds are only estimates, which miss features that are 
+* narrower than a sub-cell.
+*********************************************************************/
+class UniformSizeGrid
+{
+public:
+
+  /*------------------------------------------------------------------
+  | Getter
+  ------------------------------------------------------------------*/
+  bool empty() const { return h_min_.size() == 0; }
+  size_t n_cells() const { return h_min_.size(); }
+  size_t n_uniform_cells() const { return n_uniform_; }
+  double cell_size() const { return cell_size_; }
+  double tolerance() const { return tolerance_; }
+  size_t n_subcells() const { return n_sub_; }
+  double lipschitz() const { return lipschitz_; }
+  double margin() const { return margin_; }
+
+  /*------------------------------------------------------------------
+  | Remove all cells
+  ------------------------------------------------------------------*/
+  void clear()
+  {
+    h_min_.clear();
+    h_max_.clear();
+    uniform_.clear();
+    nx_ = 0;
+    ny_ = 0;
+    n_uniform_ = 0;
+    margin_ = 0.0;
+
+  } // UniformSizeGrid::clear()
+
+  /*------------------------------------------------------------------
+  | Return true, if the size function is uniform at a given point.
+  | In this case, the cell's size is returned in <h>.
+  ------------------------------------------------------------------*/
+  inline bool lookup(const Vec2d& xy, double& h) const
+  {
+    if ( empty() )
+      return false;
+
+    const double fx = (xy.x - xy_min_.x) / cell_size_;
+    const double fy = (xy.y - xy_min_.y) / cell_size_;
+
+    if ( fx < 0.0 || fy < 0.0 )
+      return false;
+
+    const size_t i = static_cast<size_t>( fx );
+    const size_t j = static_cast<size_t>( fy );
+
+    if ( i >= nx_ || j >= ny_ )
+      return false;
+
+    const size_t k = j * nx_ + i;
+
+    if ( !uniform_[k] )
+      return false;
+
+    h = h_min_[k];
+    return true;
+
+  } // UniformSizeGrid::lookup()
+
+  /*------------------------------------------------------------------
+  | Initialize the grid for a given domain and its size function
+  ------------------------------------------------------------------*/
+  template <typename Domain>
+  void init(const Domain& domain, const SizeFunction& size_fun,
+            double cell_size, double tolerance, 
+            size_t n_sub, double lipschitz)
+  {
+    if ( cell_size <= 0.0 )
+      TERMINATE("UniformSizeGrid::init(): Invalid cell size (<=0).");
+
+    if ( tolerance <= 0.0 || tolerance >= 1.0 )
+      TERMINATE("UniformSizeGrid::init(): Invalid tolerance.");
+
+    if ( n_sub < 1 )
+      TERMINATE("UniformSizeGrid::init(): Invalid number of sub-cells.");
+
+    if ( lipschitz < 0.0 )
+      TERMINATE("UniformSizeGrid::init(): Invalid Lipschitz constant.");
+
+    clear();
+
+    cell_size_ = cell_size;
+    tolerance_ = tolerance;
+    n_sub_     = n_sub;
+    lipschitz_ = lipschitz;
+
+    // Bounding box of all boundary vertices
+    bool  found = false;
+    Vec2d xy_max {};
+
+    for ( const auto& boundary : domain )
+      for ( const auto& edge : boundary.get()->edges() )
+        for ( const Vec2d& xy : { edge->v1().xy(), edge->v2().xy() } )
+        {
+          if ( !found )
+          {
+            xy_min_ = xy;
+            xy_max  = xy;
+            found   = true;
+          }
+          xy_min_.x = MIN(xy_min_.x, xy.x);
+          xy_min_.y = MIN(xy_min_.y, xy.y);
+          xy_max.x  = MAX(xy_max.x, xy.x);
+          xy_max.y  = MAX(xy_max.y, xy.y);
+        }
+
+    if ( !found )
+      return;
+
+    nx_ = MAX(size_t{1}, static_cast<size_t>( 
+                   std::ceil((xy_max.x-xy_min_.x) / cell_size_) ));
+    ny_ = MAX(size_t{1}, static_cast<size_t>( 
+                   std::ceil((xy_max.y-xy_min_.y) / cell_size_) ));
+
+    // Sample the user size function at the sub-cell corners
+    const UserSizeFunction& f = size_fun.user_size_function();
+
+    const double ds = cell_size_ / static_cast<double>(n_sub_);
+    const size_t mx = nx_ * n_sub_ + 1;
+    const size_t my = ny_ * n_sub_ + 1;
+
+    std::vector<double> f_nodes ( mx * my );
+
+    for ( size_t j = 0; j < my; ++j )
+      for ( size_t i = 0; i < mx; ++i )
+      {
+        const double f_ij = f( node_xy(i, j, ds) );
+
+        if ( f_ij <= 0.0 )
+          TERMINATE("UniformSizeGrid::init(): "
+                    "Encountered invalid value (<=0).");
+
+        f_nodes[j*mx+i] = f_ij;
+      }
+
+    // Maximum deviation between a point and its closest sample
+    margin_ = lipschitz_ * ds * M_SQRT1_2;
+
+    h_min_.resize( nx_ * ny_ );
+    h_max_.resize( nx_ * ny_ );
+    uniform_.resize( nx_ * ny_ );
+
+    double f_min = DBL_MAX;
+    double f_max = 0.0;
+
+    // Bound the extrema of each cell by its samples and the margin
+    for ( size_t j = 0; j < ny_; ++j )
+      for ( size_t i = 0; i < nx_; ++i )
+      {
+        double h_lo = DBL_MAX;
+        double h_hi = 0.0;
+
+        for ( size_t jj = j*n_sub_; jj <= (j+1)*n_sub_; ++jj )
+          for ( size_t ii = i*n_sub_; ii <= (i+1)*n_sub_; ++ii )
+          {
+            h_lo = MIN(h_lo, f_nodes[jj*mx+ii]);
+            h_hi = MAX(h_hi, f_nodes[jj*mx+ii]);
+          }
+
+        h_lo -= margin_;
+        h_hi += margin_;
+
+        const size_t k = j * nx_ + i;
+        h_min_[k]   = h_lo;
+        h_max_[k]   = h_hi;
+        uniform_[k] = ( h_lo > 0.0 && h_hi - h_lo <= tolerance_ * h_lo );
+
+        // Only uniform cells are affected by the exclusion below
+        if ( !uniform_[k] )
+          continue;
+
+        f_min = MIN(f_min, h_lo);
+        f_max = MAX(f_max, h_hi);
+      }
+
+    if ( f_max <= 0.0 )
+      return;
+
+    // A vertex contribution z * (h_fun - h_v) stays below 
+    // tolerance * h_fun, if its weight z = exp(-d^2/s^2) falls 
+    // below the tolerance, i.e. for d > s * sqrt( ln(1/tolerance) )
+    const double z_fac = std::sqrt( std::log(1.0 / tolerance_) );
+
+    // Exclude cells that are affected by boundary vertices
+    for ( const auto& boundary : domain )
+      for ( const auto& edge : boundary.get()->edges() )
+      {
+        const double el = edge->length();
+        const double r  = MAX(f_max/el, el/f_min);
+
+        for ( const Vertex* v : { &edge->v1(), &edge->v2() } )
+        {
+          const double h_v = (v->mesh_size() <= 0.0)
+                           ? el : MIN(v->mesh_size(), el);
+
+          // Vertex can not reduce the size function
+          if ( h_v >= f_max )
+            continue;
+
+          const double s = (v->size_range() <= 0.0) 
+                         ? el : v->size_range();
+
+          exclude_cells( v->xy(), r * s * z_fac );
+        }
+      }
+
+    // Exclude cells that are affected by fixed vertices
+    for ( const Vertex* v : domain.fixed_vertices() )
+    {
+      if ( v->mesh_size() <= 0.0 || v->mesh_size() >= f_max )
+        continue;
+
+      const double s = (v->size_range() <= 0.0) 
+                     ? f_max : v->size_range();
+
+      exclude_cells( v->xy(), s * z_fac );
+    }
+
+    n_uniform_ = std::count( uniform_.begin(), uniform_.end(), true );
+
+  } // UniformSizeGrid::init()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Return the coordinates of a node of the sampling grid with 
+  | spacing <ds>
+  ------------------------------------------------------------------*/
+  Vec2d node_xy(size_t i, size_t j, double ds) const
+  {
+    return { xy_min_.x + static_cast<double>(i) * ds,
+             xy_min_.y + static_cast<double>(j) * ds };
+  }
+
+  /*------------------------------------------------------------------
+  | Mark all cells as non-uniform, that overlap with the bounding
+  | box of a circle with center <xy> and radius <r>
+  ------------------------------------------------------------------*/
+  void exclude_cells(const Vec2d& xy, double r)
+  {
+    const double x0 = (xy.x - r - xy_min_.x) / cell_size_;
+    const double x1 = (xy.x + r - xy_min_.x) / cell_size_;
+    const double y0 = (xy.y - r - xy_min_.y) / cell_size_;
+    const double y1 = (xy.y + r - xy_min_.y) / cell_size_;
+
+    if ( x1 < 0.0 || y1 < 0.0 )
+      return;
+
+    const size_t i0 = static_cast<size_t>( MAX(x0, 0.0) );
+    const size_t j0 = static_cast<size_t>( MAX(y0, 0.0) );
+    const size_t i1 = MIN( static_cast<size_t>(x1), nx_-1 );
+    const size_t j1 = MIN( static_cast<size_t>(y1), ny_-1 );
+
+    for ( size_t j = j0; j <= j1; ++j )
+      for ( size_t i = i0; i <= i1; ++i )
+        uniform_[j * nx_ + i] = false;
+
+  } // UniformSizeGrid::exclude_cells()
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  Vec2d               xy_min_     {};
+  double              cell_size_  { 1.0 };
+  double              tolerance_  { 1.0E-2 };
+  size_t              n_sub_      { 4 };
+  double              lipschitz_  { 0.0 };
+  double              margin_     { 0.0 };
+  size_t              nx_         { 0 };
+  size_t              ny_         { 0 };
+  size_t              n_uniform_  { 0 };
+
+  std::vector<double> h_min_      {};
+  std::vector<double> h_max_      {};
+  std::vector<bool>   uniform_    {};
+
+}; // UniformSizeGrid
+
+
 /*********************************************************************
 * This class is a simple container for boundaries
 *********************************************************************/
@@ -248,6 +593,12 @@ public:
   const VertexVector& fixed_vertices() const { return fixed_verts_; }
   VertexVector& fixed_vertices() { return fixed_verts_; }
 
+  EdgeDiscretization edge_discretization() const 
+  { return edge_discretization_; }
+
+  const std::vector<PeriodicPair>& periodic_pairs() const 
+  { return periodic_pairs_; }
+
   /*------------------------------------------------------------------
   | Setter 
   ------------------------------------------------------------------*/
@@ -256,11 +607,141 @@ public:
   void quad_tree_max_depth(size_t v) { verts_.quad_tree().max_depth(v); }
   void quad_tree_center(const Vec2d& v) { verts_.quad_tree().center(v); }
 
+  void edge_discretization(EdgeDiscretization d) 
+  { edge_discretization_ = d; }
+
+  /*------------------------------------------------------------------
+  | Declare the boundary edges with the <target_marker> as periodic
+  | images of the boundary edges with the <source_marker>. The 
+  | target edges are not discretized on their own, but obtain the 
+  | mapped vertex distribution of their source edges.
+  ------------------------------------------------------------------*/
+  void add_periodic_pair(int source_marker, int target_marker,
+                         const MeshTransformation& transformation)
+  {
+    if ( source_marker == target_marker )
+      TERMINATE("Domain::add_periodic_pair(): "
+                "Source and target markers must differ.");
+
+    for ( const PeriodicPair& p : periodic_pairs_ )
+      if ( p.target_marker == target_marker || 
+           p.target_marker == source_marker ||
+           p.source_marker == target_marker  )
+        TERMINATE("Domain::add_periodic_pair(): "
+                  "Periodic pairs must not be chained.");
+
+    periodic_pairs_.push_back( 
+      { source_marker, target_marker, transformation } );
+  }
+
+  /*------------------------------------------------------------------
+  | Get the periodic pair, where the given marker is the target - 
+  | returns a nullptr if there is none
+  ------------------------------------------------------------------*/
+  const PeriodicPair* periodic_target(int marker) const
+  {
+    for ( const PeriodicPair& p : periodic_pairs_ )
+      if ( p.target_marker == marker )
+        return &p;
+    return nullptr;
+  }
+
   /*------------------------------------------------------------------
   | Evaluate the domain's size function at a given point
   ------------------------------------------------------------------*/
   inline double size_function(const Vec2d& xy) const
-  { return size_fun_.evaluate(xy, *this); }
+  { 
+    if ( !profiler_.enabled() )
+      return evaluate_size_function(xy);
+
+    const auto t0 = SizeFunctionProfiler::Clock::now();
+    const double h = evaluate_size_function(xy);
+    profiler_.record(xy, t0);
+
+    return h;
+  }
+
+  /*------------------------------------------------------------------
+  | Access the profiler of the size function evaluations. 
+  | Profiling must be enabled explicitly and does not change
+  | the evaluated values, hence it is accessible for const domains.
+  ------------------------------------------------------------------*/
+  SizeFunctionProfiler& size_function_profiler() const 
+  { return profiler_; }
+
+  /*------------------------------------------------------------------
+  | Initialize a background grid, which is used to detect regions 
+  | of uniform mesh size. Within these regions, the size function
+  | is looked up from the grid instead of being evaluated.
+  | The user size function is sampled on <n_sub> x <n_sub> sub-cells
+  | per cell. The lookup is only guaranteed to be within <tolerance>
+  | if <lipschitz> bounds the slope of the user size function. With
+  | the default of zero, the grid is only valid for user size 
+  | functions that are smooth at the scale of a sub-cell - narrower
+  | features, e.g. thin refinement bands, are missed.
+  | Adding or removing boundaries or fixed vertices clears the grid.
+  | It must be re-initialized manually after edges have been added
+  | to an existing boundary.
+  ------------------------------------------------------------------*/
+  void init_uniform_size_grid(double cell_size, 
+                              double tolerance = 1.0E-2,
+                              size_t n_sub = 4,
+                              double lipschitz = 0.0)
+  { size_grid_.init(*this, size_fun_, cell_size, tolerance, 
+                    n_sub, lipschitz); }
+
+  void clear_uniform_size_grid() { size_grid_.clear(); }
+
+  const UniformSizeGrid& uniform_size_grid() const { return size_grid_; }
+
+  /*------------------------------------------------------------------
+  | Approximate the user size function by an adaptive quadtree,
+  | which covers the bounding box of all boundaries. The tree is 
+  | refined until the relative interpolation error estimate drops
+  | below <tolerance>. The boundary and fixed vertex contributions
+  | are still evaluated exactly.
+  | Adding or removing boundaries clears the tree. It must be 
+  | re-initialized manually after edges have been added to an
+  | existing boundary or after the user size function has been
+  | changed.
+  ------------------------------------------------------------------*/
+  void init_size_function_tree(double tolerance = 1.0E-3,
+                               size_t max_depth = 12,
+                               size_t min_depth = 3)
+  {
+    Vec2d xy_min {  DBL_MAX,  DBL_MAX };
+    Vec2d xy_max { -DBL_MAX, -DBL_MAX };
+
+    for ( const auto& boundary : *this )
+      for ( const auto& edge : boundary.get()->edges() )
+        for ( const Vec2d& xy : { edge->v1().xy(), edge->v2().xy() } )
+        {
+          xy_min.x = MIN(xy_min.x, xy.x);
+          xy_min.y = MIN(xy_min.y, xy.y);
+          xy_max.x = MAX(xy_max.x, xy.x);
+          xy_max.y = MAX(xy_max.y, xy.y);
+        }
+
+    if ( xy_max.x < xy_min.x )
+      TERMINATE("Domain::init_size_function_tree(): "
+                "The domain has no boundaries.");
+
+    SizeFunctionTree& tree = size_fun_.tree();
+
+    tree.init( size_fun_.user_size_function(), xy_min, xy_max,
+               tolerance, max_depth, min_depth );
+
+    if ( tree.n_unresolved_cells() > 0 )
+      LOG(WARNING) << "Domain::init_size_function_tree(): " 
+                   << tree.n_unresolved_cells() << " cells do not meet "
+                   << "the tolerance at the maximum depth (max. error: "
+                   << tree.max_error() << ").";
+  }
+
+  void clear_size_function_tree() { size_fun_.tree().clear(); }
+
+  const SizeFunctionTree& size_function_tree() const 
+  { return size_fun_.tree(); }
 
   /*------------------------------------------------------------------
   | Insert any boundary through constructor behind 
@@ -276,6 +757,8 @@ public:
 
     boundaries_.insert( pos, std::move(b_ptr) );
 
+    clear_size_approximations();
+
     return *ptr;
   }
 
@@ -302,7 +785,10 @@ public:
   | Remove a boundary from the domain
   ------------------------------------------------------------------*/
   void remove_boundary(size_t pos) 
-  { boundaries_.erase( boundaries_.begin()+pos ); }
+  { 
+    boundaries_.erase( boundaries_.begin()+pos ); 
+    clear_size_approximations();
+  }
 
   /*------------------------------------------------------------------
   | Access operator
@@ -399,6 +885,8 @@ public:
 
     fixed_verts_.push_back( &v_new );
 
+    size_grid_.clear();
+
     return v_new;
 
   } // Domain::add_fixed_vertex()
@@ -417,6 +905,8 @@ public:
 
     verts_.remove( v );
 
+    size_grid_.clear();
+
   } // Domain::remove_fixed_vertex()
 
   /*------------------------------------------------------------------
@@ -441,14 +931,48 @@ public:
 
 
 private:
+
+  /*------------------------------------------------------------------
+  | Remove the uniform size grid and the size function tree, since 
+  | both cover the state of the boundaries at their initialization
+  ------------------------------------------------------------------*/
+  void clear_size_approximations()
+  {
+    size_grid_.clear();
+    size_fun_.tree().clear();
+  }
+
+  /*------------------------------------------------------------------
+  | Evaluate the size function - use the uniform size grid if 
+  | possible
+  ------------------------------------------------------------------*/
+  inline double evaluate_size_function(const Vec2d& xy) const
+  {
+    double h;
+    if ( size_grid_.lookup(xy, h) )
+      return h;
+    return size_fun_.evaluate(xy, *this); 
+  }
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
   Vector           boundaries_;
 
   SizeFunction     size_fun_;
+  UniformSizeGrid  size_grid_ {};
+
+  mutable SizeFunctionProfiler profiler_ {};
   Vertices         verts_;
   VertexVector     fixed_verts_ {};
 
   double           edge_overlap_range_ { 1.5 };
 
+  EdgeDiscretization edge_discretization_ 
+  { EdgeDiscretization::PredictorCorrector };
+
+  std::vector<PeriodicPair> periodic_pairs_ {};
+
 }; // Domain
 
 } // namespace TQAlgorithm
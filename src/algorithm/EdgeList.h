@@ -69,6 +69,7 @@ public:
   : orient_ { el.orient_ }
   , edges_ { std::move( el.edges_ ) }
   , area_ { el.area_ }
+  , max_edge_length_ { el.max_edge_length_ }
   {}
 
   /*------------------------------------------------------------------
@@ -97,6 +98,7 @@ public:
   ------------------------------------------------------------------*/
   size_t size() const { return edges_.size(); }
   double area() const { return area_; }
+  double max_edge_length() const { return max_edge_length_; }
   bool is_ccw() const { return (orient_ == Orientation::CCW); }
   Orientation orient() const { return orient_; }
 
@@ -121,6 +123,8 @@ public:
     Edge& e = edges_.insert(pos, v1, v2, *this, marker);
     if ( orient_ != Orientation::NONE )
       compute_area();
+
+    max_edge_length_ = MAX(max_edge_length_, e.length());
     
     // Mark the added objects somehow
     mark_objects(v1, v2, e);
@@ -174,6 +178,8 @@ public:
 
     edges_.clear_waste();
 
+    max_edge_length_ = 0.0;
+
   } // EdgeList::clear_edges();
 
   /*------------------------------------------------------------------
@@ -586,6 +592,11 @@ protected:
   Container<Edge>     edges_ {};
   double              area_  {0.0};
 
+  // Monotone upper bound for the length of all edges in this list:
+  // It grows with every inserted edge, but removed edges do not
+  // lower it - it is only reset by clear_edges()
+  double              max_edge_length_ {0.0};
+
 
 }; // EdgeList
 
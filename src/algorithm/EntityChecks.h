@@ -7,9 +7,17 @@
 */
 #pragma once
 
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include <thread>
+
 #include "VecND.h"
 
+#include "utils.h"
 #include "Vertex.h"
+#include "Edge.h"
 #include "Triangle.h"
 #include "Quad.h"
 #include "Facet.h"
@@ -19,6 +27,20 @@ namespace TQAlgorithm {
 
 using namespace CppUtils;
 
+/*********************************************************************
+* Available modes for the mesh connectivity check
+* - Traversal: Search every mesh edge in the facet lists of its 
+*              adjacent vertices
+* - EdgeTable: Gather all facet half-edges and mesh edges in a flat 
+*              table, that is bucketed by the smaller vertex index, 
+*              and validate the table in a single linear pass
+*********************************************************************/
+enum class MeshCheckMode 
+{
+  Traversal,
+  EdgeTable,
+};
+
 /*********************************************************************
 * This class contains all functions that are required to verify 
 * different entitis for the mesh generation process
@@ -58,51 +80,71 @@ public:
       return false;
     }
 
+    // Gather all boundary edges of the domain in a single array
+    std::vector<BoundaryEdgeEntry> edges = gather_boundary_edges(domain);
+
     // Check if domain boundaries are traversable
-    for ( const auto& boundary : domain )
+    if ( !boundaries_are_traversable(edges) )
     {
-      Edge& e_start = boundary->edges()[0];
-
-      if ( !boundary->is_traversable(e_start, e_start) )
-      {
-        LOG(ERROR) << "Invalid domain: Boundaries not traversable.";
-        return false;
-      }
+      LOG(ERROR) << "Invalid domain: Boundaries not traversable.";
+      return false;
     }
 
     // Check if domain boundary edges are intersecting
-    for ( const auto& boundary : domain )
-    {
-      if ( boundary->intersects_self() )
-      {
-        LOG(ERROR) << "Invalid domain: Self-intersecting boundary.";
-        return false;
-      }
+    auto intersections = sweep_boundary_intersections(edges);
 
-      for ( const auto& nbr_boundary : domain )
-      {
-        if (nbr_boundary == boundary)
-          continue;
-
-        if ( boundary->intersects_edgelist( *nbr_boundary ) )
-        {
-          LOG(ERROR) << "Invalid domain: Intersection between two boundaries.";
-          return false;
-        }
-      }
+    for ( const auto& pair : intersections )
+    {
+      const BoundaryEdgeEntry& a = edges[pair.first];
+      const BoundaryEdgeEntry& b = edges[pair.second];
+
+      if ( a.i_bdry == b.i_bdry )
+        LOG(ERROR) << "Invalid domain: Self-intersecting boundary "
+                   << "at edges " << a.edge->xy() << " and " 
+                   << b.edge->xy() << ".";
+      else
+        LOG(ERROR) << "Invalid domain: Intersection between two boundaries "
+                   << "at edges " << a.edge->xy() << " and " 
+                   << b.edge->xy() << ".";
     }
 
-    return true;
+    return ( intersections.size() < 1 );
 
   } // check_domain_validity()
 
 
+  /*------------------------------------------------------------------
+  | Return all pairs of intersecting boundary edges of a given domain.
+  | Every pair is reported only once.
+  ------------------------------------------------------------------*/
+  template<typename Domain>
+  static inline std::vector<std::pair<const Edge*, const Edge*>>
+  get_boundary_intersections(const Domain& domain)
+  {
+    std::vector<BoundaryEdgeEntry> edges = gather_boundary_edges(domain);
+
+    std::vector<std::pair<const Edge*, const Edge*>> intersections {};
+
+    for ( const auto& pair : sweep_boundary_intersections(edges) )
+      intersections.push_back( { edges[pair.first].edge, 
+                                 edges[pair.second].edge } );
+
+    return intersections;
+
+  } // EntityChecks::get_boundary_intersections()
+
+
   /*------------------------------------------------------------------
   | Check the facet-vertex-edge connectivtiy of a given mesh
   ------------------------------------------------------------------*/
   template <typename Mesh>
-  static inline bool check_mesh_validity(Mesh& mesh)
+  static inline bool check_mesh_validity(Mesh& mesh, 
+                                         MeshCheckMode mode 
+                                           = MeshCheckMode::Traversal)
   { 
+    if ( mode == MeshCheckMode::EdgeTable )
+      return check_mesh_edge_table(mesh);
+
     // Check connectivity for interior edges
     for ( const auto& e_ptr : mesh.interior_edges() )
     {
@@ -169,21 +211,619 @@ public:
   } // EntityChecks::check_mesh_validity()
 
 
+  /*------------------------------------------------------------------
+  | Check the facet-vertex-edge connectivity of a given mesh by means
+  | of a flat half-edge table. 
+  | All facet half-edges as well as all interior and boundary edges 
+  | are stored as entries in a table, which is bucketed by the 
+  | smaller index of both edge vertices. Each bucket holds only a 
+  | few entries and is sorted locally, such that the entire check 
+  | is of linear complexity. 
+  | For every vertex pair, the following properties are checked:
+  | - Every facet side is represented by exactly one mesh edge
+  | - Every mesh edge is adjacent to one or two facets (manifold)
+  | - Two facets that share an edge traverse it in opposite 
+  |   directions (consistent orientation)
+  | - Boundary edges are adjacent to exactly one facet, which 
+  |   is located to the left of the edge
+  | Furthermore, every facet must be listed by all of its vertices
+  | and every facet listed by a vertex must contain it.
+  |
+  | The buckets are evaluated in independent chunks of size 
+  | "chunk_size", which are distributed among "n_threads" concurrent
+  | threads (0: hardware concurrency).
+  | The vertex indices of the mesh are not modified.
+  ------------------------------------------------------------------*/
+  template <typename Mesh>
+  static inline bool check_mesh_edge_table(Mesh& mesh, 
+                                           size_t chunk_size = 4096,
+                                           size_t n_threads = 0)
+  {
+    const size_t n_verts = mesh.vertices().size();
+
+    if ( n_verts < 1 )
+      return true;
+
+    // Assign consecutive local vertex indices
+    std::unordered_map<const Vertex*, unsigned int> indices {};
+    indices.reserve( n_verts );
+
+    unsigned int vertex_index = 0;
+    for ( auto& v_ptr : mesh.vertices() )
+      indices[ v_ptr.get() ] = vertex_index++;
+
+    // Every facet must be listed by its vertices and vice versa
+    if ( !check_vertex_facets(mesh.quads(), indices) )
+      return false;
+
+    if ( !check_vertex_facets(mesh.triangles(), indices) )
+      return false;
+
+    for ( auto& v_ptr : mesh.vertices() )
+      for ( const Facet* f : v_ptr->facets() )
+        if ( f->get_vertex_index( *v_ptr ) < 0 )
+          return false;
+
+    // Count the entries of each bucket
+    bool known_verts = true;
+    std::vector<size_t> offsets( n_verts + 1, 0 );
+
+    auto index = [&indices, &known_verts](const Vertex& v) 
+    { 
+      auto iter = indices.find( &v );
+
+      if ( iter != indices.end() )
+        return iter->second;
+
+      known_verts = false;
+      return 0u;
+    };
+
+    auto count_entry = [&offsets, &index](const Vertex& v1, 
+                                          const Vertex& v2)
+    { ++offsets[ MIN(index(v1), index(v2)) + 1 ]; };
+
+    for ( auto& q_ptr : mesh.quads() )
+      for ( int i = 0; i < 4; ++i )
+        count_entry( q_ptr->vertex(i), q_ptr->vertex((i+1)%4) );
+
+    for ( auto& t_ptr : mesh.triangles() )
+      for ( int i = 0; i < 3; ++i )
+        count_entry( t_ptr->vertex(i), t_ptr->vertex((i+1)%3) );
+
+    for ( auto& e_ptr : mesh.interior_edges() )
+      count_entry( e_ptr->v1(), e_ptr->v2() );
+
+    for ( auto& e_ptr : mesh.boundary_edges() )
+    {
+      ASSERT( e_ptr->v1().has_property( VertexProperty::on_boundary ),
+        "EntityChecks::check_mesh_edge_table(): Missing "
+        "vertex property \"on_boundary\".");
+      ASSERT( e_ptr->v2().has_property( VertexProperty::on_boundary ),
+        "EntityChecks::check_mesh_edge_table(): Missing "
+        "vertex property \"on_boundary\".");
+
+      count_entry( e_ptr->v1(), e_ptr->v2() );
+    }
+
+    // Edges or facets refer to vertices, that are not part of the mesh
+    if ( !known_verts )
+      return false;
+
+    for ( size_t i = 0; i < n_verts; ++i )
+      offsets[i+1] += offsets[i];
+
+    // Fill the table 
+    std::vector<EdgeTableEntry> table( offsets[n_verts] );
+    std::vector<size_t> fill_pos( offsets.begin(), offsets.end()-1 );
+
+    auto add_entry = [&table, &fill_pos, &index](const Vertex& v1, 
+                                                 const Vertex& v2,
+                                                 EdgeTableEntry::Owner owner)
+    {
+      const unsigned int i_1 = index(v1);
+      const unsigned int i_2 = index(v2);
+
+      const bool forward = ( i_1 < i_2 );
+      const unsigned int i_min = forward ? i_1 : i_2;
+      const unsigned int i_max = forward ? i_2 : i_1;
+
+      table[ fill_pos[i_min]++ ] = { i_max, forward, owner };
+    };
+
+    for ( auto& q_ptr : mesh.quads() )
+      for ( int i = 0; i < 4; ++i )
+        add_entry( q_ptr->vertex(i), q_ptr->vertex((i+1)%4), 
+                   EdgeTableEntry::Owner::Facet );
+
+    for ( auto& t_ptr : mesh.triangles() )
+      for ( int i = 0; i < 3; ++i )
+        add_entry( t_ptr->vertex(i), t_ptr->vertex((i+1)%3), 
+                   EdgeTableEntry::Owner::Facet );
+
+    for ( auto& e_ptr : mesh.interior_edges() )
+      add_entry( e_ptr->v1(), e_ptr->v2(), 
+                 EdgeTableEntry::Owner::InteriorEdge );
+
+    for ( auto& e_ptr : mesh.boundary_edges() )
+      add_entry( e_ptr->v1(), e_ptr->v2(), 
+                 EdgeTableEntry::Owner::BoundaryEdge );
+
+    // Validate the table chunk by chunk - every thread processes
+    // every n_threads-th chunk. The chunks refer to disjoint
+    // parts of the table.
+    chunk_size = MAX(chunk_size, static_cast<size_t>(1));
+
+    const size_t n_chunks = ( n_verts + chunk_size - 1 ) / chunk_size;
+
+    if ( n_threads < 1 )
+      n_threads = MAX( static_cast<size_t>(1), 
+                 static_cast<size_t>(std::thread::hardware_concurrency()) );
+
+    n_threads = MIN( n_threads, n_chunks );
+
+    std::vector<char> valid( n_threads, 1 );
+
+    auto check_chunks = [&](size_t i_thread)
+    {
+      for ( size_t i = i_thread; i < n_chunks; i += n_threads )
+      {
+        const size_t i_begin = i * chunk_size;
+        const size_t i_end   = MIN(i_begin + chunk_size, n_verts);
+
+        if ( !check_edge_table_chunk(table, offsets, i_begin, i_end) )
+        {
+          valid[i_thread] = 0;
+          return;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads {};
+
+    for ( size_t i = 1; i < n_threads; ++i )
+      threads.emplace_back( check_chunks, i );
+
+    check_chunks( 0 );
+
+    for ( std::thread& t : threads )
+      t.join();
+
+    for ( char v : valid )
+      if ( !v )
+        return false;
+
+    return true;
+
+  } // EntityChecks::check_mesh_edge_table()
+
+
 
   /*------------------------------------------------------------------
-  | Check a given advancing front structure
+  | Check a given advancing front structure. A valid front 
+  | - is closed, i.e. every front vertex has the same number of 
+  |   incoming and outgoing front edges
+  | - is oriented, such that the enclosed area is positive
+  | - does not intersect itself
   ------------------------------------------------------------------*/
   template <typename Front>
   static inline bool check_front_validity(Front& front)
   {
+    if ( front.size() < 1 )
+      return true;
 
+    double max_edge_length = 0.0;
+    double area = 0.0;
+
+    for ( const auto& e_ptr : front.edges() )
+    {
+      if (  !front_is_closed_at(front, e_ptr->v1()) 
+         || !front_is_closed_at(front, e_ptr->v2()) )
+      {
+        LOG(ERROR) << "Invalid front: Front is not closed at edge " 
+                   << e_ptr->xy() << ".";
+        return false;
+      }
+
+      max_edge_length = MAX(max_edge_length, e_ptr->length());
+      area += cross(e_ptr->v1().xy(), e_ptr->v2().xy());
+    }
+
+    if ( area <= 0.0 )
+    {
+      LOG(ERROR) << "Invalid front: Front encloses a non-positive area.";
+      return false;
+    }
+
+    for ( const auto& e_ptr : front.edges() )
+    {
+      if ( front_edge_intersects(front, *e_ptr, max_edge_length) )
+      {
+        LOG(ERROR) << "Invalid front: Self-intersection at edge " 
+                   << e_ptr->xy() << ".";
+        return false;
+      }
+    }
 
     return true;
 
   } // EntityChecks::check_front_validity()
 
+  /*------------------------------------------------------------------
+  | Check the local validity of an advancing front after it has been 
+  | updated with the facet "f_new". Only the following entities are 
+  | checked:
+  | - The front must be closed at all given "vertices"
+  | - The front edges "new_edges" must have the new facet located 
+  |   on their right side
+  | - The front edges "new_edges" must not intersect other front 
+  |   edges
+  | The argument "max_edge_length" must be an upper bound to the 
+  | length of all front edges, since it is used to define the 
+  | search range for the intersection checks.
+  ------------------------------------------------------------------*/
+  template <typename Front>
+  static inline bool 
+  check_front_update(const Front&               front,
+                     const Facet&               f_new,
+                     const std::vector<Edge*>&  new_edges,
+                     const std::vector<Vertex*>& vertices,
+                     double                     max_edge_length)
+  {
+    for ( const Vertex* v : vertices )
+      if ( !front_is_closed_at(front, *v) )
+        return false;
+
+    for ( const Edge* e : new_edges )
+    {
+      if ( is_left(e->v1().xy(), e->v2().xy(), f_new.xy()) )
+        return false;
+
+      if ( front_edge_intersects(front, *e, max_edge_length) )
+        return false;
+    }
+
+    return true;
+
+  } // EntityChecks::check_front_update()
+
 
 private:
+  /*------------------------------------------------------------------
+  | An entry of the flat boundary edge array, that is used in 
+  | check_domain_validity(). It stores the bounding box of the edge, 
+  | the index of its boundary and the array index of the subsequent 
+  | edge in the same boundary (or -1 if no such edge exists). 
+  ------------------------------------------------------------------*/
+  struct BoundaryEdgeEntry
+  {
+    const Edge* edge   { nullptr };
+    Vec2d       ll     { 0.0, 0.0 };
+    Vec2d       ur     { 0.0, 0.0 };
+    size_t      i_bdry { 0 };
+    int         i_next { -1 };
+  };
+
+  /*------------------------------------------------------------------
+  | Collect the edges of all domain boundaries in a single array and
+  | set up the connectivity to their subsequent edges
+  ------------------------------------------------------------------*/
+  template<typename Domain>
+  static inline std::vector<BoundaryEdgeEntry> 
+  gather_boundary_edges(const Domain& domain)
+  {
+    std::vector<BoundaryEdgeEntry> edges {};
+
+    size_t i_bdry = 0;
+
+    for ( const auto& boundary : domain )
+    {
+      const size_t i_first = edges.size();
+
+      // Outgoing boundary edge of every vertex of this boundary
+      std::unordered_map<const Vertex*, int> v_out {};
+
+      for ( const auto& e_ptr : boundary->edges() )
+      {
+        const Vec2d& xy_1 = e_ptr->v1().xy();
+        const Vec2d& xy_2 = e_ptr->v2().xy();
+
+        BoundaryEdgeEntry entry {};
+        entry.edge   = e_ptr.get();
+        entry.ll     = { MIN(xy_1.x, xy_2.x), MIN(xy_1.y, xy_2.y) };
+        entry.ur     = { MAX(xy_1.x, xy_2.x), MAX(xy_1.y, xy_2.y) };
+        entry.i_bdry = i_bdry;
+
+        v_out.insert( { &e_ptr->v1(), static_cast<int>(edges.size()) } );
+        edges.push_back( entry );
+      }
+
+      for ( size_t i = i_first; i < edges.size(); ++i )
+      {
+        auto next = v_out.find( &edges[i].edge->v2() );
+        if ( next != v_out.end() )
+          edges[i].i_next = next->second;
+      }
+
+      ++i_bdry;
+    }
+
+    return edges;
+
+  } // EntityChecks::gather_boundary_edges()
+
+  /*------------------------------------------------------------------
+  | Check if every boundary can be traversed from its first edge 
+  | back to this edge, using the precomputed edge connectivity
+  ------------------------------------------------------------------*/
+  static inline bool 
+  boundaries_are_traversable(const std::vector<BoundaryEdgeEntry>& edges)
+  {
+    size_t i_first = 0;
+
+    while ( i_first < edges.size() )
+    {
+      // Number of edges in the current boundary
+      size_t n_edges = 0;
+      while (  i_first + n_edges < edges.size() 
+            && edges[i_first+n_edges].i_bdry == edges[i_first].i_bdry )
+        ++n_edges;
+
+      int i_cur = static_cast<int>(i_first);
+      size_t edge_count = 0;
+
+      do
+      {
+        i_cur = edges[i_cur].i_next;
+        ++edge_count;
+
+      } while (  ( i_cur >= 0 )
+              && ( edge_count < n_edges )
+              && ( i_cur != static_cast<int>(i_first) ) );
+
+      if ( i_cur != static_cast<int>(i_first) )
+        return false;
+
+      i_first += n_edges;
+    }
+
+    return true;
+
+  } // EntityChecks::boundaries_are_traversable()
+
+  /*------------------------------------------------------------------
+  | Find all pairs of intersecting edges in a given boundary edge 
+  | array. The edges are sorted by the lower x-coordinate of their 
+  | bounding boxes and swept from left to right, such that only 
+  | edges with overlapping x-extents are compared. 
+  | The returned pairs refer to indices of the given array.
+  ------------------------------------------------------------------*/
+  static inline std::vector<std::pair<size_t,size_t>>
+  sweep_boundary_intersections(const std::vector<BoundaryEdgeEntry>& edges)
+  {
+    std::vector<size_t> order( edges.size() );
+    for ( size_t i = 0; i < order.size(); ++i )
+      order[i] = i;
+
+    std::sort(order.begin(), order.end(), 
+    [&edges](size_t a, size_t b) 
+    { return edges[a].ll.x < edges[b].ll.x; });
+
+    std::vector<std::pair<size_t,size_t>> intersections {};
+
+    for ( size_t i = 0; i < order.size(); ++i )
+    {
+      const BoundaryEdgeEntry& a = edges[order[i]];
+
+      for ( size_t j = i+1; j < order.size(); ++j )
+      {
+        const BoundaryEdgeEntry& b = edges[order[j]];
+
+        // No further edges overlap in x-direction
+        if ( b.ll.x > a.ur.x )
+          break;
+
+        if ( b.ll.y > a.ur.y || b.ur.y < a.ll.y )
+          continue;
+
+        if ( line_line_intersection(a.edge->v1().xy(), a.edge->v2().xy(),
+                                    b.edge->v1().xy(), b.edge->v2().xy()) )
+          intersections.push_back( { MIN(order[i], order[j]), 
+                                     MAX(order[i], order[j]) } );
+      }
+    }
+
+    return intersections;
+
+  } // EntityChecks::sweep_boundary_intersections()
+
+  /*------------------------------------------------------------------
+  | An entry of the flat half-edge table, that is used in 
+  | check_mesh_edge_table(). Entries are stored in the bucket of the 
+  | smaller vertex index, "forward" denotes that the edge is 
+  | directed from the smaller to the larger vertex index. 
+  ------------------------------------------------------------------*/
+  struct EdgeTableEntry
+  {
+    enum class Owner { Facet, InteriorEdge, BoundaryEdge };
+
+    unsigned int v_max   { 0 };
+    bool         forward { true };
+    Owner        owner   { Owner::Facet };
+  };
+
+  /*------------------------------------------------------------------
+  | Check that all vertices of the given facets are part of the 
+  | mesh and that they list the respective facet
+  ------------------------------------------------------------------*/
+  template <typename Facets, typename IndexMap>
+  static inline bool check_vertex_facets(const Facets& facets,
+                                         const IndexMap& indices)
+  {
+    for ( const auto& f_ptr : facets )
+    {
+      for ( size_t i = 0; i < f_ptr->n_vertices(); ++i )
+      {
+        const Vertex& v = f_ptr->vertex(i);
+
+        if ( indices.count( &v ) == 0 )
+          return false;
+
+        const auto& v_facets = v.facets();
+
+        if ( std::find( v_facets.begin(), v_facets.end(), f_ptr.get() ) 
+             == v_facets.end() )
+          return false;
+      }
+    }
+
+    return true;
+
+  } // EntityChecks::check_vertex_facets()
+
+  /*------------------------------------------------------------------
+  | Validate all buckets [i_begin, i_end) of a given half-edge table
+  ------------------------------------------------------------------*/
+  static inline bool 
+  check_edge_table_chunk(std::vector<EdgeTableEntry>& table,
+                         const std::vector<size_t>& offsets,
+                         size_t i_begin, size_t i_end)
+  {
+    using Owner = EdgeTableEntry::Owner;
+
+    for ( size_t i = i_begin; i < i_end; ++i )
+    {
+      auto bucket_begin = table.begin() + offsets[i];
+      auto bucket_end   = table.begin() + offsets[i+1];
+
+      std::sort(bucket_begin, bucket_end, 
+      [](const EdgeTableEntry& a, const EdgeTableEntry& b)
+      { return a.v_max < b.v_max; });
+
+      auto group = bucket_begin;
+
+      while ( group != bucket_end )
+      {
+        int n_facets   = 0;
+        int n_forward  = 0;
+        int n_intr     = 0;
+        int n_bdry     = 0;
+        bool bdry_forward = true;
+
+        auto it = group;
+
+        for ( ; it != bucket_end && it->v_max == group->v_max; ++it )
+        {
+          if ( it->owner == Owner::Facet )
+          {
+            ++n_facets;
+            n_forward += it->forward ? 1 : 0;
+          }
+          else if ( it->owner == Owner::InteriorEdge )
+          {
+            ++n_intr;
+          }
+          else
+          {
+            ++n_bdry;
+            bdry_forward = it->forward;
+          }
+        }
+
+        group = it;
+
+        // Facet side without a corresponding mesh edge or 
+        // duplicate mesh edges
+        if ( n_intr + n_bdry != 1 )
+          return false;
+
+        // Mesh edge without adjacent facets or non-manifold edge
+        if ( n_facets < 1 || n_facets > 2 )
+          return false;
+
+        // Adjacent facets with inconsistent orientation
+        if ( n_facets == 2 && n_forward != 1 )
+          return false;
+
+        // Boundary edges must be adjacent to a single facet,
+        // that is located on its left side
+        if ( n_bdry > 0 )
+        {
+          if ( n_facets != 1 )
+            return false;
+
+          if ( (n_forward == 1) != bdry_forward )
+            return false;
+        }
+      }
+    }
+
+    return true;
+
+  } // EntityChecks::check_edge_table_chunk()
+
+  /*------------------------------------------------------------------
+  | Check if the number of incoming front edges equals the number
+  | of outgoing front edges at a given vertex 
+  ------------------------------------------------------------------*/
+  template <typename Front>
+  static inline bool front_is_closed_at(const Front& front, 
+                                        const Vertex& v)
+  {
+    int n_in  = 0;
+    int n_out = 0;
+
+    for ( const Edge* e : v.edges() )
+    {
+      if ( &e->edgelist() != &front )
+        continue;
+
+      if ( &e->v1() == &v )
+        ++n_out;
+      else
+        ++n_in;
+    }
+
+    return ( n_in == n_out );
+
+  } // EntityChecks::front_is_closed_at()
+
+  /*------------------------------------------------------------------
+  | Check if a front edge intersects any other front edge. 
+  | Edges that share a vertex with the given edge are skipped.
+  | Since the front edges are stored by their centroids, two edges
+  | can only intersect if their centroids are closer than the 
+  | mean of their lengths.
+  ------------------------------------------------------------------*/
+  template <typename Front>
+  static inline bool front_edge_intersects(const Front& front,
+                                           const Edge&  e,
+                                           double       max_edge_length)
+  {
+    const Vertex& v1 = e.v1();
+    const Vertex& v2 = e.v2();
+
+    const double range = 0.5 * (e.length() + max_edge_length) + TQ_SMALL;
+
+    for ( const Edge* e_found : front.edges().get_items(e.xy(), range) )
+    {
+      if ( e_found == &e )
+        continue;
+
+      const Vertex& w1 = e_found->v1();
+      const Vertex& w2 = e_found->v2();
+
+      if ( &w1 == &v1 || &w1 == &v2 || &w2 == &v1 || &w2 == &v2 )
+        continue;
+
+      if ( line_line_intersection(v1.xy(), v2.xy(), w1.xy(), w2.xy()) )
+        return true;
+    }
+
+    return false;
+
+  } // EntityChecks::front_edge_intersects()
+
   /*------------------------------------------------------------------
   | We hide the constructor, since this class acts only as container
   | for static inline functions
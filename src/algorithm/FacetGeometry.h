@@ -7,9 +7,12 @@
 */
 #pragma once
 
+#include <array>
+
 #include "VecND.h"
 #include "Geometry.h"
 
+#include "utils.h"
 #include "Vertex.h"
 
 namespace TQMesh {
@@ -17,6 +20,85 @@ namespace TQAlgorithm {
 
 using namespace CppUtils;
 
+/*********************************************************************
+* Utility class for the bounding box based pre-selection of the
+* advancing front edges, that are located in the vicinity of a
+* triangle or a quad
+*********************************************************************/
+class FrontProximity
+{
+public:
+
+  /*------------------------------------------------------------------
+  | Compute the bounding box of a facet, enlarged by <margin>
+  ------------------------------------------------------------------*/
+  template <typename F>
+  static inline void calc_bbox(const F& facet, const double margin,
+                               Vec2d& ll, Vec2d& ur)
+  {
+    ll = facet.vertex(0).xy();
+    ur = facet.vertex(0).xy();
+
+    for ( std::size_t i = 1; i < facet.n_vertices(); ++i )
+    {
+      const Vec2d& p = facet.vertex(i).xy();
+      ll = { MIN(ll.x, p.x), MIN(ll.y, p.y) };
+      ur = { MAX(ur.x, p.x), MAX(ur.y, p.y) };
+    }
+
+    ll = { ll.x - margin, ll.y - margin };
+    ur = { ur.x + margin, ur.y + margin };
+  }
+
+  /*------------------------------------------------------------------
+  | Check if the bounding box of an edge (e1,e2) overlaps with 
+  | a given box (ll,ur)
+  ------------------------------------------------------------------*/
+  static inline bool edge_bbox_overlap(const Vec2d& e1, const Vec2d& e2,
+                                       const Vec2d& ll, const Vec2d& ur)
+  {
+    return !(  MAX(e1.x, e2.x) < ll.x || MIN(e1.x, e2.x) > ur.x
+            || MAX(e1.y, e2.y) < ll.y || MIN(e1.y, e2.y) > ur.y );
+  }
+
+  /*------------------------------------------------------------------
+  | Front edges are stored by their centroids. An edge can only be 
+  | located within a distance <margin> to a facet, if its centroid 
+  | is closer to the facet centroid than the largest centroid-vertex 
+  | distance plus half the edge length plus <margin>. 
+  | The front only provides a monotone upper bound for its edge 
+  | lengths, hence the range is never tighter than required.
+  | The returned search range is never larger than the given <range>.
+  ------------------------------------------------------------------*/
+  template <typename F, typename Front>
+  static inline double calc_search_range(const F& facet, 
+                                         const Front& front,
+                                         const double margin,
+                                         const double range)
+  {
+    const Vec2d& c = facet.xy();
+
+    double r_sqr = 0.0;
+
+    for ( std::size_t i = 0; i < facet.n_vertices(); ++i )
+      r_sqr = MAX( r_sqr, (facet.vertex(i).xy() - c).norm_sqr() );
+
+    const double r_front 
+      = sqrt( r_sqr ) + 0.5 * front.max_edge_length() + margin + TQ_SMALL;
+
+    return MIN(r_front, range);
+  }
+
+private:
+  /*------------------------------------------------------------------
+  | We hide the constructor, since this class acts only as container
+  | for static inline functions
+  ------------------------------------------------------------------*/
+  FrontProximity() = default;
+  ~FrontProximity() {};
+
+}; // FrontProximity
+
 /*********************************************************************
 * Utility class for the calculation of triangle-related geometry
 *********************************************************************/
@@ -285,6 +367,9 @@ public:
   /*------------------------------------------------------------------
   | Check intersection between a triangle <tri> and edges of a 
   | given advancing front structure that are located within <range> 
+  | The search range is bounded by the triangle extent and the 
+  | longest front edge, and the found edges are pre-filtered by 
+  | their bounding boxes
   ------------------------------------------------------------------*/
   template <typename T, typename F>
   static inline bool check_intersection(const T& tri, const F& front,
@@ -294,11 +379,20 @@ public:
     const Vec2d& t2 = tri.v2().xy();
     const Vec2d& t3 = tri.v3().xy();
 
-    for (const auto& e : front.edges().get_items(tri.xy(), range))
+    Vec2d t_ll, t_ur;
+    FrontProximity::calc_bbox(tri, 0.0, t_ll, t_ur);
+
+    const double r 
+      = FrontProximity::calc_search_range(tri, front, 0.0, range);
+
+    for (const auto& e : front.edges().get_items(tri.xy(), r))
     {
       const Vec2d& e1 = e->v1().xy();
       const Vec2d& e2 = e->v2().xy();
 
+      if ( !FrontProximity::edge_bbox_overlap(e1, e2, t_ll, t_ur) )
+        continue;
+
       if ( line_tri_intersection( e1,e2, t1,t2,t3 ) )
         return true;
     }
@@ -608,20 +702,32 @@ public:
   /*------------------------------------------------------------------
   | Check intersection between a <quad> and edges of a 
   | given advancing front structure that are located within <range> 
+  | The search range is bounded by the quad extent and the longest 
+  | front edge, and the found edges are pre-filtered by their 
+  | bounding boxes
   ------------------------------------------------------------------*/
   template <typename Q, typename F>
   static inline bool check_intersection(const Q& quad, const F& front,
                                         const double range)
   {
-    for (const auto& e : front.edges().get_items(quad.xy(), range))
+    const Vec2d& q1 = quad.v1().xy();
+    const Vec2d& q2 = quad.v2().xy();
+    const Vec2d& q3 = quad.v3().xy();
+    const Vec2d& q4 = quad.v4().xy();
+
+    Vec2d q_ll, q_ur;
+    FrontProximity::calc_bbox(quad, 0.0, q_ll, q_ur);
+
+    const double r 
+      = FrontProximity::calc_search_range(quad, front, 0.0, range);
+
+    for (const auto& e : front.edges().get_items(quad.xy(), r))
     {
       const Vec2d& e1 = e->v1().xy();
       const Vec2d& e2 = e->v2().xy();
 
-      const Vec2d& q1 = quad.v1().xy();
-      const Vec2d& q2 = quad.v2().xy();
-      const Vec2d& q3 = quad.v3().xy();
-      const Vec2d& q4 = quad.v4().xy();
+      if ( !FrontProximity::edge_bbox_overlap(e1, e2, q_ll, q_ur) )
+        continue;
 
       if ( line_quad_intersection( e1,e2, q1,q2,q3,q4 ) )
         return true;
@@ -662,13 +768,28 @@ public:
   /*------------------------------------------------------------------
   | Check if a given quad is located too close to advancing
   | front edges that are located within <range> 
+  | The search range is bounded by the quad extent, the longest 
+  | front edge and the minimum distance. Found edges are pre-filtered 
+  | by their bounding boxes, before the distances of their vertices 
+  | to all four quad edges are evaluated at once.
   ------------------------------------------------------------------*/
   template <typename Q, typename F>
   static inline bool is_too_close(const Q& quad, const F& front,
                                   const double range,
                                   const double min_dist_sqr)
   {
-    for (const auto& e : front.edges().get_items(quad.xy(), range))
+    const double min_dist = sqrt( min_dist_sqr );
+
+    Vec2d q_ll, q_ur;
+    FrontProximity::calc_bbox(quad, min_dist, q_ll, q_ur);
+
+    const double r 
+      = FrontProximity::calc_search_range(quad, front, min_dist, range);
+
+    const std::array<Vec2d,4> q_xy { quad.v1().xy(), quad.v2().xy(),
+                                     quad.v3().xy(), quad.v4().xy() };
+
+    for (const auto& e : front.edges().get_items(quad.xy(), r))
     {
       const Vertex& v1  = e->v1();
       const Vertex& v2  = e->v2();
@@ -681,30 +802,55 @@ public:
            v2 == quad.v3() || v2 == quad.v4() )
         continue;
 
-      const Vec2d& v1_xy = v1.xy();
-      const Vec2d& v2_xy = v2.xy();
-
-      const Vec2d& q1 = quad.v1().xy();
-      const Vec2d& q2 = quad.v2().xy();
-      const Vec2d& q3 = quad.v3().xy();
-      const Vec2d& q4 = quad.v4().xy();
+      if ( !FrontProximity::edge_bbox_overlap(v1.xy(), v2.xy(), q_ll, q_ur) )
+        continue;
 
-      if (distance_point_edge_sqr(v1_xy, q1,q2) < min_dist_sqr ||
-          distance_point_edge_sqr(v1_xy, q2,q3) < min_dist_sqr ||
-          distance_point_edge_sqr(v1_xy, q3,q4) < min_dist_sqr ||
-          distance_point_edge_sqr(v1_xy, q4,q1) < min_dist_sqr  )
+      if ( calc_edge_distance_sqr(v1.xy(), q_xy) < min_dist_sqr )
         return true;
 
-      if (distance_point_edge_sqr(v2_xy, q1,q2) < min_dist_sqr ||
-          distance_point_edge_sqr(v2_xy, q2,q3) < min_dist_sqr ||
-          distance_point_edge_sqr(v2_xy, q3,q4) < min_dist_sqr ||
-          distance_point_edge_sqr(v2_xy, q4,q1) < min_dist_sqr  )
+      if ( calc_edge_distance_sqr(v2.xy(), q_xy) < min_dist_sqr )
         return true;
     }
 
     return false;
   }
 
+  /*------------------------------------------------------------------
+  | Compute the minimum squared distance between a point <p> and 
+  | the four edges of a quad, that is defined by its vertex 
+  | coordinates <q>. All four point-segment distances are 
+  | evaluated on plain arrays, such that the loops can be 
+  | vectorized by the compiler.
+  ------------------------------------------------------------------*/
+  static inline double 
+  calc_edge_distance_sqr(const Vec2d& p, const std::array<Vec2d,4>& q)
+  {
+    double ax[4], ay[4], dx[4], dy[4], d_sqr[4];
+
+    for ( int i = 0; i < 4; ++i )
+    {
+      ax[i] = q[i].x;
+      ay[i] = q[i].y;
+      dx[i] = q[(i+1)%4].x - q[i].x;
+      dy[i] = q[(i+1)%4].y - q[i].y;
+    }
+
+    for ( int i = 0; i < 4; ++i )
+    {
+      const double px = p.x - ax[i];
+      const double py = p.y - ay[i];
+      const double l_sqr = dx[i] * dx[i] + dy[i] * dy[i];
+      const double t = (l_sqr > 0.0) 
+                     ? (px * dx[i] + py * dy[i]) / l_sqr : 0.0;
+      const double t_clip = MIN(MAX(t, 0.0), 1.0);
+      const double ex = px - t_clip * dx[i];
+      const double ey = py - t_clip * dy[i];
+      d_sqr[i] = ex * ex + ey * ey;
+    }
+
+    return MIN( MIN(d_sqr[0], d_sqr[1]), MIN(d_sqr[2], d_sqr[3]) );
+  }
+
 private:
   /*------------------------------------------------------------------
   | We hide the constructor, since this class acts only as container
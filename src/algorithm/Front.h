@@ -13,6 +13,12 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <cstdint>
+#include <cfloat>
+#include <unordered_map>
 
 #include "VecND.h"
 #include "Geometry.h"
@@ -174,7 +180,9 @@ private:
       {
         double delta_1 = (e1->xy() - v).norm_sqr();
         double delta_2 = (e2->xy() - v).norm_sqr();
-        return (delta_1 < delta_2);
+        if ( delta_1 != delta_2 )
+          return (delta_1 < delta_2);
+        return ( e1->creation_index() < e2->creation_index() );
       });
 
       // If edges have been located, terminate the search
@@ -200,6 +208,20 @@ private:
 }; // FrontInitData
 
 
+/*********************************************************************
+* The order in which the advancing front edges are processed:
+* > Length:   Edges are sorted by their length
+* > Coherent: Edges are grouped into length classes, which differ by
+*             a factor of 2^(1/4). Within each class, edges are 
+*             sorted along the connected chains of the front, such 
+*             that consecutive base edges are located next to 
+*             each other.
+*********************************************************************/
+enum class FrontOrder : uint8_t {
+  Length   = 0,
+  Coherent = 1,
+};
+
 /*********************************************************************
 * The advancing front - defined by a list of edges
 * > Must be defined counter-clockwise
@@ -231,11 +253,13 @@ public:
   ------------------------------------------------------------------*/
   Edge& base() { return *base_; }
   const Edge& base() const { return *base_; }
+  FrontOrder order() const { return order_; }
 
   /*------------------------------------------------------------------
   | Setters
   ------------------------------------------------------------------*/
   void base(Edge& b) { base_ = &b; }
+  void order(FrontOrder o) { order_ = o; }
 
   /*------------------------------------------------------------------
   | Initialize the advancing front structure according to a given 
@@ -317,23 +341,35 @@ public:
 
   /*------------------------------------------------------------------
   | Sort all edges by length in ascending order
-  | and lets the base segment point to the first edge
+  | and lets the base segment point to the first edge.
+  | Edges of equal length are ordered by their creation index.
+  | For a coherent front order, only the length classes are sorted.
   ------------------------------------------------------------------*/
   void sort_edges(bool ascending = true)
   {
+    if ( order_ == FrontOrder::Coherent )
+    {
+      sort_edges_coherent( ascending );
+      return;
+    }
+
     // Sort by edge lengths in ascending order
     if ( ascending )
       edges_.sort(
       []( std::unique_ptr<Edge>& a, std::unique_ptr<Edge>& b )
       {
-        return a->length() < b->length();
+        if ( a->length() != b->length() )
+          return a->length() < b->length();
+        return a->creation_index() < b->creation_index();
       });
     // Sort by edge lengths in descending order
     else
       edges_.sort(
       []( std::unique_ptr<Edge>& a, std::unique_ptr<Edge>& b )
       {
-        return a->length() > b->length();
+        if ( a->length() != b->length() )
+          return a->length() > b->length();
+        return a->creation_index() < b->creation_index();
       });
 
     // Reset base segment
@@ -344,7 +380,8 @@ public:
 
   /*------------------------------------------------------------------
   | Sort all edges by distance to a given point in ascending order
-  | and lets the base segment point to the first edge
+  | and lets the base segment point to the first edge.
+  | Edges of equal distance are ordered by their creation index.
   ------------------------------------------------------------------*/
   void sort_edges(const Vec2d& xy, bool ascending = true)
   {
@@ -355,7 +392,9 @@ public:
       {
         const double d_a = (xy - a->v1().xy()).norm_sqr();
         const double d_b = (xy - b->v1().xy()).norm_sqr();
-        return d_a < d_b;
+        if ( d_a != d_b )
+          return d_a < d_b;
+        return a->creation_index() < b->creation_index();
       });
     // Sort by edge lengths in descending order
     else
@@ -364,7 +403,9 @@ public:
       {
         const double d_a = (xy - a->v1().xy()).norm_sqr();
         const double d_b = (xy - b->v1().xy()).norm_sqr();
-        return d_a > d_b;
+        if ( d_a != d_b )
+          return d_a > d_b;
+        return a->creation_index() < b->creation_index();
       });
 
     // Reset base segment
@@ -374,6 +415,62 @@ public:
 
 private:
 
+  /*------------------------------------------------------------------
+  | Sort all edges by their length class and - within each class - 
+  | along the connected chains of front edges
+  ------------------------------------------------------------------*/
+  void sort_edges_coherent(bool ascending)
+  {
+    if ( edges_.size() < 1 )
+      return;
+
+    std::unordered_map<const Edge*, int> length_class {};
+    length_class.reserve( edges_.size() );
+
+    for ( const auto& e_ptr : edges_ )
+    {
+      const double l = MAX( e_ptr->length(), DBL_MIN );
+      const int c = static_cast<int>( std::floor( LENGTH_CLASSES_PER_OCTAVE 
+                                                * std::log2( l ) ) );
+      length_class[e_ptr.get()] = ascending ? c : -c;
+    }
+
+    edges_.sort(
+    [&length_class]( std::unique_ptr<Edge>& a, std::unique_ptr<Edge>& b )
+    {
+      const int c_a = length_class[a.get()];
+      const int c_b = length_class[b.get()];
+      if ( c_a != c_b )
+        return c_a < c_b;
+      return a->creation_index() < b->creation_index();
+    });
+
+    // Traverse the chains of connected edges within each class
+    std::unordered_map<const Edge*, std::size_t> rank {};
+    rank.reserve( edges_.size() );
+
+    for ( const auto& e_ptr : edges_ )
+    {
+      const Edge* e = e_ptr.get();
+      const int c = length_class[e];
+
+      while ( e && rank.count(e) == 0 && length_class[e] == c )
+      {
+        const std::size_t r = rank.size();
+        rank[e] = r;
+        e = e->get_next_edge();
+      }
+    }
+
+    edges_.sort(
+    [&rank]( std::unique_ptr<Edge>& a, std::unique_ptr<Edge>& b )
+    { return rank[a.get()] < rank[b.get()]; });
+
+    // Reset base segment
+    set_base_first();
+
+  } // Front::sort_edges_coherent()
+
   /*------------------------------------------------------------------
   | Refine specific advancing front edges such that their length is 
   | in accordance to the underlying size function.
@@ -381,6 +478,9 @@ private:
   ------------------------------------------------------------------*/
   int refine_front_edges(const Domain& domain, Vertices& mesh_vertices)
   {
+    SizeFunctionPhaseScope phase { domain.size_function_profiler(), 
+                                   SizeFunctionPhase::FrontRefinement };
+
     int n_before = edges_.size();
 
     // Obtain the edges that should be refined
@@ -511,9 +611,14 @@ private:
                    Edge& edge)
   {
     // Create coordinates of new vertices along the 
-    // current edge segment
-    std::vector<Vec2d> xy_new 
-      = create_sub_vertex_coords(edge, domain);
+    // current edge segment - periodic target edges obtain the 
+    // vertices of their source edge
+    const PeriodicPair* periodic = domain.periodic_target( edge.marker() );
+
+    std::vector<Vec2d> xy_new = ( periodic ) 
+      ? create_periodic_sub_vertex_coords(edge, *periodic, domain)
+      : create_sub_vertex_coords(edge, domain, 
+                                 domain.edge_discretization());
 
     // No new vertices have been added 
     // --> continue with next boundary segment
@@ -527,6 +632,74 @@ private:
 
   } // refine_edge()
 
+  /*------------------------------------------------------------------
+  | Create a vector of new vertex coordinates along a front edge
+  | for the given edge discretization method
+  ------------------------------------------------------------------*/
+  std::vector<Vec2d> create_sub_vertex_coords(const Edge&        e,
+                                              const Domain&      domain,
+                                              EdgeDiscretization method)
+  {
+    if ( method == EdgeDiscretization::Quadrature )
+      return create_sub_vertex_coords_quadrature(e, domain);
+
+    return create_sub_vertex_coords(e, domain);
+
+  } // create_sub_vertex_coords()
+
+  /*------------------------------------------------------------------
+  | Create the vertex coordinates along a periodic target edge.
+  | The source edge is located among the front edges, such that it
+  | is mapped onto the target edge in reversed direction. Its vertex
+  | coordinates are mapped and reversed. If no source edge is found,
+  | the target edge is discretized on its own.
+  | Candidate source edges are queried from the front's quadtree 
+  | around the inversely mapped center of the target edge.
+  ------------------------------------------------------------------*/
+  std::vector<Vec2d> 
+  create_periodic_sub_vertex_coords(const Edge&         e,
+                                    const PeriodicPair& periodic,
+                                    const Domain&       domain)
+  {
+    const MeshTransformation& trafo = periodic.transformation;
+    const double tol = periodic_tolerance_ * e.length();
+
+    const Vec2d xy_src = trafo.inverse()( e.xy() );
+
+    for ( Edge* e_src : edges_.get_items(xy_src, tol) )
+    {
+      if ( e_src->marker() != periodic.source_marker )
+        continue;
+
+      if (  ( trafo( e_src->v1().xy() ) - e.v2().xy() ).norm() > tol
+         || ( trafo( e_src->v2().xy() ) - e.v1().xy() ).norm() > tol )
+        continue;
+
+      std::vector<Vec2d> xy_src 
+        = create_sub_vertex_coords(*e_src, domain, 
+                                   domain.edge_discretization());
+
+      std::vector<Vec2d> xy_new ( xy_src.size() );
+
+      for ( std::size_t i = 0; i < xy_src.size(); ++i )
+        xy_new[xy_src.size()-1-i] = trafo( xy_src[i] );
+
+      // Keep the exact end points of the target edge
+      xy_new.front() = e.v1().xy();
+      xy_new.back()  = e.v2().xy();
+
+      return xy_new;
+    }
+
+    LOG(WARNING) << "Front::create_periodic_sub_vertex_coords(): "
+                 << "No periodic source edge found for edge " 
+                 << e.v1().xy() << " -> " << e.v2().xy() << ".";
+
+    return create_sub_vertex_coords(e, domain, 
+                                    domain.edge_discretization());
+
+  } // create_periodic_sub_vertex_coords()
+
   /*------------------------------------------------------------------
   | Create a vector of new vertex coordinates along a front edge. 
   | The vertices are distributed according to the underlying domain 
@@ -639,6 +812,150 @@ private:
 
   } // create_sub_vertex_coords()
 
+  /*------------------------------------------------------------------
+  | Create a vector of new vertex coordinates along a front edge, 
+  | based on the integral N(s) = int_0^s 1/rho(x(s')) ds', which 
+  | counts the number of sub-edges along the edge.
+  | The integral is computed with adaptive Gauss-Kronrod quadrature, 
+  | such that the number of size function evaluations depends on 
+  | the variation of the size function, but not on the number of 
+  | new vertices. The vertices are then located at equal increments 
+  | of the integral. The first coordinates in the returning vector 
+  | correspond to vertex v1 and the last coordinates to vertex v2.
+  ------------------------------------------------------------------*/
+  std::vector<Vec2d> create_sub_vertex_coords_quadrature(
+                                              const Edge& e, 
+                                              const Domain& domain)
+  {
+    const Vec2d& xy_1 = e.v1().xy();
+    const Vec2d& xy_2 = e.v2().xy();
+    const Vec2d  tang = e.tangent();
+    const double len  = e.length();
+
+    auto f = [&](double s) 
+    { return 1.0 / domain.size_function( xy_1 + s * tang ); };
+
+    // Breakpoints (s, N(s)) of the piecewise linear integral
+    std::vector<std::pair<double,double>> N_s { {0.0, 0.0} };
+
+    integrate_adaptive(f, 0.0, len, quadrature_tolerance_, 0, N_s);
+
+    // Number of new edges - rounding equals the predictor-corrector
+    // march, which removes its last step if it overshoots by more
+    // than half of the local size
+    const double N_tot = N_s.back().second;
+    const size_t n_edges 
+      = MAX( size_t{1}, static_cast<size_t>( std::round(N_tot) ) );
+
+    std::vector<Vec2d> xy_new { xy_1 };
+
+    // Invert the integral for every new vertex
+    size_t j = 1;
+
+    for ( size_t i = 1; i < n_edges; ++i )
+    {
+      const double N_i = N_tot * static_cast<double>(i) 
+                               / static_cast<double>(n_edges);
+
+      while ( N_s[j].second < N_i && j < N_s.size()-1 )
+        ++j;
+
+      const auto& lo = N_s[j-1];
+      const auto& hi = N_s[j];
+
+      const double dN = hi.second - lo.second;
+      const double t  = ( dN > 0.0 ) ? (N_i - lo.second) / dN : 0.0;
+      const double s  = lo.first + t * ( hi.first - lo.first );
+
+      xy_new.push_back( xy_1 + s * tang );
+    }
+
+    xy_new.push_back( xy_2 );
+
+    return xy_new;
+
+  } // create_sub_vertex_coords_quadrature()
+
+  /*------------------------------------------------------------------
+  | Integrate a function <f> on the interval [a,b] with adaptive 
+  | 7-15 point Gauss-Kronrod quadrature. Intervals are bisected 
+  | until the difference of both rules is below <tol>.
+  | Every accepted interval is split into the cells of its 
+  | quadrature weights, where each cell holds the contribution 
+  | of its node. The cumulative integral at the cell boundaries is 
+  | appended to <N_s>, which leads to a piecewise linear 
+  | representation of the integral without further evaluations.
+  ------------------------------------------------------------------*/
+  template <typename F>
+  void integrate_adaptive(const F& f, double a, double b, double tol,
+                          unsigned int depth,
+                          std::vector<std::pair<double,double>>& N_s) const
+  {
+    // Kronrod nodes in ascending order and their weights. 
+    // Gauss weights are given for every second node.
+    static constexpr std::array<double,15> x_k { 
+      -0.991455371120812639, -0.949107912342758525,
+      -0.864864423359769073, -0.741531185599394440,
+      -0.586087235467691130, -0.405845151377397167,
+      -0.207784955007898468,  0.0,
+       0.207784955007898468,  0.405845151377397167,
+       0.586087235467691130,  0.741531185599394440,
+       0.864864423359769073,  0.949107912342758525,
+       0.991455371120812639 };
+
+    static constexpr std::array<double,15> w_k {
+      0.022935322010529225, 0.063092092629978553,
+      0.104790010322250184, 0.140653259715525919,
+      0.169004726639267903, 0.190350578064785410,
+      0.204432940075298892, 0.209482141084727828,
+      0.204432940075298892, 0.190350578064785410,
+      0.169004726639267903, 0.140653259715525919,
+      0.104790010322250184, 0.063092092629978553,
+      0.022935322010529225 };
+
+    static constexpr std::array<double,15> w_g {
+      0.0, 0.129484966168869693, 0.0, 0.279705391489276668, 
+      0.0, 0.381830050505118945, 0.0, 0.417959183673469388, 
+      0.0, 0.381830050505118945, 0.0, 0.279705391489276668, 
+      0.0, 0.129484966168869693, 0.0 };
+
+    const double c = 0.5 * (a + b);
+    const double h = 0.5 * (b - a);
+
+    std::array<double,15> f_k {};
+    double I_k = 0.0;
+    double I_g = 0.0;
+
+    for ( size_t i = 0; i < 15; ++i )
+    {
+      f_k[i] = f( c + h * x_k[i] );
+      I_k += h * w_k[i] * f_k[i];
+      I_g += h * w_g[i] * f_k[i];
+    }
+
+    if ( ABS(I_k - I_g) > tol && depth < max_quadrature_depth_ )
+    {
+      integrate_adaptive(f, a, c, 0.5*tol, depth+1, N_s);
+      integrate_adaptive(f, c, b, 0.5*tol, depth+1, N_s);
+      return;
+    }
+
+    double s = a;
+    double N = N_s.back().second;
+
+    for ( size_t i = 0; i < 14; ++i )
+    {
+      s += h * w_k[i];
+      N += h * w_k[i] * f_k[i];
+      N_s.push_back( {s, N} );
+    }
+
+    // Close the interval exactly at its end point
+    N += h * w_k[14] * f_k[14];
+    N_s.push_back( {b, N} );
+
+  } // integrate_adaptive()
+
 
   /*------------------------------------------------------------------
   | Divide a given edge segment into several sub-segements,
@@ -673,7 +990,14 @@ private:
   /*------------------------------------------------------------------
   | Attributes 
   ------------------------------------------------------------------*/
-  Edge*   base_ = nullptr;
+  static constexpr double LENGTH_CLASSES_PER_OCTAVE = 4.0;
+
+  Edge*        base_ = nullptr;
+  FrontOrder   order_ = FrontOrder::Length;
+
+  double       quadrature_tolerance_ { 1.0E-3 };
+  unsigned int max_quadrature_depth_ { 12 };
+  double       periodic_tolerance_   { 1.0E-8 };
 
 }; // Front
 
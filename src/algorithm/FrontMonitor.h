@@ -0,0 +1,287 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <cmath>
+#include <cfloat>
+#include <ostream>
+#include <cstdint>
+
+#include "VecND.h"
+
+#include "utils.h"
+#include "Edge.h"
+#include "Front.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* The reaction of a meshing strategy on an unhealthy advancing front
+*********************************************************************/
+enum class FrontHealthReaction : uint8_t {
+  None    = 0,
+  Abort   = 1,
+  Retreat = 2,
+};
+
+/*********************************************************************
+* A snapshot of the state of an advancing front
+*********************************************************************/
+struct FrontHealth
+{
+  std::size_t n_front_edges        { 0 };
+  double      front_length         { 0.0 };
+  double      remaining_area       { 0.0 };
+  double      min_front_angle      { 0.0 };
+  Vec2d       min_front_angle_xy   { 0.0, 0.0 };
+  double      min_front_angle_len  { 0.0 };
+  std::size_t n_failed_base_edges  { 0 };
+  std::size_t n_consecutive_fails  { 0 };
+  std::size_t n_wide_searches      { 0 };
+  std::size_t n_generated          { 0 };
+
+  /*------------------------------------------------------------------
+  | The ratio of the squared front length and the remaining area,
+  | normalized such that a circular front yields one. Fronts with
+  | large ratios enclose narrow gaps, which are hard to fill.
+  ------------------------------------------------------------------*/
+  double front_ratio() const
+  {
+    if ( remaining_area <= 0.0 )
+      return ( front_length > 0.0 ) ? DBL_MAX : 0.0;
+
+    return front_length * front_length / ( 4.0 * M_PI * remaining_area );
+  }
+
+  /*------------------------------------------------------------------
+  | Write the front state
+  ------------------------------------------------------------------*/
+  void write(std::ostream& os) const
+  {
+    os << "FRONT-HEALTH\n"
+       << "front edges:        " << n_front_edges << "\n"
+       << "front length:       " << front_length << "\n"
+       << "remaining area:     " << remaining_area << "\n"
+       << "front ratio:        " << front_ratio() << "\n"
+       << "min. front angle:   " << min_front_angle * 180.0 / M_PI
+       << " deg at " << min_front_angle_xy 
+       << " (edge length " << min_front_angle_len << ")\n"
+       << "failed base edges:  " << n_failed_base_edges << "\n"
+       << "  in a row:         " << n_consecutive_fails << "\n"
+       << "wide searches:      " << n_wide_searches << "\n"
+       << "generated elements: " << n_generated << "\n";
+  }
+
+}; // FrontHealth
+
+
+/*********************************************************************
+* Monitors the health of an advancing front during the element
+* generation. Failed base edges and wide search activations are
+* counted for every step, while the geometric state of the front is
+* only evaluated when a wide search is activated - i.e. when all
+* front edges failed to create an element.
+*
+* The front is considered as unhealthy, if any of the given limits
+* is exceeded (a limit of zero is ignored). In this case, the
+* meshing strategy applies the configured reaction.
+* The limit of failed base edges applies to the failures in a row,
+* since healthy fronts also accumulate many failures over a run. 
+* Note, that all front edges fail in a row before every wide search.
+*********************************************************************/
+class FrontMonitor
+{
+public:
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  FrontHealthReaction reaction() const { return reaction_; }
+  std::size_t max_failed_base_edges() const { return max_failed_; }
+  std::size_t max_wide_searches() const { return max_wide_; }
+  double min_front_angle() const { return min_angle_; }
+  double max_front_ratio() const { return max_ratio_; }
+
+  std::size_t n_failed_base_edges() const { return n_failed_; }
+  std::size_t n_consecutive_failures() const { return n_consecutive_; }
+  std::size_t n_wide_searches() const { return n_wide_; }
+  bool is_healthy() const { return healthy_; }
+  const FrontHealth& health() const { return health_; }
+
+  /*------------------------------------------------------------------
+  | Setters
+  ------------------------------------------------------------------*/
+  FrontMonitor& reaction(FrontHealthReaction r)
+  { reaction_ = r; return *this; }
+  FrontMonitor& max_failed_base_edges(std::size_t n)
+  { max_failed_ = n; return *this; }
+  FrontMonitor& max_wide_searches(std::size_t n)
+  { max_wide_ = n; return *this; }
+  FrontMonitor& min_front_angle(double a)
+  { min_angle_ = a; return *this; }
+  FrontMonitor& max_front_ratio(double r)
+  { max_ratio_ = r; return *this; }
+
+  /*------------------------------------------------------------------
+  | Reset all counters at the start of a meshing run
+  ------------------------------------------------------------------*/
+  void reset()
+  {
+    n_failed_      = 0;
+    n_consecutive_ = 0;
+    n_wide_        = 0;
+    healthy_  = true;
+    health_   = {};
+
+  } // FrontMonitor::reset()
+
+  /*------------------------------------------------------------------
+  | Reset the counters after the front has been repaired, such that
+  | the limits apply to the repaired front. The total number of 
+  | failed base edges is kept.
+  ------------------------------------------------------------------*/
+  void recover()
+  {
+    n_consecutive_ = 0;
+    n_wide_        = 0;
+    healthy_  = true;
+
+  } // FrontMonitor::recover()
+
+  /*------------------------------------------------------------------
+  | Record a failed base edge. Returns false if the maximum number
+  | of failed base edges in a row is exceeded.
+  ------------------------------------------------------------------*/
+  bool record_failure()
+  {
+    ++n_failed_;
+    ++n_consecutive_;
+
+    if ( max_failed_ > 0 && n_consecutive_ > max_failed_ )
+      healthy_ = false;
+
+    return healthy_;
+
+  } // FrontMonitor::record_failure()
+
+  /*------------------------------------------------------------------
+  | Record a successfully advanced base edge
+  ------------------------------------------------------------------*/
+  void record_success()
+  {
+    n_consecutive_ = 0;
+
+  } // FrontMonitor::record_success()
+
+  /*------------------------------------------------------------------
+  | Record the activation of a wide search and evaluate the state of
+  | the front. Returns false if the front is unhealthy.
+  ------------------------------------------------------------------*/
+  bool record_wide_search(const Front& front, std::size_t n_generated)
+  {
+    ++n_wide_;
+
+    evaluate( front, n_generated );
+
+    if ( max_wide_ > 0 && n_wide_ > max_wide_ )
+      healthy_ = false;
+
+    if ( min_angle_ > 0.0 && health_.min_front_angle < min_angle_ )
+      healthy_ = false;
+
+    if ( max_ratio_ > 0.0 && health_.front_ratio() > max_ratio_ )
+      healthy_ = false;
+
+    return healthy_;
+
+  } // FrontMonitor::record_wide_search()
+
+  /*------------------------------------------------------------------
+  | Evaluate the current state of the front
+  ------------------------------------------------------------------*/
+  const FrontHealth& evaluate(const Front& front, std::size_t n_generated)
+  {
+    health_ = {};
+    health_.n_front_edges       = front.size();
+    health_.n_failed_base_edges = n_failed_;
+    health_.n_consecutive_fails = n_consecutive_;
+    health_.n_wide_searches     = n_wide_;
+    health_.n_generated         = n_generated;
+    health_.min_front_angle     = 2.0 * M_PI;
+
+    double area = 0.0;
+
+    for ( const auto& e_ptr : front )
+    {
+      health_.front_length += e_ptr->length();
+      area += cross( e_ptr->v1().xy(), e_ptr->v2().xy() );
+
+      const Edge* e_next = e_ptr->get_next_edge();
+
+      if ( !e_next )
+        continue;
+
+      const double alpha = front_angle( *e_ptr, *e_next );
+
+      if ( alpha < health_.min_front_angle )
+      {
+        health_.min_front_angle    = alpha;
+        health_.min_front_angle_xy = e_ptr->v2().xy();
+        health_.min_front_angle_len 
+          = 0.5 * ( e_ptr->length() + e_next->length() );
+      }
+    }
+
+    health_.remaining_area = 0.5 * area;
+
+    return health_;
+
+  } // FrontMonitor::evaluate()
+
+  /*------------------------------------------------------------------
+  | The interior angle between two consecutive front edges - the 
+  | unmeshed region is located to the left of the front
+  ------------------------------------------------------------------*/
+  static inline double front_angle(const Edge& e, const Edge& e_next)
+  {
+    const Vec2d& q = e.v2().xy();
+    const Vec2d  a = e.v1().xy() - q;
+    const Vec2d  b = e_next.v2().xy() - q;
+
+    double alpha = std::atan2( cross(b, a), dot(b, a) );
+    if ( alpha < 0.0 )
+      alpha += 2.0 * M_PI;
+
+    return alpha;
+
+  } // FrontMonitor::front_angle()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  FrontHealthReaction reaction_      { FrontHealthReaction::None };
+  std::size_t         max_failed_    { 0 };
+  std::size_t         max_wide_      { 0 };
+  double              min_angle_     { 0.0 };
+  double              max_ratio_     { 0.0 };
+
+  std::size_t         n_failed_      { 0 };
+  std::size_t         n_consecutive_ { 0 };
+  std::size_t         n_wide_        { 0 };
+  bool                healthy_       { true };
+  FrontHealth         health_        {};
+
+}; // FrontMonitor
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <vector>
+#include <functional>
 
 #include "Vertex.h"
 #include "Edge.h"
@@ -15,6 +16,8 @@
 #include "Front.h"
 #include "Domain.h"
 #include "Mesh.h"
+#include "EntityChecks.h"
+#include "ValidationCascade.h"
 
 
 namespace TQMesh {
@@ -22,6 +25,22 @@ namespace TQAlgorithm {
 
 using namespace CppUtils;
 
+/*********************************************************************
+* The score of a valid candidate triangle in the advancing front 
+* update. It is evaluated exactly once per candidate and the 
+* candidate with the highest score is chosen.
+*********************************************************************/
+using TriangleScore 
+  = std::function<double(const Triangle& tri, const Domain& domain)>;
+
+/*********************************************************************
+* The default score is the triangle quality with respect to the
+* local mesh size
+*********************************************************************/
+static inline double triangle_quality_score(const Triangle& tri, 
+                                            const Domain&   domain)
+{ return tri.quality( domain.size_function( tri.xy() ) ); }
+
 /*********************************************************************
 * 
 *********************************************************************/
@@ -30,6 +49,7 @@ class FrontUpdate
 public:
 
   using VertexVector   = std::vector<Vertex*>;
+  using EdgeVector     = std::vector<Edge*>;
   using TriVector      = std::vector<Triangle*>;
 
   /*------------------------------------------------------------------
@@ -45,18 +65,85 @@ public:
   ------------------------------------------------------------------*/
   double min_cell_quality() const { return min_cell_quality_; }
   double max_cell_angle() const { return max_cell_angle_; }
+  bool check_front() const { return check_front_; }
+  bool front_is_valid() const { return front_is_valid_; }
+  const TriangleScore& triangle_score() const { return triangle_score_; }
+  const ValidationCascade& triangle_checks() const { return tri_checks_; }
+  ValidationCascade& triangle_checks() { return tri_checks_; }
+  const ValidationCascade& vertex_checks() const { return vertex_checks_; }
+  ValidationCascade& vertex_checks() { return vertex_checks_; }
 
   /*------------------------------------------------------------------
   | Setters 
   ------------------------------------------------------------------*/
   void min_cell_quality(double v) { min_cell_quality_ = v; }
   void max_cell_angle(double v) { max_cell_angle_ = v; }
+  void check_front(bool c) { check_front_ = c; }
+  void triangle_score(const TriangleScore& s) { triangle_score_ = s; }
+
+  /*------------------------------------------------------------------
+  | Restore the default settings, including the settings of the 
+  | validation cascades - the candidate buffer and the check 
+  | statistics are kept
+  ------------------------------------------------------------------*/
+  void reset_settings()
+  {
+    min_cell_quality_ = 0.0;
+    max_cell_angle_   = M_PI;
+    triangle_score_   = triangle_quality_score;
+#ifndef NDEBUG
+    check_front_      = true;
+#else
+    check_front_      = false;
+#endif
+
+    for ( ValidationCascade* c : { &tri_checks_, &vertex_checks_ } )
+    {
+      c->adaptive( false );
+      c->reorder_interval( 256 );
+      c->timing_interval( 16 );
+    }
+
+  } // FrontUpdate::reset_settings()
+
+  /*------------------------------------------------------------------
+  | Prepare the incremental front checks for a newly initialized 
+  | advancing front. The entire front is validated once, afterwards 
+  | only the edges that are touched by advance_front() are checked. 
+  ------------------------------------------------------------------*/
+  void init_front_check()
+  {
+    front_is_valid_ = true;
+
+    if ( !check_front_ )
+      return;
+
+    front_is_valid_ = EntityChecks::check_front_validity(front_);
+
+  } // init_front_check()
+
+  /*------------------------------------------------------------------
+  | Validate the entire advancing front after it has been modified 
+  | by other means than advance_front(), e.g. by a local retreat.
+  ------------------------------------------------------------------*/
+  void check_modified_front()
+  {
+    if ( !check_front_ || !front_is_valid_ )
+      return;
+
+    front_is_valid_ = EntityChecks::check_front_validity(front_);
+
+  } // check_modified_front()
 
   /*------------------------------------------------------------------
   | Let the front advance  
   ------------------------------------------------------------------*/
   void advance_front(Edge& base, Vertex& v_new, Triangle& t_new)
   {
+    Vertex& b1 = base.v1();
+    Vertex& b2 = base.v2();
+    EdgeVector new_edges {};
+
     // Get advancing front edges adjacent to vertex
     // -> First two vertices of new triangle tri are always
     //    the base edge vertices
@@ -92,7 +179,7 @@ public:
         mesh_.add_interior_edge(e1->v1(), e1->v2());
 
       front_.remove( *e1 );
-      front_.add_edge(v_new, base.v2());
+      new_edges.push_back( &front_.add_edge(v_new, base.v2()) );
     }
     // *** Second edge is connected to vertex ***
     //     -> New edge between first base vertex and vertex
@@ -106,15 +193,15 @@ public:
         mesh_.add_interior_edge(e2->v1(), e2->v2());
 
       front_.remove( *e2 );
-      front_.add_edge(base.v1(), v_new);
+      new_edges.push_back( &front_.add_edge(base.v1(), v_new) );
     }
     // *** Both edges are not connected to vertex ***
     //     -> Create two new edges
     //     -> Vertex now part of the advancing front
     else
     {
-      front_.add_edge(base.v1(), v_new);
-      front_.add_edge(v_new, base.v2());
+      new_edges.push_back( &front_.add_edge(base.v1(), v_new) );
+      new_edges.push_back( &front_.add_edge(v_new, base.v2()) );
     }
 
     update_front_state(base.v1());
@@ -135,6 +222,10 @@ public:
     // Add element area to the total mesh area
     mesh_.add_area( t_new.area() );
 
+    // Validate the touched parts of the advancing front
+    if ( check_front_ )
+      check_front_update(t_new, new_edges, {&b1, &b2, &v_new});
+
   } // advance_front() 
 
   /*------------------------------------------------------------------
@@ -145,8 +236,11 @@ public:
                          const Vec2d& search_position,
                          double search_range)
   {
+    SizeFunctionPhaseScope phase { domain_.size_function_profiler(), 
+                                   SizeFunctionPhase::CandidateCreation };
+
     // Create potential triangles with all found vertices
-    TriVector new_triangles = 
+    TriVector& new_triangles = 
       create_possible_triangles(base_edge, search_position, search_range);
 
     if (new_triangles.size() > 0)
@@ -179,6 +273,9 @@ public:
   ------------------------------------------------------------------*/
   Triangle* update_front_exhaustive(Edge& base_edge, Vertex& v)
   {
+    SizeFunctionPhaseScope phase { domain_.size_function_profiler(), 
+                                   SizeFunctionPhase::CandidateCreation };
+
     if ( !v.on_front() )
       return nullptr;
 
@@ -251,17 +348,19 @@ private:
   | For a given search location and a respective search range,
   | all vertices that are located in this vicinity are checked,
   | if they might be possible candidates for the generation of new
-  | triangles
+  | triangles. The candidates are gathered in a buffer, which is 
+  | reused for every front update.
   ------------------------------------------------------------------*/
-  TriVector create_possible_triangles(Edge& base_edge,
-                                      const Vec2d& search_position,
-                                      double search_range)
+  TriVector& create_possible_triangles(Edge& base_edge,
+                                       const Vec2d& search_position,
+                                       double search_range)
   {
     Vertices& vertices = mesh_.vertices();
 
     // Create potential triangles with all vertices in vicinity of 
     // given search position and search range
-    TriVector new_triangles {};
+    TriVector& new_triangles = candidates_;
+    new_triangles.clear();
 
     for ( Vertex* v : vertices.get_items(search_position, search_range) )
     {
@@ -282,15 +381,19 @@ private:
         new_triangles.push_back( &t_new );
     }
 
-    return std::move(new_triangles);
+    return new_triangles;
 
   } // create_possible_triangles()
 
   /*------------------------------------------------------------------
-  | We sort a given vector of <new_triangles> in descending order
-  | according to the triangle quality.
-  | Finally, the advancing front is updated with the triangle of best
-  | quality and all other triangles are removed.
+  | We score every triangle of a given vector of <new_triangles> 
+  | once and choose the triangle with the highest score in a single
+  | linear pass. All other triangles are removed.
+  | Triangles of equal score are ordered by the creation index of 
+  | their tip vertex, such that the choice does not depend on the
+  | order in which the candidates have been found.
+  | Since all candidates have been validated beforehand, the chosen
+  | triangle can not be rejected anymore.
   ------------------------------------------------------------------*/
   Triangle& choose_best_triangle(TriVector& new_triangles,
                                  Edge&      base)
@@ -301,27 +404,42 @@ private:
        << new_triangles.size()
     );
 
-    std::sort( new_triangles.begin(), new_triangles.end(),
-    [this] ( Triangle* t1, Triangle* t2 )
-    {
-      const double h1 = domain_.size_function( t1->xy() );
-      const double h2 = domain_.size_function( t2->xy() );
-      const double q1 = t1->quality(h1);
-      const double q2 = t2->quality(h2);
+    SizeFunctionPhaseScope phase { domain_.size_function_profiler(), 
+                                   SizeFunctionPhase::Ranking };
 
-      return ( q1 > q2 );
-    });
+    std::size_t i_best = 0;
+    double      s_best = triangle_score_( *new_triangles[0], domain_ );
 
     for (std::size_t i = 1; i < new_triangles.size(); i++)
-      mesh_.triangles().remove( *new_triangles[i] );
+    {
+      const double s = triangle_score_( *new_triangles[i], domain_ );
 
-    return *new_triangles[0];
+      const bool is_better 
+        = ( s > s_best ) 
+       || ( s == s_best && new_triangles[i]->v3().creation_index() 
+                         < new_triangles[i_best]->v3().creation_index() );
+
+      if ( is_better )
+      {
+        i_best = i;
+        s_best = s;
+      }
+    }
+
+    for (std::size_t i = 0; i < new_triangles.size(); i++)
+      if ( i != i_best )
+        mesh_.triangles().remove( *new_triangles[i] );
+
+    return *new_triangles[i_best];
 
   } // choose_best_triangle()
 
   /*------------------------------------------------------------------
   | Check if a triangle is valid. If yes, return true - 
   | else return false.
+  | The checks are evaluated as a cascade, starting with the O(1) 
+  | checks of the triangle's shape, followed by the spatial queries
+  | in the order of their observed efficiency.
   ------------------------------------------------------------------*/
   bool triangle_is_valid(const Triangle& tri)
   {
@@ -334,38 +452,62 @@ private:
 
     DEBUG_LOG("CHECK NEW TRIANGLE: " << tri);
 
-    if ( !tri.is_valid() )
-      return false;
-
-    if ( tri.intersects_front( front_, range ) )
-    { DEBUG_LOG("  > FRONT INTERSECTION"); return false; }
-
-    if ( tri.intersects_domain( domain_ ) )
-    { DEBUG_LOG("  > DOMAIN INTERSECTION"); return false; }
-
-    if ( tri.intersects_vertex( vertices, range ) )
-    { DEBUG_LOG("  > VERTEX INTERSECTION"); return false; }
-
-    if ( tri.intersects_triangle( triangles, range ) )
-    { DEBUG_LOG("  > TRIANGLE INTERSECTION"); return false; }
-
-    if ( tri.intersects_quad( quads, range ) )
-    { DEBUG_LOG("  > QUAD INTERSECTION"); return false; }
-
-    if ( tri.quality(rho) < min_cell_quality_ )
-    { DEBUG_LOG("  > BAD TRIANGLE QUALITY"); return false; }
+    const bool valid = tri_checks_.run( [&](size_t i)
+    {
+      switch ( i )
+      {
+        case 0:
+          return tri.is_valid();
+
+        case 1:
+          if ( tri.quality(rho) < min_cell_quality_ )
+          { DEBUG_LOG("  > BAD TRIANGLE QUALITY"); return false; }
+          return true;
+
+        case 2:
+          if ( tri.max_angle() > max_cell_angle_ )
+          { DEBUG_LOG("  > BAD MAXIMUM ANGLE"); return false; }
+          return true;
+
+        case 3:
+          if ( tri.intersects_front( front_, range ) )
+          { DEBUG_LOG("  > FRONT INTERSECTION"); return false; }
+          return true;
+
+        case 4:
+          if ( tri.intersects_domain( domain_ ) )
+          { DEBUG_LOG("  > DOMAIN INTERSECTION"); return false; }
+          return true;
+
+        case 5:
+          if ( tri.intersects_vertex( vertices, range ) )
+          { DEBUG_LOG("  > VERTEX INTERSECTION"); return false; }
+          return true;
+
+        case 6:
+          if ( tri.intersects_triangle( triangles, range ) )
+          { DEBUG_LOG("  > TRIANGLE INTERSECTION"); return false; }
+          return true;
+
+        default:
+          if ( tri.intersects_quad( quads, range ) )
+          { DEBUG_LOG("  > QUAD INTERSECTION"); return false; }
+          return true;
+      }
+    });
 
-    if ( tri.max_angle() > max_cell_angle_ )
-    { DEBUG_LOG("  > BAD MAXIMUM ANGLE"); return false; }
+    if ( valid )
+    { DEBUG_LOG("  > VALID"); }
 
-    DEBUG_LOG("  > VALID");
-    return true;
+    return valid;
 
   } // Mesh::triangle_is_valid()
 
   /*------------------------------------------------------------------
   | Check if a vertex is valid. If yes, return true - 
   | else return false.
+  | All checks are spatial queries, which are evaluated in the 
+  | order of their observed efficiency.
   ------------------------------------------------------------------*/
   bool vertex_is_valid(const Vertex& v)
   {
@@ -377,20 +519,36 @@ private:
 
     DEBUG_LOG("CHECK NEW VERTEX: " << v);
 
-    if ( !domain_.is_inside( v ) )
-    { DEBUG_LOG("  > OUTSIDE DOMAIN"); return false; }
-
-    if ( v.intersects_facet(triangles, range) )
-    { DEBUG_LOG("  > TRIANGLE INTERSECTION"); return false; }
+    const bool valid = vertex_checks_.run( [&](size_t i)
+    {
+      switch ( i )
+      {
+        case 0:
+          if ( !domain_.is_inside( v ) )
+          { DEBUG_LOG("  > OUTSIDE DOMAIN"); return false; }
+          return true;
+
+        case 1:
+          if ( v.intersects_facet(triangles, range) )
+          { DEBUG_LOG("  > TRIANGLE INTERSECTION"); return false; }
+          return true;
+
+        case 2:
+          if ( v.intersects_facet(quads, range) )
+          { DEBUG_LOG("  > QUAD INTERSECTION"); return false; }
+          return true;
+
+        default:
+          if ( v.intersects_mesh_edges(mesh_, range, ve_intersection_*rho) )
+          { DEBUG_LOG("  > EDGE INTERSECTION"); return false; }
+          return true;
+      }
+    });
 
-    if ( v.intersects_facet(quads, range) )
-    { DEBUG_LOG("  > QUAD INTERSECTION"); return false; }
+    if ( valid )
+    { DEBUG_LOG("  > VALID"); }
 
-    if ( v.intersects_mesh_edges(mesh_, range, ve_intersection_ * rho) )
-    { DEBUG_LOG("  > EDGE INTERSECTION"); return false; }
-
-    DEBUG_LOG("  > VALID");
-    return true;
+    return valid;
 
   } // Mesh::vertex_is_valid()
 
@@ -416,6 +574,27 @@ private:
 
     return;
   }
+
+  /*------------------------------------------------------------------
+  | Validate the advancing front locally after it has been updated 
+  | with a new triangle. A detected corruption is reported once and 
+  | the front is marked as invalid.
+  ------------------------------------------------------------------*/
+  void check_front_update(const Triangle&     t_new,
+                          const EdgeVector&   new_edges,
+                          const VertexVector& vertices)
+  {
+    if ( EntityChecks::check_front_update(front_, t_new, new_edges, 
+                                          vertices, front_.max_edge_length()) )
+      return;
+
+    if ( front_is_valid_ )
+      LOG(ERROR) << "Invalid front: Front corrupted by triangle at " 
+                 << t_new.xy() << ".";
+
+    front_is_valid_ = false;
+
+  } // check_front_update()
   
   /*------------------------------------------------------------------
   | Attributes
@@ -428,6 +607,25 @@ private:
   double          max_cell_angle_   = M_PI;
   double          ve_intersection_  = 0.01;
 
+  TriangleScore   triangle_score_   = triangle_quality_score;
+  TriVector       candidates_       {};
+
+  ValidationCascade tri_checks_ 
+  { { "shape", "quality", "max. angle", "front intersection", 
+      "domain intersection", "vertex intersection", 
+      "triangle intersection", "quad intersection" }, 3 };
+
+  ValidationCascade vertex_checks_
+  { { "inside domain", "triangle intersection", "quad intersection",
+      "edge intersection" }, 0 };
+
+  bool            front_is_valid_   = true;
+#ifndef NDEBUG
+  bool            check_front_      = true;
+#else
+  bool            check_front_      = false;
+#endif
+
 }; // FrontUpdate
 
 
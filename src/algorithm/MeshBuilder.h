@@ -159,6 +159,14 @@ public:
   | The mesh does not contain any elements.
   ------------------------------------------------------------------*/
   bool prepare_mesh(Mesh& mesh, Domain& domain)
+  { return prepare_mesh(mesh, domain, meshes_); }
+
+  /*------------------------------------------------------------------
+  | Prepare a given mesh entity for the advancing front triangulation,
+  | where only the given <nbr_meshes> are considered as neighbors
+  ------------------------------------------------------------------*/
+  bool prepare_mesh(Mesh& mesh, Domain& domain, 
+                    const MeshVector& nbr_meshes)
   {
     // We require an empty mesh
     if ( !mesh.is_empty() )
@@ -177,7 +185,7 @@ public:
     // Get all edges that will define the advancing front
     // Here, we also consider other meshes that have been defined with 
     // this mesh builder, in order to maintain vertex-adjacency
-    FrontInitData front_data { domain, meshes_ };
+    FrontInitData front_data { domain, nbr_meshes };
 
     // Initialize edges in a temporary advancing front
     Front tmp_front {};
@@ -8,7 +8,10 @@
 #pragma once
 
 #include <algorithm>
+#include <vector>
+#include <unordered_set>
 #include <limits.h>
+#include <float.h>
 
 #include "VecND.h"
 
@@ -23,6 +26,17 @@ namespace TQAlgorithm {
 
 using namespace CppUtils;
 
+/*********************************************************************
+* A pair of periodic boundary vertices
+*********************************************************************/
+struct PeriodicVertexPair
+{
+  Vertex* source;
+  Vertex* target;
+  int     source_marker;
+  int     target_marker;
+};
+
 /*********************************************************************
 * This class contains all functions that are required to cleanup and
 * prepare the mesh after the generation process
@@ -90,6 +104,78 @@ public:
 
   } // MeshCleanup:assign_size_function_to_vertices()
 
+  /*------------------------------------------------------------------
+  | Collect the pairs of (source, target) vertices for all periodic 
+  | boundary pairs of a given domain. Each vertex of a source 
+  | boundary is mapped by the pair's transformation and matched 
+  | with the coincident vertex of the target boundary.
+  ------------------------------------------------------------------*/
+  template <typename Mesh, typename Domain>
+  static inline std::vector<PeriodicVertexPair> 
+  get_periodic_vertex_pairs(const Mesh& mesh, const Domain& domain)
+  {
+    std::vector<PeriodicVertexPair> pairs {};
+
+    for ( const auto& periodic : domain.periodic_pairs() )
+    {
+      // Collect all vertices of the source boundary, as well as
+      // the shortest source edge for the matching tolerance
+      std::vector<Vertex*> source_vertices {};
+      std::unordered_set<Vertex*> visited {};
+      double min_length = DBL_MAX;
+
+      for ( const auto& e_ptr : mesh.boundary_edges() )
+      {
+        if ( e_ptr->marker() != periodic.source_marker )
+          continue;
+
+        for ( Vertex* v : { &e_ptr->v1(), &e_ptr->v2() } )
+          if ( visited.insert( v ).second )
+            source_vertices.push_back( v );
+
+        min_length = MIN( min_length, e_ptr->length() );
+      }
+
+      const double tol = 1.0E-6 * min_length;
+
+      for ( Vertex* v_src : source_vertices )
+      {
+        const Vec2d xy = periodic.transformation( v_src->xy() );
+
+        for ( Vertex* v_tgt : mesh.vertices().get_items(xy, tol) )
+        {
+          if ( !is_on_boundary_marker( *v_tgt, mesh, 
+                                       periodic.target_marker ) )
+            continue;
+
+          pairs.push_back( { v_src, v_tgt, periodic.source_marker,
+                             periodic.target_marker } );
+          break;
+        }
+      }
+    }
+
+    return std::move( pairs );
+
+  } // MeshCleanup::get_periodic_vertex_pairs()
+
+
+  /*------------------------------------------------------------------
+  | Check if a vertex is adjacent to a boundary edge with a given 
+  | marker
+  ------------------------------------------------------------------*/
+  template <typename Mesh>
+  static inline bool is_on_boundary_marker(const Vertex& v, 
+                                           const Mesh&   mesh,
+                                           int           marker)
+  {
+    for ( const auto& e : v.edges() )
+      if ( &e->edgelist() == &mesh.boundary_edges() && 
+           e->marker() == marker )
+        return true;
+    return false;
+
+  } // MeshCleanup::is_on_boundary_marker()
 
   /*------------------------------------------------------------------
   | Initialize the connectivity between facets and facets, as well  
@@ -721,7 +807,10 @@ public:
       const double b_r = b->facet_r()->min_edge_length();
       const double b_ang = MIN(b_l, b_r);
 
-      return a_ang < b_ang;
+      if ( a_ang != b_ang )
+        return a_ang < b_ang;
+
+      return a->creation_index() < b->creation_index();
     });
 
     // Loop over all sorted edges and merge their adjacent triangles
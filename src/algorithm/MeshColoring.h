@@ -0,0 +1,421 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <vector>         // std::vector
+#include <ostream>        // std::ostream
+#include <iomanip>        // std::setw, std::setprecision
+#include <cstdint>        // uint8_t
+#include <unordered_map>  // std::unordered_map
+
+#include "utils.h"
+
+#include "Facet.h"
+#include "Mesh.h"
+#include "MeshCleanup.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* The adjacency between elements, that must not share a color
+* > Vertex: Elements that share a vertex, i.e. no two elements of
+*           the same color contribute to the same vertex, as
+*           required for the parallel assembly of nodal quantities
+* > Edge:   Elements that share an edge
+*********************************************************************/
+enum class ColoringAdjacency : uint8_t {
+  Vertex = 0,
+  Edge   = 1,
+};
+
+/*********************************************************************
+* This class colors the elements of a mesh, such that adjacent
+* elements obtain different colors. The elements of a single color
+* can thus be processed concurrently without conflicts.
+*
+* The elements are colored greedily in the order of the mesh, i.e.
+* every element obtains the smallest color, which is not used by
+* any of its adjacent elements. Greedy colorings tend to put most
+* elements into the first colors. If balanced color classes are
+* requested, elements of classes larger than the mean class size
+* are subsequently moved to the smallest permissible class below
+* the mean size. This does not change the number of colors.
+*
+* These colors are not related to the element colors of the mesh
+* (Facet::color()), which mark the meshes an element belongs to.
+* The coloring is invalidated by any modification of the mesh.
+*********************************************************************/
+class MeshColoring
+{
+public:
+  using FacetVector  = std::vector<const Facet*>;
+  using SizeVector   = std::vector<std::size_t>;
+
+  /*------------------------------------------------------------------
+  | Constructor / Destructor
+  ------------------------------------------------------------------*/
+  MeshColoring(Mesh& mesh)
+  : mesh_ { &mesh }
+  {}
+
+  ~MeshColoring() {}
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  ColoringAdjacency adjacency() const { return adjacency_; }
+  bool balanced() const { return balanced_; }
+  std::size_t n_colors() const { return class_sizes_.size(); }
+  const SizeVector& class_sizes() const { return class_sizes_; }
+
+  /*------------------------------------------------------------------
+  | Get the color of an element - or -1, if it has not been colored
+  ------------------------------------------------------------------*/
+  int color(const Facet& f) const
+  {
+    auto iter = colors_.find( &f );
+    return ( iter != colors_.end() ) ? iter->second : -1;
+  }
+
+  /*------------------------------------------------------------------
+  | Setters
+  ------------------------------------------------------------------*/
+  MeshColoring& adjacency(ColoringAdjacency a)
+  { adjacency_ = a; return *this; }
+  MeshColoring& balanced(bool b)
+  { balanced_ = b; return *this; }
+
+  /*------------------------------------------------------------------
+  | Check if the coloring belongs to the current state of the mesh
+  ------------------------------------------------------------------*/
+  bool matches(const Mesh& mesh) const
+  {
+    if ( &mesh != mesh_ || colors_.size() != mesh.n_elements() )
+      return false;
+
+    for ( const auto& q_ptr : mesh.quads() )
+      if ( colors_.count( q_ptr.get() ) == 0 )
+        return false;
+
+    for ( const auto& t_ptr : mesh.triangles() )
+      if ( colors_.count( t_ptr.get() ) == 0 )
+        return false;
+
+    return true;
+
+  } // MeshColoring::matches()
+
+  /*------------------------------------------------------------------
+  | Color all elements of the mesh and return the number of colors
+  ------------------------------------------------------------------*/
+  std::size_t compute()
+  {
+    colors_.clear();
+    class_sizes_.clear();
+
+    collect_neighbors();
+
+    color_elements();
+
+    if ( balanced_ )
+      balance_classes();
+
+    neighbors_.clear();
+    nbr_offsets_.clear();
+    element_colors_.clear();
+    forbidden_.clear();
+
+    return n_colors();
+
+  } // MeshColoring::compute()
+
+  /*------------------------------------------------------------------
+  | Check that no adjacent elements share a color
+  ------------------------------------------------------------------*/
+  bool is_valid()
+  {
+    if ( !matches( *mesh_ ) )
+      return false;
+
+    collect_neighbors();
+
+    bool valid = true;
+
+    for ( std::size_t i = 0; i < elements_.size() && valid; ++i )
+      for ( std::size_t j = nbr_offsets_[i]; j < nbr_offsets_[i+1]; ++j )
+        if ( color( *elements_[i] ) == color( *elements_[neighbors_[j]] ) )
+          valid = false;
+
+    neighbors_.clear();
+    nbr_offsets_.clear();
+
+    return valid;
+
+  } // MeshColoring::is_valid()
+
+  /*------------------------------------------------------------------
+  | Sort the quads and the triangles of the mesh by their colors,
+  | such that every color class is stored contiguously within the
+  | quads and within the triangles. The order of the elements within
+  | a color class is preserved.
+  ------------------------------------------------------------------*/
+  bool reorder()
+  {
+    if ( !matches( *mesh_ ) )
+      return false;
+
+    mesh_->quads().sort(
+    [this]( std::unique_ptr<Quad>& a, std::unique_ptr<Quad>& b )
+    { return colors_[a.get()] < colors_[b.get()]; });
+
+    mesh_->triangles().sort(
+    [this]( std::unique_ptr<Triangle>& a, std::unique_ptr<Triangle>& b )
+    { return colors_[a.get()] < colors_[b.get()]; });
+
+    MeshCleanup::assign_mesh_indices( *mesh_ );
+
+    return true;
+
+  } // MeshColoring::reorder()
+
+  /*------------------------------------------------------------------
+  | Write the element colors in the order of the mesh elements,
+  | followed by the sizes of all color classes
+  ------------------------------------------------------------------*/
+  void write(std::ostream& os) const
+  {
+    os << "ELEMENTCOLORS " << mesh_->n_elements() << "\n";
+
+    for ( const auto& q_ptr : mesh_->quads() )
+      os << std::setprecision(0) << std::fixed
+         << std::setw(4) << color( *q_ptr ) << "\n";
+
+    for ( const auto& t_ptr : mesh_->triangles() )
+      os << std::setprecision(0) << std::fixed
+         << std::setw(4) << color( *t_ptr ) << "\n";
+
+    os << "COLORCLASSES " << class_sizes_.size() << "\n";
+
+    for ( std::size_t i = 0; i < class_sizes_.size(); ++i )
+      os << std::setprecision(0) << std::fixed
+         << std::setw(4) << i << ","
+         << std::setw(8) << class_sizes_[i] << "\n";
+
+  } // MeshColoring::write()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Gather all elements and their adjacent elements in a compressed
+  | adjacency list, in terms of the positions in <elements_>
+  ------------------------------------------------------------------*/
+  void collect_neighbors()
+  {
+    elements_.clear();
+    neighbors_.clear();
+    nbr_offsets_.clear();
+
+    std::unordered_map<const Facet*, std::size_t> positions {};
+
+    for ( const auto& q_ptr : mesh_->quads() )
+    {
+      positions[ q_ptr.get() ] = elements_.size();
+      elements_.push_back( q_ptr.get() );
+    }
+
+    for ( const auto& t_ptr : mesh_->triangles() )
+    {
+      positions[ t_ptr.get() ] = elements_.size();
+      elements_.push_back( t_ptr.get() );
+    }
+
+    if ( adjacency_ == ColoringAdjacency::Edge )
+      MeshCleanup::setup_facet_connectivity( *mesh_ );
+
+    nbr_offsets_.push_back( 0 );
+
+    for ( const Facet* f : elements_ )
+    {
+      const std::size_t n_begin = neighbors_.size();
+
+      for ( std::size_t i = 0; i < f->n_vertices(); ++i )
+      {
+        if ( adjacency_ == ColoringAdjacency::Edge )
+        {
+          const Facet* f_nbr = neighbor( *f, i );
+
+          if (  f_nbr && f_nbr != &NullFacet::get_instance() 
+             && f_nbr->mesh() == mesh_ )
+            neighbors_.push_back( positions[ f_nbr ] );
+
+          continue;
+        }
+
+        for ( const Facet* f_nbr : f->vertex(i).facets() )
+        {
+          if ( f_nbr == f || f_nbr->mesh() != mesh_ )
+            continue;
+
+          // Elements that share an edge are found twice
+          bool found = false;
+          const std::size_t k = positions[ f_nbr ];
+
+          for ( std::size_t j = n_begin; j < neighbors_.size(); ++j )
+            if ( neighbors_[j] == k )
+              found = true;
+
+          if ( !found )
+            neighbors_.push_back( k );
+        }
+      }
+
+      nbr_offsets_.push_back( neighbors_.size() );
+    }
+
+  } // MeshColoring::collect_neighbors()
+
+  /*------------------------------------------------------------------
+  | The element adjacent to the i-th edge of a given element
+  ------------------------------------------------------------------*/
+  static inline const Facet* neighbor(const Facet& f, std::size_t i)
+  {
+    if ( f.n_vertices() == 4 )
+      return static_cast<const Quad&>(f).neighbor(i);
+
+    return static_cast<const Triangle&>(f).neighbor(i);
+  }
+
+  /*------------------------------------------------------------------
+  | Greedy coloring of all elements
+  ------------------------------------------------------------------*/
+  void color_elements()
+  {
+    element_colors_.assign( elements_.size(), -1 );
+    class_sizes_.clear();
+
+    for ( std::size_t i = 0; i < elements_.size(); ++i )
+    {
+      mark_neighbor_colors( i );
+
+      std::size_t c = 0;
+      while ( c < class_sizes_.size() && forbidden_[c] == i + 1 )
+        ++c;
+
+      if ( c == class_sizes_.size() )
+        class_sizes_.push_back( 0 );
+
+      element_colors_[i] = static_cast<int>( c );
+      ++class_sizes_[c];
+    }
+
+    store_colors();
+
+  } // MeshColoring::color_elements()
+
+  /*------------------------------------------------------------------
+  | Move elements from classes above the mean class size to the 
+  | smallest permissible class below the mean class size
+  ------------------------------------------------------------------*/
+  void balance_classes()
+  {
+    const std::size_t n_classes = class_sizes_.size();
+
+    if ( n_classes < 2 )
+      return;
+
+    const std::size_t target = ( elements_.size() + n_classes - 1 ) 
+                             / n_classes;
+
+    // Discard the stamps of the greedy coloring, which used the 
+    // same element indices
+    forbidden_.assign( n_classes + 1, 0 );
+
+    for ( std::size_t i = 0; i < elements_.size(); ++i )
+    {
+      const std::size_t c_old = element_colors_[i];
+
+      if ( class_sizes_[c_old] <= target )
+        continue;
+
+      mark_neighbor_colors( i );
+
+      std::size_t c_new = n_classes;
+
+      for ( std::size_t c = 0; c < n_classes; ++c )
+      {
+        if ( forbidden_[c] == i + 1 || class_sizes_[c] >= target )
+          continue;
+
+        if ( c_new == n_classes || class_sizes_[c] < class_sizes_[c_new] )
+          c_new = c;
+      }
+
+      if ( c_new == n_classes )
+        continue;
+
+      element_colors_[i] = static_cast<int>( c_new );
+      --class_sizes_[c_old];
+      ++class_sizes_[c_new];
+    }
+
+    store_colors();
+
+  } // MeshColoring::balance_classes()
+
+  /*------------------------------------------------------------------
+  | Mark the colors of all elements adjacent to the i-th element
+  | by i+1 in <forbidden_>
+  ------------------------------------------------------------------*/
+  void mark_neighbor_colors(std::size_t i)
+  {
+    forbidden_.resize( class_sizes_.size() + 1, 0 );
+
+    for ( std::size_t j = nbr_offsets_[i]; j < nbr_offsets_[i+1]; ++j )
+    {
+      const int c = element_colors_[ neighbors_[j] ];
+      if ( c >= 0 )
+        forbidden_[c] = i + 1;
+    }
+
+  } // MeshColoring::mark_neighbor_colors()
+
+  /*------------------------------------------------------------------
+  | Store the colors of all elements
+  ------------------------------------------------------------------*/
+  void store_colors()
+  {
+    colors_.clear();
+
+    for ( std::size_t i = 0; i < elements_.size(); ++i )
+      colors_[ elements_[i] ] = element_colors_[i];
+  }
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  Mesh*                                  mesh_;
+
+  ColoringAdjacency                      adjacency_ { ColoringAdjacency::Vertex };
+  bool                                   balanced_  { true };
+
+  std::unordered_map<const Facet*, int>  colors_      {};
+  SizeVector                             class_sizes_ {};
+
+  FacetVector                            elements_    {};
+  SizeVector                             neighbors_   {};
+  SizeVector                             nbr_offsets_ {};
+  std::vector<int>                       element_colors_ {};
+  SizeVector                             forbidden_   {};
+
+}; // MeshColoring
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
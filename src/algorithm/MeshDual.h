@@ -0,0 +1,310 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <vector>         // std::vector
+#include <array>          // std::array
+#include <thread>         // std::thread
+#include <ostream>        // std::ostream
+#include <iomanip>        // std::setw, std::setprecision
+
+#include "VecND.h"
+
+#include "utils.h"
+#include "Facet.h"
+#include "Edge.h"
+#include "Mesh.h"
+#include "MeshCleanup.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* This class computes the metrics of the median-dual control volumes
+* of a mesh, as required by vertex-centered finite-volume schemes.
+* The dual cell of a vertex is bounded by the segments, that connect
+* the midpoints of its adjacent edges with the centroids of its
+* adjacent elements:
+*
+*   > Dual volumes:   The area of the dual cell of every vertex
+*   > Dual faces:     For every mesh edge (v1,v2), the integrated
+*                     normal of the dual face between the cells of
+*                     v1 and v2, pointing from v1 to v2
+*   > Boundary faces: For every boundary edge, the integrated
+*                     outward normal, of which each vertex of the
+*                     edge obtains one half
+*
+* Thus the normals of every dual cell sum up to zero. All metrics
+* are stored in compact arrays in terms of the vertex indices of
+* MeshCleanup::assign_mesh_indices().
+*
+* Every metric is computed in a loop, that writes to disjoint
+* array entries only, i.e. over the edges or over the vertices.
+* These loops are optionally split into chunks, which are processed
+* by concurrent threads.
+* The metrics are invalidated by any modification of the mesh.
+*********************************************************************/
+class MeshDual
+{
+public:
+  using EdgeIndices  = std::array<std::size_t,2>;
+
+  /*------------------------------------------------------------------
+  | Constructor / Destructor
+  ------------------------------------------------------------------*/
+  MeshDual(Mesh& mesh)
+  : mesh_ { &mesh }
+  {}
+
+  ~MeshDual() {}
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  std::size_t n_threads() const { return n_threads_; }
+  std::size_t min_chunk_size() const { return min_chunk_; }
+
+  const std::vector<double>& volumes() const { return volumes_; }
+  const std::vector<EdgeIndices>& edges() const { return edges_; }
+  const std::vector<Vec2d>& face_normals() const { return normals_; }
+  const std::vector<EdgeIndices>& boundary_edges() const
+  { return bdry_edges_; }
+  const std::vector<Vec2d>& boundary_normals() const
+  { return bdry_normals_; }
+  const std::vector<int>& boundary_markers() const
+  { return bdry_markers_; }
+
+  /*------------------------------------------------------------------
+  | Setters - the loops are only split into chunks of at least
+  | <min_chunk_size> entries
+  ------------------------------------------------------------------*/
+  MeshDual& n_threads(std::size_t n)
+  { n_threads_ = MAX( std::size_t{1}, n ); return *this; }
+  MeshDual& min_chunk_size(std::size_t n)
+  { min_chunk_ = MAX( std::size_t{1}, n ); return *this; }
+
+  /*------------------------------------------------------------------
+  | Check if the metrics belong to the current state of the mesh
+  ------------------------------------------------------------------*/
+  bool matches(const Mesh& mesh) const
+  {
+    return (  &mesh == mesh_
+           && volumes_.size()    == mesh.n_vertices()
+           && edges_.size()      == mesh.n_edges()
+           && bdry_edges_.size() == mesh.n_boundary_edges()
+           && volumes_.size() > 0 );
+  }
+
+  /*------------------------------------------------------------------
+  | Compute all dual metrics
+  ------------------------------------------------------------------*/
+  void compute()
+  {
+    MeshCleanup::assign_mesh_indices( *mesh_ );
+    MeshCleanup::setup_facet_connectivity( *mesh_ );
+
+    vertices_.clear();
+    edge_ptrs_.clear();
+
+    for ( const auto& v_ptr : mesh_->vertices() )
+      vertices_.push_back( v_ptr.get() );
+
+    for ( const auto& e_ptr : mesh_->interior_edges() )
+      edge_ptrs_.push_back( e_ptr.get() );
+
+    const std::size_t n_intr_edges = edge_ptrs_.size();
+
+    for ( const auto& e_ptr : mesh_->boundary_edges() )
+      edge_ptrs_.push_back( e_ptr.get() );
+
+    volumes_.assign( vertices_.size(), 0.0 );
+    edges_.assign( edge_ptrs_.size(), {0, 0} );
+    normals_.assign( edge_ptrs_.size(), {0.0, 0.0} );
+
+    const std::size_t n_bdry_edges = edge_ptrs_.size() - n_intr_edges;
+
+    bdry_edges_.assign( n_bdry_edges, {0, 0} );
+    bdry_normals_.assign( n_bdry_edges, {0.0, 0.0} );
+    bdry_markers_.assign( n_bdry_edges, 0 );
+
+    for_each_chunk( vertices_.size(),
+    [this](std::size_t begin, std::size_t end)
+    {
+      for ( std::size_t i = begin; i < end; ++i )
+        volumes_[ vertices_[i]->index() ] = dual_volume( *vertices_[i] );
+    });
+
+    for_each_chunk( edge_ptrs_.size(),
+    [this](std::size_t begin, std::size_t end)
+    {
+      for ( std::size_t i = begin; i < end; ++i )
+      {
+        const Edge& e = *edge_ptrs_[i];
+        edges_[i]   = { static_cast<std::size_t>( e.v1().index() ),
+                        static_cast<std::size_t>( e.v2().index() ) };
+        normals_[i] = dual_face_normal( e );
+      }
+    });
+
+    for_each_chunk( n_bdry_edges,
+    [this, n_intr_edges](std::size_t begin, std::size_t end)
+    {
+      for ( std::size_t i = begin; i < end; ++i )
+      {
+        const Edge& e = *edge_ptrs_[n_intr_edges + i];
+        const Vec2d d = e.v2().xy() - e.v1().xy();
+
+        // The mesh is located to the left of its boundary edges
+        bdry_edges_[i]   = edges_[n_intr_edges + i];
+        bdry_normals_[i] = { d.y, -d.x };
+        bdry_markers_[i] = e.marker();
+      }
+    });
+
+    vertices_.clear();
+    edge_ptrs_.clear();
+
+  } // MeshDual::compute()
+
+  /*------------------------------------------------------------------
+  | Write the dual metrics in terms of the mesh vertex indices
+  ------------------------------------------------------------------*/
+  void write(std::ostream& os) const
+  {
+    os << "DUALVOLUMES " << volumes_.size() << "\n";
+    for ( double v : volumes_ )
+      os << std::setprecision(8) << std::fixed << v << "\n";
+
+    os << "DUALFACES " << edges_.size() << "\n";
+    for ( std::size_t i = 0; i < edges_.size(); ++i )
+      os << std::setprecision(0) << std::fixed
+         << std::setw(4) << edges_[i][0] << ","
+         << std::setw(4) << edges_[i][1] << ","
+         << std::setprecision(8)
+         << normals_[i].x << "," << normals_[i].y << "\n";
+
+    os << "DUALBOUNDARYFACES " << bdry_edges_.size() << "\n";
+    for ( std::size_t i = 0; i < bdry_edges_.size(); ++i )
+      os << std::setprecision(0) << std::fixed
+         << std::setw(4) << bdry_edges_[i][0] << ","
+         << std::setw(4) << bdry_edges_[i][1] << ","
+         << std::setw(4) << bdry_markers_[i] << ","
+         << std::setprecision(8)
+         << bdry_normals_[i].x << "," << bdry_normals_[i].y << "\n";
+
+  } // MeshDual::write()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Apply a function to all chunks of the index range [0,n)
+  ------------------------------------------------------------------*/
+  template <typename Function>
+  void for_each_chunk(std::size_t n, const Function& fn) const
+  {
+    const std::size_t n_chunks
+      = MAX( std::size_t{1}, MIN( n_threads_, n / min_chunk_ ) );
+
+    if ( n_chunks == 1 )
+    {
+      fn( 0, n );
+      return;
+    }
+
+    std::vector<std::thread> threads {};
+
+    for ( std::size_t i = 1; i < n_chunks; ++i )
+      threads.emplace_back( fn, i * n / n_chunks, (i+1) * n / n_chunks );
+
+    fn( 0, n / n_chunks );
+
+    for ( std::thread& t : threads )
+      t.join();
+
+  } // MeshDual::for_each_chunk()
+
+  /*------------------------------------------------------------------
+  | The area of the dual cell of a vertex. Every adjacent element
+  | contributes the quadrilateral, that is spanned by the vertex,
+  | the midpoints of its two edges at the vertex and its centroid.
+  ------------------------------------------------------------------*/
+  static inline double dual_volume(const Vertex& v)
+  {
+    double area = 0.0;
+
+    for ( const Facet* f : v.facets() )
+    {
+      const std::size_t n = f->n_vertices();
+      const std::size_t i = f->get_vertex_index( v );
+
+      const Vec2d& p = v.xy();
+      const Vec2d  a = 0.5 * ( p + f->vertex( (i+1) % n ).xy() );
+      const Vec2d  b = 0.5 * ( p + f->vertex( (i+n-1) % n ).xy() );
+      const Vec2d& c = f->xy();
+
+      area += 0.5 * ( cross( a - p, c - p ) + cross( c - p, b - p ) );
+    }
+
+    return area;
+
+  } // MeshDual::dual_volume()
+
+  /*------------------------------------------------------------------
+  | The integrated normal of the dual face of an edge, that consists
+  | of the segments between the edge midpoint and the centroids of
+  | the adjacent elements
+  ------------------------------------------------------------------*/
+  static inline Vec2d dual_face_normal(const Edge& e)
+  {
+    const Vec2d m = e.xy();
+    const Vec2d d = e.v2().xy() - e.v1().xy();
+
+    Vec2d n { 0.0, 0.0 };
+
+    for ( const Facet* f : { e.facet_l(), e.facet_r() } )
+    {
+      if ( !f || f == &NullFacet::get_instance() )
+        continue;
+
+      const Vec2d s = f->xy() - m;
+      Vec2d n_s { s.y, -s.x };
+
+      if ( dot( n_s, d ) < 0.0 )
+        n_s = -1.0 * n_s;
+
+      n += n_s;
+    }
+
+    return n;
+
+  } // MeshDual::dual_face_normal()
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  Mesh*                     mesh_;
+
+  std::size_t               n_threads_    { 1 };
+  std::size_t               min_chunk_    { 4096 };
+
+  std::vector<double>       volumes_      {};
+  std::vector<EdgeIndices>  edges_        {};
+  std::vector<Vec2d>        normals_      {};
+  std::vector<EdgeIndices>  bdry_edges_   {};
+  std::vector<Vec2d>        bdry_normals_ {};
+  std::vector<int>          bdry_markers_ {};
+
+  std::vector<const Vertex*> vertices_    {};
+  std::vector<const Edge*>   edge_ptrs_   {};
+
+}; // MeshDual
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <map>
+#include <unordered_map>
 #include <limits.h>
 
 #include "VecND.h"
@@ -18,6 +20,8 @@
 #include "MeshBuilder.h"
 #include "MeshWriter.h"
 #include "MeshMerger.h"
+#include "MeshTiling.h"
+#include "MeshWarmStart.h"
 #include "MeshingStrategy.h"
 #include "SmoothingStrategy.h"
 #include "RefinementStrategy.h"
@@ -49,11 +53,13 @@ enum class SmoothingAlgorithm {
 enum class RefinementAlgorithm {
   None,
   Quad,
+  Delaunay,
 };
 
 enum class ModificationAlgorithm {
   None,
   Tri2Quad,
+  Valence,
   QMorph,
 };
 
@@ -109,6 +115,109 @@ public:
     return new_mesh;
   }
 
+  /*------------------------------------------------------------------
+  | Create a new mesh from copies of a meshed unit <cell>, which are
+  | placed by the given transformations. The copies are stitched at
+  | coincident boundary edges, such that no duplicate vertices occur.
+  | The <domain> defines the extent and the size function of the new 
+  | mesh - it must enclose all copies, but its boundaries are not 
+  | meshed. 
+  | Copies that would overlap the mesh, or whose boundary vertices 
+  | do not match the mesh at shared interfaces, are skipped.
+  ------------------------------------------------------------------*/
+  Mesh& new_tiled_mesh(Domain&                                domain,
+                       Mesh&                                  cell,
+                       const std::vector<MeshTransformation>& placements,
+                       int mesh_id = DEFAULT_MESH_ID,
+                       int element_color = DEFAULT_ELEMENT_COLOR)
+  {
+    if ( !mesh_builder_.get_domain( cell ) )
+      TERMINATE("MeshGenerator::new_tiled_mesh(): Invalid mesh provided.");
+
+    meshes_.push_back( 
+      mesh_builder_.create_empty_mesh_ptr(domain, mesh_id, element_color)
+    );
+
+    Mesh& new_mesh = *( meshes_.back() );
+    mesh_builder_.add_mesh_and_domain( new_mesh, domain );
+
+    MeshTiling tiling { new_mesh, cell };
+
+    for ( const MeshTransformation& placement : placements )
+      if ( !tiling.add_copy( placement ) )
+        LOG(ERROR) << "MeshGenerator::new_tiled_mesh(): "
+                   << "Skipped an invalid copy of the unit cell.";
+
+    return new_mesh;
+
+  } // MeshGenerator::new_tiled_mesh()
+
+  /*------------------------------------------------------------------
+  | Create a new mesh for a modified <domain>, which reuses the 
+  | elements of a <previous> mesh away from the modified geometry. 
+  | Elements within <band_factor> times the local size function 
+  | around changed boundaries are not transferred. The remaining 
+  | gaps are filled by a subsequent triangulation of the new mesh.
+  | The previous mesh is not considered as a neighbor of the new
+  | mesh and can be removed afterwards.
+  ------------------------------------------------------------------*/
+  Mesh& warm_start_mesh(Domain&          domain,
+                        Mesh&            previous,
+                        double           band_factor = 2.0,
+                        WarmStartReport* report = nullptr)
+  {
+    if ( !mesh_builder_.get_domain( previous ) )
+      TERMINATE("MeshGenerator::warm_start_mesh(): Invalid mesh provided.");
+
+    meshes_.push_back( 
+      mesh_builder_.create_empty_mesh_ptr(domain, previous.id(), 
+                                          previous.element_color())
+    );
+
+    Mesh& new_mesh = *( meshes_.back() );
+
+    MeshBuilder::MeshVector nbr_meshes {};
+    for ( Mesh* m : mesh_builder_.meshes() )
+      if ( m != &previous )
+        nbr_meshes.push_back( m );
+
+    mesh_builder_.prepare_mesh( new_mesh, domain, nbr_meshes );
+    mesh_builder_.add_mesh_and_domain( new_mesh, domain );
+
+    MeshWarmStart warm_start { previous, new_mesh, domain };
+    warm_start.band_factor( band_factor );
+    warm_start.transfer();
+
+    if ( report )
+      *report = warm_start.report();
+
+    return new_mesh;
+
+  } // MeshGenerator::warm_start_mesh()
+
+  /*------------------------------------------------------------------
+  | Remove a mesh from this MeshGenerator
+  ------------------------------------------------------------------*/
+  bool remove_mesh(Mesh& mesh)
+  {
+    auto it = std::find_if(meshes_.begin(), meshes_.end(), 
+      [&mesh](const std::unique_ptr<Mesh>& ptr)
+      { return ptr.get() == &mesh; }
+    );
+
+    if ( it == meshes_.end() )
+      return false;
+
+    if ( !mesh_builder_.remove_mesh_and_domain(mesh) )
+      return false;
+
+    invalidate_strategies( mesh );
+    meshes_.erase( it );
+
+    return true;
+
+  } // MeshGenerator::remove_mesh()
+
   /*------------------------------------------------------------------
   | Merge all defined meshes 
   ------------------------------------------------------------------*/
@@ -134,6 +243,9 @@ public:
       if ( !mesh_builder_.remove_mesh_and_domain(donor) )
         return false;
 
+      invalidate_strategies( receiver );
+      invalidate_strategies( donor );
+
       meshes_.erase( it );
     }
 
@@ -142,32 +254,37 @@ public:
   } // MeshGenerator::merge_meshes()
 
   /*------------------------------------------------------------------
-  | 
+  | Export a mesh. Optional data, i.e. second order elements from 
+  | MeshHighOrder::generate(), element colors from MeshColoring and
+  | median-dual metrics from MeshDual::compute(), can be exported 
+  | along with it through <options>.
   ------------------------------------------------------------------*/
   bool write_mesh(Mesh& mesh, const std::string& filename,
-                  MeshExportType export_type)
+                  MeshExportType export_type,
+                  const MeshExportOptions& options = {})
   {
     Domain* domain = mesh_builder_.get_domain( mesh );
 
     if ( !domain )
       return false;
 
-    MeshWriter writer { mesh, *domain };
+    MeshWriter writer { mesh, *domain, options };
 
     return writer.write(filename, export_type);
-  }
+
+  } // MeshGenerator::write_mesh()
 
   /*------------------------------------------------------------------
   | 
   ------------------------------------------------------------------*/
   QuadLayerStrategy& quad_layer_generation(Mesh& mesh)
   {
-    if ( meshing_algorithm_type_ != MeshingAlgorithm::QuadLayer ||
-         &meshing_algorithm_->mesh() != &mesh )
-      if ( !set_algorithm(mesh, MeshingAlgorithm::QuadLayer) )
-        TERMINATE("MeshGenerator::quad_layer_generation(): Invalid mesh provided.");
+    auto* strategy = get_algorithm(mesh, MeshingAlgorithm::QuadLayer);
 
-    return *dynamic_cast<QuadLayerStrategy*>(meshing_algorithm_.get());
+    if ( !strategy )
+      TERMINATE("MeshGenerator::quad_layer_generation(): Invalid mesh provided.");
+
+    return *dynamic_cast<QuadLayerStrategy*>(strategy);
   }
 
   /*------------------------------------------------------------------
@@ -175,12 +292,12 @@ public:
   ------------------------------------------------------------------*/
   TriangulationStrategy& triangulation(Mesh& mesh)
   {
-    if ( meshing_algorithm_type_ != MeshingAlgorithm::Triangulation ||
-         &meshing_algorithm_->mesh() != &mesh )
-      if ( !set_algorithm(mesh, MeshingAlgorithm::Triangulation) )
-        TERMINATE("MeshGenerator::triangulation(): Invalid mesh provided.");
+    auto* strategy = get_algorithm(mesh, MeshingAlgorithm::Triangulation);
+
+    if ( !strategy )
+      TERMINATE("MeshGenerator::triangulation(): Invalid mesh provided.");
 
-    return *dynamic_cast<TriangulationStrategy*>(meshing_algorithm_.get());
+    return *dynamic_cast<TriangulationStrategy*>(strategy);
   }
 
   /*------------------------------------------------------------------
@@ -188,12 +305,12 @@ public:
   ------------------------------------------------------------------*/
   LaplaceSmoothingStrategy& laplace_smoothing(Mesh& mesh)
   {
-    if ( smoothing_algorithm_type_ != SmoothingAlgorithm::Laplace ||
-         &smoothing_algorithm_->mesh() != &mesh )
-      if ( !set_algorithm(mesh, SmoothingAlgorithm::Laplace) )
-        TERMINATE("MeshGenerator::laplace_smoothing(): Invalid mesh provided.");
+    auto* strategy = get_algorithm(mesh, SmoothingAlgorithm::Laplace);
 
-    return *dynamic_cast<LaplaceSmoothingStrategy*>(smoothing_algorithm_.get());
+    if ( !strategy )
+      TERMINATE("MeshGenerator::laplace_smoothing(): Invalid mesh provided.");
+
+    return *dynamic_cast<LaplaceSmoothingStrategy*>(strategy);
   }
 
   /*------------------------------------------------------------------
@@ -201,12 +318,12 @@ public:
   ------------------------------------------------------------------*/
   TorsionSmoothingStrategy& torsion_smoothing(Mesh& mesh)
   {
-    if ( smoothing_algorithm_type_ != SmoothingAlgorithm::Torsion ||
-         &smoothing_algorithm_->mesh() != &mesh )
-      if ( !set_algorithm(mesh, SmoothingAlgorithm::Torsion) )
-        TERMINATE("MeshGenerator::torsion_smoothing(): Invalid mesh provided.");
+    auto* strategy = get_algorithm(mesh, SmoothingAlgorithm::Torsion);
+
+    if ( !strategy )
+      TERMINATE("MeshGenerator::torsion_smoothing(): Invalid mesh provided.");
 
-    return *dynamic_cast<TorsionSmoothingStrategy*>(smoothing_algorithm_.get());
+    return *dynamic_cast<TorsionSmoothingStrategy*>(strategy);
   }
 
   /*------------------------------------------------------------------
@@ -214,12 +331,12 @@ public:
   ------------------------------------------------------------------*/
   MixedSmoothingStrategy& mixed_smoothing(Mesh& mesh)
   {
-    if ( smoothing_algorithm_type_ != SmoothingAlgorithm::Mixed ||
-         &smoothing_algorithm_->mesh() != &mesh )
-      if ( !set_algorithm(mesh, SmoothingAlgorithm::Mixed) )
-        TERMINATE("MeshGenerator::mixed_smoothing(): Invalid mesh provided.");
+    auto* strategy = get_algorithm(mesh, SmoothingAlgorithm::Mixed);
+
+    if ( !strategy )
+      TERMINATE("MeshGenerator::mixed_smoothing(): Invalid mesh provided.");
 
-    return *dynamic_cast<MixedSmoothingStrategy*>(smoothing_algorithm_.get());
+    return *dynamic_cast<MixedSmoothingStrategy*>(strategy);
   }
 
   /*------------------------------------------------------------------
@@ -227,12 +344,25 @@ public:
   ------------------------------------------------------------------*/
   QuadRefinementStrategy& quad_refinement(Mesh& mesh)
   {
-    if ( refinement_algorithm_type_ != RefinementAlgorithm::Quad ||
-         &refinement_algorithm_->mesh() != &mesh )
-      if ( !set_algorithm(mesh, RefinementAlgorithm::Quad) )
-        TERMINATE("MeshGenerator::quad_refinement(): Invalid mesh provided.");
+    auto* strategy = get_algorithm(mesh, RefinementAlgorithm::Quad);
 
-    return *dynamic_cast<QuadRefinementStrategy*>(refinement_algorithm_.get());
+    if ( !strategy )
+      TERMINATE("MeshGenerator::quad_refinement(): Invalid mesh provided.");
+
+    return *dynamic_cast<QuadRefinementStrategy*>(strategy);
+  }
+
+  /*------------------------------------------------------------------
+  | 
+  ------------------------------------------------------------------*/
+  DelaunayRefinementStrategy& delaunay_refinement(Mesh& mesh)
+  {
+    auto* strategy = get_algorithm(mesh, RefinementAlgorithm::Delaunay);
+
+    if ( !strategy )
+      TERMINATE("MeshGenerator::delaunay_refinement(): Invalid mesh provided.");
+
+    return *dynamic_cast<DelaunayRefinementStrategy*>(strategy);
   }
 
   /*------------------------------------------------------------------
@@ -240,162 +370,262 @@ public:
   ------------------------------------------------------------------*/
   Tri2QuadStrategy& tri2quad_modification(Mesh& mesh)
   {
-    if ( modification_algorithm_type_ != ModificationAlgorithm::Tri2Quad ||
-         &modification_algorithm_->mesh() != &mesh )
-      if ( !set_algorithm(mesh, ModificationAlgorithm::Tri2Quad) )
-        TERMINATE("MeshGenerator::tri2quad_modification(): Invalid mesh provided.");
+    auto* strategy = get_algorithm(mesh, ModificationAlgorithm::Tri2Quad);
+
+    if ( !strategy )
+      TERMINATE("MeshGenerator::tri2quad_modification(): Invalid mesh provided.");
+
+    return *dynamic_cast<Tri2QuadStrategy*>(strategy);
+  }
+
+  /*------------------------------------------------------------------
+  | 
+  ------------------------------------------------------------------*/
+  ValenceStrategy& valence_modification(Mesh& mesh)
+  {
+    auto* strategy = get_algorithm(mesh, ModificationAlgorithm::Valence);
+
+    if ( !strategy )
+      TERMINATE("MeshGenerator::valence_modification(): Invalid mesh provided.");
+
+    return *dynamic_cast<ValenceStrategy*>(strategy);
+  }
+
+
+  /*------------------------------------------------------------------
+  | Get the number of strategies, that are currently kept in the 
+  | workspace of a given mesh
+  ------------------------------------------------------------------*/
+  std::size_t n_strategies(const Mesh& mesh) const
+  {
+    auto it = workspaces_.find( &mesh );
+
+    if ( it == workspaces_.end() )
+      return 0;
 
-    return *dynamic_cast<Tri2QuadStrategy*>(modification_algorithm_.get());
+    const StrategyWorkspace& ws = it->second;
+
+    return ws.meshing.size() + ws.smoothing.size() 
+         + ws.refinement.size() + ws.modification.size();
   }
 
+  /*------------------------------------------------------------------
+  | Release all strategies that have been created for a given mesh.
+  | Subsequent requests for a strategy of this mesh will construct
+  | a new one with default settings.
+  ------------------------------------------------------------------*/
+  void invalidate_strategies(const Mesh& mesh)
+  { workspaces_.erase( &mesh ); }
 
 private:
 
   /*------------------------------------------------------------------
-  | Set a mesh generation algorithm for a specified mesh.
-  | Returns false if the mesh is not connected to this MeshGenerator
-  | or if the algorithm was not found.
+  | All strategies that have been created for a single mesh. Each 
+  | strategy is constructed on its first request and reused 
+  | afterwards, such that its internal buffers persist between 
+  | subsequent calls. Its settings are restored to their defaults
+  | whenever it is handed out again, hence a strategy must be 
+  | configured and run through the same reference.
+  | Workspaces are only created for meshes of this MeshGenerator 
+  | and they are released, as soon as their mesh is removed. 
   ------------------------------------------------------------------*/
-  bool set_algorithm(Mesh& mesh, MeshingAlgorithm algorithm_type)
+  struct StrategyWorkspace
+  {
+    std::map<MeshingAlgorithm, MeshingStrategyPtr>           meshing {};
+    std::map<SmoothingAlgorithm, SmoothingStrategyPtr>       smoothing {};
+    std::map<RefinementAlgorithm, RefinementStrategyPtr>     refinement {};
+    std::map<ModificationAlgorithm, ModificationStrategyPtr> modification {};
+  };
+
+  /*------------------------------------------------------------------
+  | Get the strategy of a specified type from the workspace of a 
+  | given mesh - it is created, if it does not exist yet. Otherwise,
+  | the settings of the stored strategy are reset to their defaults.
+  | Returns a nullptr if the mesh is not connected to this 
+  | MeshGenerator or if the algorithm was not found.
+  ------------------------------------------------------------------*/
+  template <typename Algorithm, typename StrategyPtr>
+  auto get_algorithm(Mesh&                               mesh, 
+                     std::map<Algorithm, StrategyPtr>&   slots,
+                     Algorithm                           algorithm_type)
+  -> typename StrategyPtr::pointer
+  {
+    auto it = slots.find( algorithm_type );
+
+    if ( it != slots.end() )
+    {
+      it->second->reset_settings();
+      return it->second.get();
+    }
+
+    StrategyPtr strategy = create_algorithm(mesh, algorithm_type);
+
+    if ( !strategy )
+      return nullptr;
+
+    auto* strategy_ptr = strategy.get();
+    slots[algorithm_type] = std::move( strategy );
+
+    return strategy_ptr;
+  }
+
+  MeshingStrategy* get_algorithm(Mesh& mesh, MeshingAlgorithm type)
+  {
+    StrategyWorkspace* ws = get_workspace( mesh );
+    return ws ? get_algorithm(mesh, ws->meshing, type) : nullptr;
+  }
+
+  SmoothingStrategy* get_algorithm(Mesh& mesh, SmoothingAlgorithm type)
+  {
+    StrategyWorkspace* ws = get_workspace( mesh );
+    return ws ? get_algorithm(mesh, ws->smoothing, type) : nullptr;
+  }
+
+  RefinementStrategy* get_algorithm(Mesh& mesh, RefinementAlgorithm type)
+  {
+    StrategyWorkspace* ws = get_workspace( mesh );
+    return ws ? get_algorithm(mesh, ws->refinement, type) : nullptr;
+  }
+
+  ModificationStrategy* get_algorithm(Mesh& mesh, ModificationAlgorithm type)
+  {
+    StrategyWorkspace* ws = get_workspace( mesh );
+    return ws ? get_algorithm(mesh, ws->modification, type) : nullptr;
+  }
+
+  /*------------------------------------------------------------------
+  | Get the workspace of a given mesh - it is created, if it does 
+  | not exist yet. Returns a nullptr if the mesh is not connected 
+  | to this MeshGenerator.
+  ------------------------------------------------------------------*/
+  StrategyWorkspace* get_workspace(Mesh& mesh)
+  {
+    auto it = workspaces_.find( &mesh );
+
+    if ( it != workspaces_.end() )
+      return &it->second;
+
+    if ( !mesh_builder_.get_domain( mesh ) )
+      return nullptr;
+
+    return &workspaces_.emplace( &mesh, StrategyWorkspace{} ).first->second;
+  }
+
+  /*------------------------------------------------------------------
+  | Create a mesh generation algorithm for a specified mesh.
+  | Returns a nullptr if the mesh is not connected to this 
+  | MeshGenerator or if the algorithm was not found.
+  ------------------------------------------------------------------*/
+  MeshingStrategyPtr create_algorithm(Mesh& mesh, 
+                                      MeshingAlgorithm algorithm_type)
   {
     Domain* domain = mesh_builder_.get_domain( mesh );
 
     if ( !domain ) 
-      return false;
+      return nullptr;
 
     switch (algorithm_type)
     {
       case MeshingAlgorithm::Triangulation:
-        meshing_algorithm_ 
-          = std::make_unique<TriangulationStrategy>(mesh, *domain);
-        meshing_algorithm_type_ = MeshingAlgorithm::Triangulation;
-        break;
+        return std::make_unique<TriangulationStrategy>(mesh, *domain);
 
       case MeshingAlgorithm::QuadLayer:
-        meshing_algorithm_ 
-          = std::make_unique<QuadLayerStrategy>(mesh, *domain);
-        meshing_algorithm_type_ = MeshingAlgorithm::QuadLayer;
-        break;
+        return std::make_unique<QuadLayerStrategy>(mesh, *domain);
 
       default:
-        meshing_algorithm_type_ = MeshingAlgorithm::None;
+        return nullptr;
     }
-
-    return true;
   }
 
   /*------------------------------------------------------------------
-  | Set a mesh smoothing algorithm for a specified mesh.
-  | Returns false if the mesh is not connected to this MeshGenerator
-  | or if the algorithm was not found.
+  | Create a mesh smoothing algorithm for a specified mesh.
+  | Returns a nullptr if the mesh is not connected to this 
+  | MeshGenerator or if the algorithm was not found.
   ------------------------------------------------------------------*/
-  bool set_algorithm(Mesh& mesh, SmoothingAlgorithm algorithm_type)
+  SmoothingStrategyPtr create_algorithm(Mesh& mesh, 
+                                        SmoothingAlgorithm algorithm_type)
   {
     Domain* domain = mesh_builder_.get_domain( mesh );
 
     if ( !domain ) 
-      return false;
+      return nullptr;
 
     switch (algorithm_type)
     {
       case SmoothingAlgorithm::Laplace:
-        smoothing_algorithm_ 
-          = std::make_unique<LaplaceSmoothingStrategy>(mesh, *domain);
-        smoothing_algorithm_type_ = SmoothingAlgorithm::Laplace;
-        break;
+        return std::make_unique<LaplaceSmoothingStrategy>(mesh, *domain);
 
       case SmoothingAlgorithm::Torsion:
-        smoothing_algorithm_ 
-          = std::make_unique<TorsionSmoothingStrategy>(mesh, *domain);
-        smoothing_algorithm_type_ = SmoothingAlgorithm::Torsion;
-        break;
+        return std::make_unique<TorsionSmoothingStrategy>(mesh, *domain);
 
       case SmoothingAlgorithm::Mixed:
-        smoothing_algorithm_ 
-          = std::make_unique<MixedSmoothingStrategy>(mesh, *domain);
-        smoothing_algorithm_type_ = SmoothingAlgorithm::Mixed;
-        break;
+        return std::make_unique<MixedSmoothingStrategy>(mesh, *domain);
 
       default:
-        smoothing_algorithm_type_ = SmoothingAlgorithm::None;
+        return nullptr;
     }
-
-    return true;
   }
 
   /*------------------------------------------------------------------
-  | Set a mesh refinement algorithm for a specified mesh.
-  | Returns false if the mesh is not connected to this MeshGenerator
-  | or if the algorithm was not found.
+  | Create a mesh refinement algorithm for a specified mesh.
+  | Returns a nullptr if the mesh is not connected to this 
+  | MeshGenerator or if the algorithm was not found.
   ------------------------------------------------------------------*/
-  bool set_algorithm(Mesh& mesh, RefinementAlgorithm algorithm_type)
+  RefinementStrategyPtr create_algorithm(Mesh& mesh, 
+                                         RefinementAlgorithm algorithm_type)
   {
     Domain* domain = mesh_builder_.get_domain( mesh );
 
     if ( !domain ) 
-      return false;
+      return nullptr;
 
     switch (algorithm_type)
     {
       case RefinementAlgorithm::Quad:
-        refinement_algorithm_ 
-          = std::make_unique<QuadRefinementStrategy>(mesh, *domain);
-        refinement_algorithm_type_ = RefinementAlgorithm::Quad;
-        break;
+        return std::make_unique<QuadRefinementStrategy>(mesh, *domain);
+
+      case RefinementAlgorithm::Delaunay:
+        return std::make_unique<DelaunayRefinementStrategy>(mesh, *domain);
 
       default:
-        refinement_algorithm_type_ = RefinementAlgorithm::None;
+        return nullptr;
     }
-
-    return true;
   }
 
   /*------------------------------------------------------------------
-  | Set a mesh modification algorithm for a specified mesh.
-  | Returns false if the mesh is not connected to this MeshGenerator
-  | or if the algorithm was not found.
+  | Create a mesh modification algorithm for a specified mesh.
+  | Returns a nullptr if the mesh is not connected to this 
+  | MeshGenerator or if the algorithm was not found.
   ------------------------------------------------------------------*/
-  bool set_algorithm(Mesh& mesh, ModificationAlgorithm algorithm_type)
+  ModificationStrategyPtr create_algorithm(Mesh& mesh, 
+                                           ModificationAlgorithm algorithm_type)
   {
     Domain* domain = mesh_builder_.get_domain( mesh );
 
     if ( !domain ) 
-      return false;
+      return nullptr;
 
     switch (algorithm_type)
     {
       case ModificationAlgorithm::Tri2Quad:
-        modification_algorithm_ 
-          = std::make_unique<Tri2QuadStrategy>(mesh, *domain);
-        modification_algorithm_type_ = ModificationAlgorithm::Tri2Quad;
-        break;
+        return std::make_unique<Tri2QuadStrategy>(mesh, *domain);
+
+      case ModificationAlgorithm::Valence:
+        return std::make_unique<ValenceStrategy>(mesh, *domain);
 
       default:
-        modification_algorithm_type_ = ModificationAlgorithm::None;
+        return nullptr;
     }
-
-    return true;
   }
 
 
-
   /*------------------------------------------------------------------
   | Attributes
   ------------------------------------------------------------------*/
   MeshVector              meshes_ {};
   MeshBuilder             mesh_builder_ {};
 
-  MeshingStrategyPtr      meshing_algorithm_;
-  MeshingAlgorithm        meshing_algorithm_type_ { MeshingAlgorithm::None };
-
-  SmoothingStrategyPtr    smoothing_algorithm_;
-  SmoothingAlgorithm      smoothing_algorithm_type_ { SmoothingAlgorithm::None };
-
-  RefinementStrategyPtr   refinement_algorithm_;
-  RefinementAlgorithm     refinement_algorithm_type_ { RefinementAlgorithm::None };
-
-  ModificationStrategyPtr modification_algorithm_;
-  ModificationAlgorithm   modification_algorithm_type_ { ModificationAlgorithm::None };
+  std::unordered_map<const Mesh*, StrategyWorkspace> workspaces_ {};
 
 }; // MeshGenerator
 
@@ -0,0 +1,747 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <vector>         // std::vector
+#include <array>          // std::array
+#include <ostream>        // std::ostream
+#include <iomanip>        // std::setw, std::setprecision
+#include <cstdint>        // uint64_t
+#include <cfloat>         // DBL_MAX
+#include <unordered_map>  // std::unordered_map
+#include <unordered_set>  // std::unordered_set
+
+#include "VecND.h"
+#include "Geometry.h"
+
+#include "Domain.h"
+#include "Mesh.h"
+#include "MeshCleanup.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* This class generates the nodes of second order elements for a
+* given linear mesh, i.e. P2 triangles and Q8 / Q9 quads.
+* Every edge of the mesh obtains a node at its midpoint and every
+* quad obtains an additional node at its center for Q9 elements.
+*
+* Boundary vertices, that are located between the vertices of a
+* curved domain boundary edge (see BdryCurve), are moved onto the 
+* curve by default. Vertices of twin edges are kept in place, since 
+* they are shared with neighbor meshes, which would otherwise become
+* non-conforming. Edge nodes on mesh boundary edges are placed on 
+* the curve, if both vertices of the edge are located on the curve.
+* Otherwise they remain at the edge midpoint, such that the 
+* boundary does not bulge between vertices on the straight chords.
+*
+* The validity of every curved element is checked by sampling its
+* Jacobian determinant at its nodes. Elements, whose ratio of the
+* smallest and largest sampled determinant does not exceed a given
+* tolerance, are straightened by moving their boundary edge nodes
+* back to the edge midpoints. Elements that remain invalid are
+* reported.
+*
+* Nodes are numbered after the vertices of the mesh, in the order
+* given by MeshCleanup::assign_mesh_indices(). The node data is
+* invalidated by any further modification of the mesh.
+*********************************************************************/
+class MeshHighOrder
+{
+public:
+  using TriangleNodes = std::array<std::size_t,3>;
+  using QuadNodes     = std::array<std::size_t,5>;
+
+  /*------------------------------------------------------------------
+  | Constructor / Destructor
+  ------------------------------------------------------------------*/
+  MeshHighOrder(Mesh& mesh, const Domain& domain)
+  : mesh_   { &mesh }
+  , domain_ { &domain }
+  {}
+
+  ~MeshHighOrder() {}
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  bool quad_centers() const { return quad_centers_; }
+  bool project_vertices() const { return project_vertices_; }
+  double jacobian_tolerance() const { return jacobian_tol_; }
+  double tolerance() const { return tolerance_; }
+
+  std::size_t n_nodes() const { return nodes_.size(); }
+  std::size_t n_curved_edges() const { return n_curved_edges_; }
+  std::size_t n_moved_vertices() const { return n_moved_verts_; }
+  std::size_t n_straightened_elements() const { return n_straightened_; }
+  std::size_t n_invalid_elements() const { return n_invalid_; }
+  double min_jacobian_ratio() const { return min_jac_ratio_; }
+
+  const std::vector<Vec2d>& nodes() const { return nodes_; }
+  const std::vector<TriangleNodes>& triangle_nodes() const
+  { return tri_nodes_; }
+  const std::vector<QuadNodes>& quad_nodes() const
+  { return quad_nodes_; }
+
+  /*------------------------------------------------------------------
+  | Setters
+  ------------------------------------------------------------------*/
+  MeshHighOrder& quad_centers(bool q)
+  { quad_centers_ = q; return *this; }
+  MeshHighOrder& project_vertices(bool p)
+  { project_vertices_ = p; return *this; }
+  MeshHighOrder& jacobian_tolerance(double t)
+  { jacobian_tol_ = t; return *this; }
+  MeshHighOrder& tolerance(double t)
+  { tolerance_ = t; return *this; }
+
+  /*------------------------------------------------------------------
+  | Check if the node data belongs to the current state of the mesh
+  ------------------------------------------------------------------*/
+  bool matches(const Mesh& mesh) const
+  {
+    return (  &mesh == mesh_
+           && n_vertices_       == mesh.n_vertices()
+           && tri_nodes_.size()  == mesh.n_triangles()
+           && quad_nodes_.size() == mesh.n_quads()
+           && ( tri_nodes_.size() + quad_nodes_.size() ) > 0 );
+  }
+
+  /*------------------------------------------------------------------
+  | Generate the high order nodes. Returns false, if any curved
+  | element is invalid.
+  ------------------------------------------------------------------*/
+  bool generate()
+  {
+    clear();
+
+    MeshCleanup::assign_mesh_indices( *mesh_ );
+
+    n_vertices_ = mesh_->n_vertices();
+
+    locate_boundary_edges();
+
+    if ( project_vertices_ )
+      move_boundary_vertices();
+
+    for ( const auto& q_ptr : mesh_->quads() )
+    {
+      QuadNodes nodes {};
+
+      for ( std::size_t i = 0; i < 4; ++i )
+        nodes[i] = edge_node( q_ptr->vertex(i), q_ptr->vertex((i+1)%4) );
+
+      nodes[4] = nodes_.size();
+
+      if ( quad_centers_ )
+        nodes_.push_back( quad_center( *q_ptr, nodes ) );
+
+      quad_nodes_.push_back( nodes );
+    }
+
+    for ( const auto& t_ptr : mesh_->triangles() )
+    {
+      TriangleNodes nodes {};
+
+      for ( std::size_t i = 0; i < 3; ++i )
+        nodes[i] = edge_node( t_ptr->vertex(i), t_ptr->vertex((i+1)%3) );
+
+      tri_nodes_.push_back( nodes );
+    }
+
+    check_elements();
+
+    edge_nodes_.clear();
+    bdry_locations_.clear();
+
+    if ( n_invalid_ > 0 )
+    {
+      LOG(WARNING) << "MeshHighOrder::generate(): " << n_invalid_
+                   << " curved elements are invalid.";
+      return false;
+    }
+
+    return true;
+
+  } // MeshHighOrder::generate()
+
+  /*------------------------------------------------------------------
+  | The area enclosed by the curved elements
+  ------------------------------------------------------------------*/
+  double area() const
+  {
+    double a = 0.0;
+    std::size_t i = 0;
+
+    for ( const auto& q_ptr : mesh_->quads() )
+    {
+      const auto x = quad_coordinates( *q_ptr, quad_nodes_[i++] );
+
+      for ( std::size_t j = 0; j < 3; ++j )
+        for ( std::size_t k = 0; k < 3; ++k )
+          a += GAUSS_W[j] * GAUSS_W[k]
+             * quad_jacobian( x, GAUSS_XI[j], GAUSS_XI[k] );
+    }
+
+    i = 0;
+
+    for ( const auto& t_ptr : mesh_->triangles() )
+    {
+      const auto x = triangle_coordinates( *t_ptr, tri_nodes_[i++] );
+
+      // Three point rule - exact for the quadratic determinant
+      a += ( triangle_jacobian( x, 1.0/6.0, 1.0/6.0 )
+           + triangle_jacobian( x, 2.0/3.0, 1.0/6.0 )
+           + triangle_jacobian( x, 1.0/6.0, 2.0/3.0 ) ) / 6.0;
+    }
+
+    return a;
+
+  } // MeshHighOrder::area()
+
+  /*------------------------------------------------------------------
+  | Write the high order nodes and elements in terms of the global
+  | node indices. The corner vertices of all elements are followed
+  | by the nodes of the edges (v1,v2), (v2,v3), ... and the center
+  | node of Q9 quads.
+  ------------------------------------------------------------------*/
+  void write(std::ostream& os) const
+  {
+    os << "HIGHORDERNODES " << nodes_.size() << "\n";
+    for ( const Vec2d& xy : nodes_ )
+      os << std::setprecision(5) << std::fixed
+         << xy.x << "," << xy.y << "\n";
+
+    const std::size_t n_quad_nodes = quad_centers_ ? 5 : 4;
+
+    os << ( quad_centers_ ? "Q9QUADS " : "Q8QUADS " )
+       << quad_nodes_.size() << "\n";
+
+    std::size_t i = 0;
+
+    for ( const auto& q_ptr : mesh_->quads() )
+    {
+      os << std::setprecision(0) << std::fixed;
+
+      for ( std::size_t j = 0; j < 4; ++j )
+        os << std::setw(4) << q_ptr->vertex(j).index() << ",";
+      for ( std::size_t j = 0; j < n_quad_nodes; ++j )
+        os << std::setw(4) << node_index( quad_nodes_[i][j] ) << ",";
+
+      os << std::setw(4) << q_ptr->color() << "\n";
+      ++i;
+    }
+
+    os << "P2TRIANGLES " << tri_nodes_.size() << "\n";
+
+    i = 0;
+
+    for ( const auto& t_ptr : mesh_->triangles() )
+    {
+      os << std::setprecision(0) << std::fixed;
+
+      for ( std::size_t j = 0; j < 3; ++j )
+        os << std::setw(4) << t_ptr->vertex(j).index() << ",";
+      for ( std::size_t j = 0; j < 3; ++j )
+        os << std::setw(4) << node_index( tri_nodes_[i][j] ) << ",";
+
+      os << std::setw(4) << t_ptr->color() << "\n";
+      ++i;
+    }
+
+  } // MeshHighOrder::write()
+
+  /*------------------------------------------------------------------
+  | The global index of a high order node
+  ------------------------------------------------------------------*/
+  std::size_t node_index(std::size_t i) const { return n_vertices_ + i; }
+
+private:
+
+  /*------------------------------------------------------------------
+  | The location of a mesh boundary edge on a domain boundary edge
+  | in terms of the parametric coordinates of its vertices
+  ------------------------------------------------------------------*/
+  struct BoundaryLocation
+  {
+    const Boundary* boundary { nullptr };
+    const Edge*     edge     { nullptr };
+    double          t1       { 0.0 };
+    double          t2       { 0.0 };
+  };
+
+  /*------------------------------------------------------------------
+  | Remove all node data
+  ------------------------------------------------------------------*/
+  void clear()
+  {
+    nodes_.clear();
+    tri_nodes_.clear();
+    quad_nodes_.clear();
+    edge_nodes_.clear();
+    bdry_locations_.clear();
+
+    n_vertices_     = 0;
+    n_curved_edges_ = 0;
+    n_moved_verts_  = 0;
+    n_straightened_ = 0;
+    n_invalid_      = 0;
+    min_jac_ratio_  = DBL_MAX;
+
+  } // MeshHighOrder::clear()
+
+  /*------------------------------------------------------------------
+  | Locate all mesh boundary edges on curved domain boundary edges
+  ------------------------------------------------------------------*/
+  void locate_boundary_edges()
+  {
+    double max_length = 0.0;
+
+    for ( const auto& boundary : *domain_ )
+      if ( boundary->curve() != BdryCurve::POLYGON )
+        for ( const auto& e_ptr : *boundary )
+          max_length = MAX( max_length, e_ptr->length() );
+
+    if ( max_length <= 0.0 )
+      return;
+
+    for ( const auto& e_ptr : mesh_->boundary_edges() )
+    {
+      const Vec2d& p = e_ptr->v1().xy();
+      const Vec2d& q = e_ptr->v2().xy();
+      const double r = 0.5 * max_length + e_ptr->length();
+
+      for ( const auto& boundary : *domain_ )
+      {
+        if ( boundary->curve() == BdryCurve::POLYGON )
+          continue;
+
+        for ( Edge* e : boundary->get_edges( e_ptr->xy(), r ) )
+        {
+          BoundaryLocation loc {};
+          loc.boundary = boundary.get();
+          loc.edge     = e;
+
+          if (  !curve_parameter( loc, p, loc.t1 ) 
+             || !curve_parameter( loc, q, loc.t2 ) )
+            continue;
+
+          bdry_locations_[ e_ptr.get() ] = loc;
+          break;
+        }
+
+        if ( bdry_locations_.count( e_ptr.get() ) > 0 )
+          break;
+      }
+    }
+
+  } // MeshHighOrder::locate_boundary_edges()
+
+  /*------------------------------------------------------------------
+  | Get the parameter of a location on a domain boundary edge, i.e.
+  | the location is either placed on the edge or on its curve. 
+  | The latter applies to boundary vertices, that have already been
+  | moved onto the curve.
+  ------------------------------------------------------------------*/
+  bool curve_parameter(const BoundaryLocation& loc, const Vec2d& xy,
+                       double& t) const
+  {
+    const Vec2d& a = loc.edge->v1().xy();
+    const Vec2d  d = loc.edge->v2().xy() - a;
+    const double tol = tolerance_ * loc.edge->length();
+
+    t = MAX( 0.0, MIN( 1.0, dot(xy - a, d) / d.norm_sqr() ) );
+
+    if ( ( a + t * d - xy ).norm_sqr() <= tol * tol )
+      return true;
+
+    // Gauss-Newton iterations for the closest point on the curve
+    const double h = 1.0E-6;
+
+    for ( std::size_t i = 0; i < 20; ++i )
+    {
+      const Vec2d k  = loc.boundary->curve_point( *loc.edge, t );
+      const Vec2d dk = ( loc.boundary->curve_point( *loc.edge, t + h )
+                       - loc.boundary->curve_point( *loc.edge, t - h ) )
+                     / ( 2.0 * h );
+
+      const double dt = dot( xy - k, dk ) / dk.norm_sqr();
+      t = MAX( 0.0, MIN( 1.0, t + dt ) );
+
+      if ( ABS(dt) < 1.0E-12 )
+        break;
+    }
+
+    const Vec2d k = loc.boundary->curve_point( *loc.edge, t );
+
+    return ( ( k - xy ).norm_sqr() <= tol * tol );
+
+  } // MeshHighOrder::curve_parameter()
+
+  /*------------------------------------------------------------------
+  | Move boundary vertices onto the curves of their domain boundary
+  | edges. Vertices of the domain boundary are already located on
+  | the curves. Vertices of twin edges are kept in place.
+  ------------------------------------------------------------------*/
+  void move_boundary_vertices()
+  {
+    std::unordered_set<const Vertex*> twin_vertices {};
+
+    for ( const auto& e_ptr : mesh_->boundary_edges() )
+      if ( e_ptr->twin_edge() )
+      {
+        twin_vertices.insert( &e_ptr->v1() );
+        twin_vertices.insert( &e_ptr->v2() );
+      }
+
+    std::vector<std::pair<Vertex*,Vec2d>> moves {};
+
+    for ( const auto& iter : bdry_locations_ )
+    {
+      Edge* e = iter.first;
+      const BoundaryLocation& loc = iter.second;
+
+      Vertex* v = &e->v1();
+      const double t = loc.t1;
+
+      if ( twin_vertices.count( v ) > 0 )
+        continue;
+
+      const Vec2d xy = loc.boundary->curve_point( *loc.edge, t );
+      const double tol = tolerance_ * loc.edge->length();
+
+      if ( t <= 0.0 || t >= 1.0 || ( v->xy() - xy ).norm_sqr() <= tol*tol )
+        continue;
+
+      moves.push_back( { v, xy } );
+    }
+
+    for ( const auto& m : moves )
+    {
+      MeshCleanup::set_vertex_coordinates( *m.first, m.second );
+      ++n_moved_verts_;
+    }
+
+  } // MeshHighOrder::move_boundary_vertices()
+
+  /*------------------------------------------------------------------
+  | Get the node of the edge (v1,v2) - nodes are created upon their
+  | first request. Boundary edge nodes are only placed on the curve, 
+  | if both edge vertices are located on it.
+  ------------------------------------------------------------------*/
+  std::size_t edge_node(const Vertex& v1, const Vertex& v2)
+  {
+    const uint64_t i1 = MIN( v1.index(), v2.index() );
+    const uint64_t i2 = MAX( v1.index(), v2.index() );
+    const uint64_t key = i1 * static_cast<uint64_t>(n_vertices_) + i2;
+
+    auto iter = edge_nodes_.find( key );
+    if ( iter != edge_nodes_.end() )
+      return iter->second;
+
+    const std::size_t i = nodes_.size();
+    Vec2d xy = 0.5 * ( v1.xy() + v2.xy() );
+
+    Edge* e = mesh_->get_boundary_edge( v1, v2 );
+
+    if ( e && bdry_locations_.count( e ) > 0 )
+    {
+      const BoundaryLocation& loc = bdry_locations_[ e ];
+
+      if (  on_curve( loc, e->v1().xy(), loc.t1 ) 
+         && on_curve( loc, e->v2().xy(), loc.t2 ) )
+      {
+        xy = loc.boundary->curve_point( *loc.edge, 
+                                        0.5 * (loc.t1 + loc.t2) );
+        curved_nodes_.push_back( i );
+        ++n_curved_edges_;
+      }
+    }
+
+    nodes_.push_back( xy );
+    edge_nodes_[key] = i;
+
+    return i;
+
+  } // MeshHighOrder::edge_node()
+
+  /*------------------------------------------------------------------
+  | Check if a location coincides with the curve point at the 
+  | parameter <t> of a domain boundary edge
+  ------------------------------------------------------------------*/
+  bool on_curve(const BoundaryLocation& loc, const Vec2d& xy, 
+                double t) const
+  {
+    const double tol = tolerance_ * loc.edge->length();
+    const Vec2d  k   = loc.boundary->curve_point( *loc.edge, t );
+
+    return ( ( k - xy ).norm_sqr() <= tol * tol );
+
+  } // MeshHighOrder::on_curve()
+
+  /*------------------------------------------------------------------
+  | The center node of a Q9 quad, such that the Q9 element spans
+  | the same geometry as the Q8 element
+  ------------------------------------------------------------------*/
+  Vec2d quad_center(const Quad& q, const QuadNodes& nodes) const
+  {
+    Vec2d xy { 0.0, 0.0 };
+
+    for ( std::size_t i = 0; i < 4; ++i )
+      xy += 0.5 * nodes_[ nodes[i] ] - 0.25 * q.vertex(i).xy();
+
+    return xy;
+  }
+
+  /*------------------------------------------------------------------
+  | Check the validity of all elements and straighten invalid
+  | curved elements
+  ------------------------------------------------------------------*/
+  void check_elements()
+  {
+    std::vector<bool> is_curved ( nodes_.size(), false );
+    for ( std::size_t i : curved_nodes_ )
+      is_curved[i] = true;
+
+    std::size_t i = 0;
+
+    for ( const auto& q_ptr : mesh_->quads() )
+    {
+      QuadNodes& nodes = quad_nodes_[i++];
+      double ratio = quad_jacobian_ratio( *q_ptr, nodes );
+
+      if ( ratio <= jacobian_tol_ &&
+           straighten( *q_ptr, nodes.data(), 4, is_curved ) )
+      {
+        if ( quad_centers_ )
+          nodes_[ nodes[4] ] = quad_center( *q_ptr, nodes );
+
+        ratio = quad_jacobian_ratio( *q_ptr, nodes );
+      }
+
+      update_statistics( ratio );
+    }
+
+    i = 0;
+
+    for ( const auto& t_ptr : mesh_->triangles() )
+    {
+      TriangleNodes& nodes = tri_nodes_[i++];
+      double ratio = triangle_jacobian_ratio( *t_ptr, nodes );
+
+      if ( ratio <= jacobian_tol_ &&
+           straighten( *t_ptr, nodes.data(), 3, is_curved ) )
+        ratio = triangle_jacobian_ratio( *t_ptr, nodes );
+
+      update_statistics( ratio );
+    }
+
+    curved_nodes_.clear();
+
+  } // MeshHighOrder::check_elements()
+
+  /*------------------------------------------------------------------
+  | Move the curved edge nodes of an element back to the midpoints
+  | of its edges. Returns false, if the element is not curved.
+  ------------------------------------------------------------------*/
+  bool straighten(const Facet& f, std::size_t* nodes, std::size_t n,
+                  std::vector<bool>& is_curved)
+  {
+    bool straightened = false;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+      if ( !is_curved[ nodes[i] ] )
+        continue;
+
+      nodes_[ nodes[i] ] = 0.5 * ( f.vertex(i).xy()
+                                 + f.vertex((i+1)%n).xy() );
+      is_curved[ nodes[i] ] = false;
+
+      --n_curved_edges_;
+      straightened = true;
+    }
+
+    if ( straightened )
+      ++n_straightened_;
+
+    return straightened;
+
+  } // MeshHighOrder::straighten()
+
+  /*------------------------------------------------------------------
+  | Update the validity statistics of a checked element
+  ------------------------------------------------------------------*/
+  void update_statistics(double ratio)
+  {
+    min_jac_ratio_ = MIN( min_jac_ratio_, ratio );
+
+    if ( ratio <= jacobian_tol_ )
+      ++n_invalid_;
+  }
+
+  /*------------------------------------------------------------------
+  | The node coordinates of a P2 triangle in the order of the
+  | corners, followed by the edge nodes
+  ------------------------------------------------------------------*/
+  std::array<Vec2d,6> triangle_coordinates(const Triangle& t,
+                                           const TriangleNodes& n) const
+  {
+    return { t.v1().xy(), t.v2().xy(), t.v3().xy(),
+             nodes_[n[0]], nodes_[n[1]], nodes_[n[2]] };
+  }
+
+  /*------------------------------------------------------------------
+  | The node coordinates of a quad on the 3x3 lattice of the
+  | reference element, stored as x[i + 3*j]
+  ------------------------------------------------------------------*/
+  std::array<Vec2d,9> quad_coordinates(const Quad& q,
+                                       const QuadNodes& n) const
+  {
+    const Vec2d xc = quad_centers_ ? nodes_[n[4]] : quad_center(q, n);
+
+    return { q.v1().xy(), nodes_[n[0]], q.v2().xy(),
+             nodes_[n[3]], xc,          nodes_[n[1]],
+             q.v4().xy(), nodes_[n[2]], q.v3().xy() };
+  }
+
+  /*------------------------------------------------------------------
+  | The Jacobian determinant of a P2 triangle at the barycentric
+  | location (r,s)
+  ------------------------------------------------------------------*/
+  static inline double triangle_jacobian(const std::array<Vec2d,6>& x,
+                                         double r, double s)
+  {
+    const double l = 1.0 - r - s;
+
+    const Vec2d x_r = -(4.0*l - 1.0) * x[0] + (4.0*r - 1.0) * x[1]
+                    + 4.0*(l - r) * x[3] + 4.0*s * x[4] - 4.0*s * x[5];
+
+    const Vec2d x_s = -(4.0*l - 1.0) * x[0] + (4.0*s - 1.0) * x[2]
+                    - 4.0*r * x[3] + 4.0*r * x[4] + 4.0*(l - s) * x[5];
+
+    return cross( x_r, x_s );
+
+  } // MeshHighOrder::triangle_jacobian()
+
+  /*------------------------------------------------------------------
+  | The Jacobian determinant of a Q9 quad at the reference location
+  | (xi,eta), with -1 <= xi,eta <= 1
+  ------------------------------------------------------------------*/
+  static inline double quad_jacobian(const std::array<Vec2d,9>& x,
+                                     double xi, double eta)
+  {
+    const std::array<double,3> L_xi  { 0.5*xi*(xi-1.0), 1.0-xi*xi,
+                                       0.5*xi*(xi+1.0) };
+    const std::array<double,3> L_eta { 0.5*eta*(eta-1.0), 1.0-eta*eta,
+                                       0.5*eta*(eta+1.0) };
+    const std::array<double,3> dL_xi  { xi-0.5, -2.0*xi, xi+0.5 };
+    const std::array<double,3> dL_eta { eta-0.5, -2.0*eta, eta+0.5 };
+
+    Vec2d x_xi  { 0.0, 0.0 };
+    Vec2d x_eta { 0.0, 0.0 };
+
+    for ( std::size_t j = 0; j < 3; ++j )
+      for ( std::size_t i = 0; i < 3; ++i )
+      {
+        x_xi  += dL_xi[i] * L_eta[j] * x[i + 3*j];
+        x_eta += L_xi[i] * dL_eta[j] * x[i + 3*j];
+      }
+
+    return cross( x_xi, x_eta );
+
+  } // MeshHighOrder::quad_jacobian()
+
+  /*------------------------------------------------------------------
+  | The ratio of the smallest and the largest Jacobian determinant,
+  | sampled at the nodes and the centroid of a P2 triangle
+  ------------------------------------------------------------------*/
+  double triangle_jacobian_ratio(const Triangle& t,
+                                 const TriangleNodes& n) const
+  {
+    const auto x = triangle_coordinates( t, n );
+
+    static constexpr std::array<double,7> R { 0.0, 1.0, 0.0, 0.5,
+                                              0.5, 0.0, 1.0/3.0 };
+    static constexpr std::array<double,7> S { 0.0, 0.0, 1.0, 0.0,
+                                              0.5, 0.5, 1.0/3.0 };
+
+    double j_min = DBL_MAX;
+    double j_max = -DBL_MAX;
+
+    for ( std::size_t i = 0; i < R.size(); ++i )
+    {
+      const double j = triangle_jacobian( x, R[i], S[i] );
+      j_min = MIN( j_min, j );
+      j_max = MAX( j_max, j );
+    }
+
+    return ( j_max > 0.0 ) ? j_min / j_max : -1.0;
+
+  } // MeshHighOrder::triangle_jacobian_ratio()
+
+  /*------------------------------------------------------------------
+  | The ratio of the smallest and the largest Jacobian determinant,
+  | sampled at the nodes of a Q9 quad
+  ------------------------------------------------------------------*/
+  double quad_jacobian_ratio(const Quad& q, const QuadNodes& n) const
+  {
+    const auto x = quad_coordinates( q, n );
+
+    double j_min = DBL_MAX;
+    double j_max = -DBL_MAX;
+
+    for ( double eta : { -1.0, 0.0, 1.0 } )
+      for ( double xi : { -1.0, 0.0, 1.0 } )
+      {
+        const double j = quad_jacobian( x, xi, eta );
+        j_min = MIN( j_min, j );
+        j_max = MAX( j_max, j );
+      }
+
+    return ( j_max > 0.0 ) ? j_min / j_max : -1.0;
+
+  } // MeshHighOrder::quad_jacobian_ratio()
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  static constexpr std::array<double,3> GAUSS_XI
+  { -0.774596669241483, 0.0, 0.774596669241483 };
+  static constexpr std::array<double,3> GAUSS_W
+  { 5.0/9.0, 8.0/9.0, 5.0/9.0 };
+
+  Mesh*                                      mesh_;
+  const Domain*                              domain_;
+
+  std::vector<Vec2d>                         nodes_          {};
+  std::vector<TriangleNodes>                 tri_nodes_      {};
+  std::vector<QuadNodes>                     quad_nodes_     {};
+  std::unordered_map<uint64_t,std::size_t>   edge_nodes_     {};
+  std::unordered_map<Edge*,BoundaryLocation> bdry_locations_ {};
+  std::vector<std::size_t>                   curved_nodes_   {};
+
+  bool                                       quad_centers_     { true };
+  bool                                       project_vertices_ { true };
+  double                                     jacobian_tol_     { 0.0 };
+  double                                     tolerance_        { 1.0E-6 };
+
+  std::size_t                                n_vertices_     { 0 };
+  std::size_t                                n_curved_edges_ { 0 };
+  std::size_t                                n_moved_verts_  { 0 };
+  std::size_t                                n_straightened_ { 0 };
+  std::size_t                                n_invalid_      { 0 };
+  double                                     min_jac_ratio_  { DBL_MAX };
+
+}; // MeshHighOrder
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
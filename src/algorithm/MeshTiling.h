@@ -0,0 +1,573 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cfloat>
+#include <unordered_set>
+
+#include "VecND.h"
+#include "Geometry.h"
+
+#include "Mesh.h"
+#include "MeshCleanup.h"
+#include "MeshTransformation.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* This class replicates a meshed unit cell into a receiver mesh.
+* The cell is read once into a compact, index based copy, which is
+* then transformed and inserted for every requested placement.
+*
+* Boundary vertices of a new copy, that coincide with boundary
+* vertices of the receiver, are not duplicated. Boundary edges
+* that coincide with a receiver boundary edge of opposite direction
+* are turned into interior edges. 
+* Copies are rejected, if they overlap the receiver or if their
+* boundary discretization does not match the one of the receiver 
+* at shared interfaces. Thus, only conforming meshes are obtained.
+* The receiver must not be modified by other means while copies
+* are added.
+*********************************************************************/
+class MeshTiling
+{
+public:
+  using VertexVector   = std::vector<Vertex*>;
+  using EdgeVector     = std::vector<Edge*>;
+  using IndexVector    = std::vector<std::size_t>;
+
+  /*------------------------------------------------------------------
+  | Constructor / Destructor
+  ------------------------------------------------------------------*/
+  MeshTiling(Mesh& receiver, Mesh& cell)
+  : receiver_ { &receiver }
+  { 
+    init_cell( cell ); 
+    init_receiver();
+  }
+
+  ~MeshTiling() {}
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  std::size_t n_copies() const { return n_copies_; }
+  std::size_t n_stitched_vertices() const { return n_stitched_verts_; }
+  std::size_t n_stitched_edges() const { return n_stitched_edges_; }
+  double tolerance() const { return tolerance_; }
+
+  /*------------------------------------------------------------------
+  | Setters - the stitching tolerance is relative to the shortest
+  | boundary edge of the cell
+  ------------------------------------------------------------------*/
+  void tolerance(double t) { tolerance_ = t; }
+
+  /*------------------------------------------------------------------
+  | Insert a transformed copy of the cell into the receiver mesh.
+  | Returns false - without modifying the receiver - if the copy
+  | overlaps the receiver or if it does not match the receiver's
+  | boundary vertices at a shared interface.
+  ------------------------------------------------------------------*/
+  bool add_copy(const MeshTransformation& trafo)
+  {
+    const bool flip = trafo.reverses_orientation();
+    const double tol = tolerance_ * min_edge_length_;
+
+    // Locate receiver boundary vertices, that coincide with
+    // transformed cell boundary vertices
+    new_vertices_.assign( xy_.size(), nullptr );
+
+    for ( std::size_t i : bdry_vertices_ )
+    {
+      const Vec2d xy = trafo( xy_[i] );
+
+      for ( Vertex* v : receiver_->get_vertices(xy, tol) )
+      {
+        if ( !v->on_boundary() )
+          continue;
+
+        new_vertices_[i] = v;
+        break;
+      }
+    }
+
+    // Coordinates of the copy - stitched vertices keep the 
+    // coordinates of the receiver
+    copy_xy_.resize( xy_.size() );
+
+    for ( std::size_t i = 0; i < xy_.size(); ++i )
+      copy_xy_[i] = new_vertices_[i] ? new_vertices_[i]->xy() 
+                                     : trafo( xy_[i] );
+
+    // Locate the receiver boundary edges, that become interior edges.
+    // A coincident edge of the same direction is an overlap.
+    interface_edges_.assign( bdry_edges_.size(), nullptr );
+
+    for ( std::size_t i = 0; i < bdry_edges_.size(); ++i )
+    {
+      Vertex* v1 = new_vertices_[ bdry_edges_[i][0] ];
+      Vertex* v2 = new_vertices_[ bdry_edges_[i][1] ];
+
+      if ( !v1 || !v2 )
+        continue;
+
+      if ( flip )
+        std::swap( v1, v2 );
+
+      EdgeList& bdry_edges = receiver_->boundary_edges();
+
+      if ( bdry_edges.get_edge( *v1, *v2, true ) )
+      {
+        LOG(ERROR) << "MeshTiling::add_copy(): The transformed cell "
+                   << "overlaps the receiver mesh.";
+        return false;
+      }
+
+      interface_edges_[i] = bdry_edges.get_edge( *v2, *v1, true );
+    }
+
+    if ( !matches_interfaces( tol ) )
+    {
+      LOG(ERROR) << "MeshTiling::add_copy(): The boundary vertices of "
+                 << "the transformed cell do not match the receiver mesh.";
+      return false;
+    }
+
+    if ( overlaps_receiver( flip ) )
+    {
+      LOG(ERROR) << "MeshTiling::add_copy(): The transformed cell "
+                 << "overlaps the receiver mesh.";
+      return false;
+    }
+
+    // Copy all remaining vertices
+    stitched_vertices_.clear();
+
+    for ( std::size_t i = 0; i < xy_.size(); ++i )
+    {
+      if ( new_vertices_[i] )
+      {
+        stitched_vertices_.push_back( new_vertices_[i] );
+        continue;
+      }
+
+      Vertex& v_new = receiver_->add_vertex( trafo( xy_[i] ) );
+      v_new.add_property( properties_[i] );
+      new_vertices_[i] = &v_new;
+    }
+
+    // Copy elements - mirrored copies are reordered, in order to
+    // preserve the counter-clockwise orientation
+    for ( std::size_t i = 0; i < quads_.size(); ++i )
+    {
+      const auto& q = quads_[i];
+      if ( flip )
+        receiver_->add_quad( vertex(q[0]), vertex(q[3]), vertex(q[2]),
+                             vertex(q[1]), quad_colors_[i] );
+      else
+        receiver_->add_quad( vertex(q[0]), vertex(q[1]), vertex(q[2]),
+                             vertex(q[3]), quad_colors_[i] );
+    }
+
+    for ( std::size_t i = 0; i < tris_.size(); ++i )
+    {
+      const auto& t = tris_[i];
+      if ( flip )
+        receiver_->add_triangle( vertex(t[0]), vertex(t[2]), vertex(t[1]),
+                                 tri_colors_[i] );
+      else
+        receiver_->add_triangle( vertex(t[0]), vertex(t[1]), vertex(t[2]),
+                                 tri_colors_[i] );
+    }
+
+    for ( const auto& e : intr_edges_ )
+      receiver_->add_interior_edge( vertex(e[0]), vertex(e[1]) );
+
+    // Copy boundary edges or stitch them to the receiver
+    for ( std::size_t i = 0; i < bdry_edges_.size(); ++i )
+    {
+      Vertex& v1 = vertex( bdry_edges_[i][0] );
+      Vertex& v2 = vertex( bdry_edges_[i][1] );
+
+      if ( interface_edges_[i] )
+      {
+        receiver_->remove_boundary_edge( *interface_edges_[i] );
+        receiver_->add_interior_edge( v1, v2 );
+        ++n_stitched_edges_;
+      }
+      else if ( flip )
+        receiver_->add_boundary_edge( v2, v1, bdry_markers_[i] );
+      else
+        receiver_->add_boundary_edge( v1, v2, bdry_markers_[i] );
+    }
+
+    receiver_->add_area( cell_area_ );
+
+    // Update the receiver extent for subsequent overlap checks
+    bbox_lowleft_.x = MIN( bbox_lowleft_.x, copy_lowleft_.x );
+    bbox_lowleft_.y = MIN( bbox_lowleft_.y, copy_lowleft_.y );
+    bbox_upright_.x = MAX( bbox_upright_.x, copy_upright_.x );
+    bbox_upright_.y = MAX( bbox_upright_.y, copy_upright_.y );
+    max_edge_length_ = MAX( max_edge_length_, copy_max_edge_length_ );
+
+    update_boundary_properties();
+
+    ++n_copies_;
+
+    return true;
+
+  } // MeshTiling::add_copy()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Store the cell's entities in terms of vertex indices
+  ------------------------------------------------------------------*/
+  void init_cell(Mesh& cell)
+  {
+    MeshCleanup::assign_mesh_indices( cell );
+
+    for ( const auto& v_ptr : cell.vertices() )
+    {
+      xy_.push_back( v_ptr->xy() );
+      properties_.push_back( v_ptr->properties() );
+
+      if ( v_ptr->on_boundary() )
+        bdry_vertices_.push_back( v_ptr->index() );
+    }
+
+    for ( const auto& q_ptr : cell.quads() )
+    {
+      quads_.push_back( { q_ptr->v1().index(), q_ptr->v2().index(),
+                          q_ptr->v3().index(), q_ptr->v4().index() } );
+      quad_colors_.push_back( q_ptr->color() );
+    }
+
+    for ( const auto& t_ptr : cell.triangles() )
+    {
+      tris_.push_back( { t_ptr->v1().index(), t_ptr->v2().index(),
+                         t_ptr->v3().index() } );
+      tri_colors_.push_back( t_ptr->color() );
+    }
+
+    for ( const auto& e_ptr : cell.interior_edges() )
+      intr_edges_.push_back( { e_ptr->v1().index(), e_ptr->v2().index() } );
+
+    min_edge_length_ = DBL_MAX;
+
+    for ( const auto& e_ptr : cell.boundary_edges() )
+    {
+      bdry_edges_.push_back( { e_ptr->v1().index(), e_ptr->v2().index() } );
+      bdry_markers_.push_back( e_ptr->marker() );
+      min_edge_length_ = MIN( min_edge_length_, e_ptr->length() );
+    }
+
+    cell_area_ = 0.0;
+
+    for ( const auto& q_ptr : cell.quads() )
+      cell_area_ += q_ptr->area();
+    for ( const auto& t_ptr : cell.triangles() )
+      cell_area_ += t_ptr->area();
+
+  } // MeshTiling::init_cell()
+
+  /*------------------------------------------------------------------
+  | Store the extent and the longest edge of the receiver, which are
+  | used to limit the search radii of the overlap checks
+  ------------------------------------------------------------------*/
+  void init_receiver()
+  {
+    bbox_lowleft_ = {  DBL_MAX,  DBL_MAX };
+    bbox_upright_ = { -DBL_MAX, -DBL_MAX };
+
+    for ( const auto& v_ptr : receiver_->vertices() )
+    {
+      const Vec2d& xy = v_ptr->xy();
+      bbox_lowleft_.x = MIN( bbox_lowleft_.x, xy.x );
+      bbox_lowleft_.y = MIN( bbox_lowleft_.y, xy.y );
+      bbox_upright_.x = MAX( bbox_upright_.x, xy.x );
+      bbox_upright_.y = MAX( bbox_upright_.y, xy.y );
+    }
+
+    max_edge_length_ = 0.0;
+
+    for ( const auto& e_ptr : receiver_->boundary_edges() )
+      max_edge_length_ = MAX( max_edge_length_, e_ptr->length() );
+    for ( const auto& e_ptr : receiver_->interior_edges() )
+      max_edge_length_ = MAX( max_edge_length_, e_ptr->length() );
+
+  } // MeshTiling::init_receiver()
+
+  /*------------------------------------------------------------------
+  | Check that no boundary vertex of the copy lies on a receiver 
+  | boundary edge and vice versa, unless both are stitched. 
+  | Such vertices would lead to hanging nodes at the interface.
+  ------------------------------------------------------------------*/
+  bool matches_interfaces(double tol) const
+  {
+    const double tol_sqr = tol * tol;
+
+    for ( std::size_t i : bdry_vertices_ )
+    {
+      if ( new_vertices_[i] )
+        continue;
+
+      const Vec2d& xy = copy_xy_[i];
+      const double r = 0.5 * max_edge_length_ + tol;
+
+      for ( const Edge* e : receiver_->get_bdry_edges(xy, r) )
+        if ( distance_point_edge_sqr( xy, e->v1().xy(), 
+                                      e->v2().xy() ) < tol_sqr )
+          return false;
+    }
+
+    std::unordered_set<const Vertex*> stitched {};
+
+    for ( const Vertex* v : new_vertices_ )
+      if ( v ) stitched.insert( v );
+
+    for ( const auto& e : bdry_edges_ )
+    {
+      const Vec2d& a = copy_xy_[ e[0] ];
+      const Vec2d& b = copy_xy_[ e[1] ];
+      const double r = 0.5 * (b-a).norm() + tol;
+
+      for ( const Vertex* v : receiver_->get_vertices(0.5*(a+b), r) )
+      {
+        if ( !v->on_boundary() || stitched.count(v) > 0 )
+          continue;
+
+        if ( distance_point_edge_sqr( v->xy(), a, b ) < tol_sqr )
+          return false;
+      }
+    }
+
+    return true;
+
+  } // MeshTiling::matches_interfaces()
+
+  /*------------------------------------------------------------------
+  | Check if the copy overlaps the receiver. After a bounding box 
+  | check, the boundary edges of both meshes are tested for 
+  | crossings. Since an overlap without any crossing requires one
+  | mesh to enclose parts of the other, the remaining boundary 
+  | vertices and edge midpoints are located in the elements of the
+  | other mesh.
+  ------------------------------------------------------------------*/
+  bool overlaps_receiver(bool flip)
+  {
+    // Extent and longest edge of the copy
+    copy_lowleft_  = {  DBL_MAX,  DBL_MAX };
+    copy_upright_  = { -DBL_MAX, -DBL_MAX };
+
+    for ( const Vec2d& xy : copy_xy_ )
+    {
+      copy_lowleft_.x = MIN( copy_lowleft_.x, xy.x );
+      copy_lowleft_.y = MIN( copy_lowleft_.y, xy.y );
+      copy_upright_.x = MAX( copy_upright_.x, xy.x );
+      copy_upright_.y = MAX( copy_upright_.y, xy.y );
+    }
+
+    copy_max_edge_length_ = 0.0;
+
+    for ( const auto& e : bdry_edges_ )
+      copy_max_edge_length_ = MAX( copy_max_edge_length_, 
+                              (copy_xy_[e[1]] - copy_xy_[e[0]]).norm() );
+    for ( const auto& e : intr_edges_ )
+      copy_max_edge_length_ = MAX( copy_max_edge_length_, 
+                              (copy_xy_[e[1]] - copy_xy_[e[0]]).norm() );
+
+    if ( !rect_overlap( copy_lowleft_, copy_upright_, 
+                        bbox_lowleft_, bbox_upright_ ) )
+      return false;
+
+    // Crossing boundary edges
+    for ( const auto& e : bdry_edges_ )
+    {
+      const Vec2d& a = copy_xy_[ e[0] ];
+      const Vec2d& b = copy_xy_[ e[1] ];
+      const double r = 0.5 * ( (b-a).norm() + max_edge_length_ );
+
+      for ( const Edge* e_rcv : receiver_->get_bdry_edges(0.5*(a+b), r) )
+        if ( line_line_crossing( a, b, e_rcv->v1().xy(), 
+                                       e_rcv->v2().xy() ) )
+          return true;
+    }
+
+    // Copy vertices and edge midpoints within receiver elements
+    for ( std::size_t i : bdry_vertices_ )
+      if ( !new_vertices_[i] && in_receiver( copy_xy_[i] ) )
+        return true;
+
+    for ( std::size_t i = 0; i < bdry_edges_.size(); ++i )
+    {
+      const Vec2d& a = copy_xy_[ bdry_edges_[i][0] ];
+      const Vec2d& b = copy_xy_[ bdry_edges_[i][1] ];
+
+      if ( !interface_edges_[i] && in_receiver( 0.5*(a+b) ) )
+        return true;
+    }
+
+    // Receiver boundary vertices within elements of the copy
+    const Vec2d center = 0.5 * ( copy_lowleft_ + copy_upright_ );
+    const double r = 0.5 * ( copy_upright_ - copy_lowleft_ ).norm();
+
+    std::unordered_set<const Vertex*> stitched {};
+
+    for ( const Vertex* v : new_vertices_ )
+      if ( v ) stitched.insert( v );
+
+    for ( const Vertex* v : receiver_->get_vertices(center, r) )
+    {
+      if ( !v->on_boundary() || stitched.count(v) > 0 )
+        continue;
+
+      if ( !in_on_rect( v->xy(), copy_lowleft_, copy_upright_ ) )
+        continue;
+
+      if ( in_copy( v->xy(), flip ) )
+        return true;
+    }
+
+    return false;
+
+  } // MeshTiling::overlaps_receiver()
+
+  /*------------------------------------------------------------------
+  | Check if a location is inside or on any receiver element
+  ------------------------------------------------------------------*/
+  bool in_receiver(const Vec2d& xy) const
+  {
+    for ( const Triangle* t : receiver_->get_triangles(xy, max_edge_length_) )
+      if ( in_on_triangle( xy, t->v1().xy(), t->v2().xy(), 
+                               t->v3().xy() ) )
+        return true;
+
+    for ( const Quad* q : receiver_->get_quads(xy, max_edge_length_) )
+      if ( in_on_quad( xy, q->v1().xy(), q->v2().xy(), 
+                           q->v3().xy(), q->v4().xy() ) )
+        return true;
+
+    return false;
+
+  } // MeshTiling::in_receiver()
+
+  /*------------------------------------------------------------------
+  | Check if a location is inside or on any element of the copy.
+  | Mirrored copies are traversed in reverse vertex order.
+  ------------------------------------------------------------------*/
+  bool in_copy(const Vec2d& xy, bool flip) const
+  {
+    for ( const auto& t : tris_ )
+    {
+      const Vec2d& p = copy_xy_[ t[0] ];
+      const Vec2d& q = copy_xy_[ flip ? t[2] : t[1] ];
+      const Vec2d& r = copy_xy_[ flip ? t[1] : t[2] ];
+
+      if ( in_on_triangle( xy, p, q, r ) )
+        return true;
+    }
+
+    for ( const auto& q : quads_ )
+    {
+      const Vec2d& p1 = copy_xy_[ q[0] ];
+      const Vec2d& p2 = copy_xy_[ flip ? q[3] : q[1] ];
+      const Vec2d& p3 = copy_xy_[ q[2] ];
+      const Vec2d& p4 = copy_xy_[ flip ? q[1] : q[3] ];
+
+      if ( in_on_quad( xy, p1, p2, p3, p4 ) )
+        return true;
+    }
+
+    return false;
+
+  } // MeshTiling::in_copy()
+
+  /*------------------------------------------------------------------
+  | Stitched vertices, that are no longer located on a boundary edge,
+  | are turned into fixed interior vertices - in order to preserve
+  | the location of the interface, analogous to MeshMerger
+  ------------------------------------------------------------------*/
+  void update_boundary_properties()
+  {
+    receiver_->clear_waste();
+
+    const EdgeList& bdry_edges = receiver_->boundary_edges();
+
+    for ( Vertex* v : stitched_vertices_ )
+    {
+      bool on_boundary = false;
+
+      for ( const auto& e : v->edges() )
+        if ( &e->edgelist() == &bdry_edges )
+          on_boundary = true;
+
+      if ( on_boundary )
+        continue;
+
+      v->remove_property( VertexProperty::on_boundary );
+      v->add_property( VertexProperty::is_fixed );
+    }
+
+    n_stitched_verts_ += stitched_vertices_.size();
+
+  } // MeshTiling::update_boundary_properties()
+
+  /*------------------------------------------------------------------
+  | Get the receiver vertex of a cell vertex index
+  ------------------------------------------------------------------*/
+  Vertex& vertex(std::size_t i)
+  {
+    ASSERT( new_vertices_[i], "MeshTiling: Invalid data structure." );
+    return *new_vertices_[i];
+  }
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  Mesh*                                   receiver_;
+
+  std::vector<Vec2d>                      xy_            {};
+  std::vector<VertexProperty>             properties_    {};
+  IndexVector                             bdry_vertices_ {};
+  std::vector<std::array<std::size_t,4>>  quads_         {};
+  std::vector<int>                        quad_colors_   {};
+  std::vector<std::array<std::size_t,3>>  tris_          {};
+  std::vector<int>                        tri_colors_    {};
+  std::vector<std::array<std::size_t,2>>  intr_edges_    {};
+  std::vector<std::array<std::size_t,2>>  bdry_edges_    {};
+  std::vector<int>                        bdry_markers_  {};
+  double                                  min_edge_length_ { 0.0 };
+  double                                  cell_area_     { 0.0 };
+
+  VertexVector                            new_vertices_    {};
+  VertexVector                            stitched_vertices_ {};
+  EdgeVector                              interface_edges_ {};
+  std::vector<Vec2d>                      copy_xy_         {};
+  Vec2d                                   copy_lowleft_    {};
+  Vec2d                                   copy_upright_    {};
+  double                                  copy_max_edge_length_ { 0.0 };
+
+  Vec2d                                   bbox_lowleft_    {};
+  Vec2d                                   bbox_upright_    {};
+  double                                  max_edge_length_ { 0.0 };
+
+  double                                  tolerance_     { 1.0E-4 };
+  std::size_t                             n_copies_      { 0 };
+  std::size_t                             n_stitched_verts_ { 0 };
+  std::size_t                             n_stitched_edges_ { 0 };
+
+}; // MeshTiling
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
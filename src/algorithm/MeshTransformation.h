@@ -0,0 +1,132 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <cmath>
+
+#include "VecND.h"
+
+#include "utils.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* An affine transformation xy -> A * xy + t, that is used to place
+* copies of a meshed unit cell. Transformations are composed with
+* operator*, where (t1 * t2)(xy) = t1( t2(xy) ).
+*********************************************************************/
+class MeshTransformation
+{
+public:
+  /*------------------------------------------------------------------
+  | Constructor - the identity
+  ------------------------------------------------------------------*/
+  MeshTransformation() = default;
+
+  MeshTransformation(double a11, double a12, double a21, double a22,
+                     const Vec2d& t = {0.0, 0.0})
+  : a11_ { a11 }, a12_ { a12 }, a21_ { a21 }, a22_ { a22 }, t_ { t }
+  {}
+
+  /*------------------------------------------------------------------
+  | A translation by <delta>
+  ------------------------------------------------------------------*/
+  static inline MeshTransformation translation(const Vec2d& delta)
+  { return { 1.0, 0.0, 0.0, 1.0, delta }; }
+
+  /*------------------------------------------------------------------
+  | A counter-clockwise rotation by <angle> around <center>
+  ------------------------------------------------------------------*/
+  static inline MeshTransformation rotation(double       angle,
+                                            const Vec2d& center={0.0,0.0})
+  {
+    const double c = std::cos( angle );
+    const double s = std::sin( angle );
+
+    MeshTransformation r { c, -s, s, c };
+    r.t_ = center - r.linear( center );
+
+    return r;
+  }
+
+  /*------------------------------------------------------------------
+  | A reflection at the line through <point> with <direction>
+  ------------------------------------------------------------------*/
+  static inline MeshTransformation mirror(const Vec2d& point,
+                                          const Vec2d& direction)
+  {
+    const Vec2d d = direction / direction.norm();
+
+    MeshTransformation m { d.x*d.x - d.y*d.y, 2.0*d.x*d.y,
+                           2.0*d.x*d.y,       d.y*d.y - d.x*d.x };
+    m.t_ = point - m.linear( point );
+
+    return m;
+  }
+
+  /*------------------------------------------------------------------
+  | Apply the transformation to a coordinate
+  ------------------------------------------------------------------*/
+  Vec2d operator()(const Vec2d& xy) const { return linear( xy ) + t_; }
+
+  /*------------------------------------------------------------------
+  | Compose two transformations
+  ------------------------------------------------------------------*/
+  MeshTransformation operator*(const MeshTransformation& r) const
+  {
+    return { a11_ * r.a11_ + a12_ * r.a21_, a11_ * r.a12_ + a12_ * r.a22_,
+             a21_ * r.a11_ + a22_ * r.a21_, a21_ * r.a12_ + a22_ * r.a22_,
+             linear( r.t_ ) + t_ };
+  }
+
+  /*------------------------------------------------------------------
+  | The inverse transformation - requires a regular linear part
+  ------------------------------------------------------------------*/
+  MeshTransformation inverse() const
+  {
+    const double det = determinant();
+    ASSERT( ABS(det) > 0.0, 
+      "MeshTransformation::inverse(): Singular transformation.");
+
+    MeshTransformation inv {  a22_ / det, -a12_ / det,
+                             -a21_ / det,  a11_ / det };
+    inv.t_ = -1.0 * inv.linear( t_ );
+
+    return inv;
+  }
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  double determinant() const { return a11_ * a22_ - a12_ * a21_; }
+  bool reverses_orientation() const { return determinant() < 0.0; }
+  const Vec2d& translation() const { return t_; }
+
+private:
+  /*------------------------------------------------------------------
+  | Apply only the linear part of the transformation
+  ------------------------------------------------------------------*/
+  Vec2d linear(const Vec2d& xy) const
+  { return { a11_ * xy.x + a12_ * xy.y, a21_ * xy.x + a22_ * xy.y }; }
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  double a11_ { 1.0 };
+  double a12_ { 0.0 };
+  double a21_ { 0.0 };
+  double a22_ { 1.0 };
+  Vec2d  t_   { 0.0, 0.0 };
+
+}; // MeshTransformation
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
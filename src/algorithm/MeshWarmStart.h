@@ -0,0 +1,457 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <ostream>
+#include <unordered_set>
+#include <memory>
+
+#include "VecND.h"
+#include "Geometry.h"
+#include "QuadTree.h"
+
+#include "Domain.h"
+#include "Mesh.h"
+#include "MeshCleanup.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* Summary of a warm started mesh, i.e. how much of a previous mesh
+* has been transferred to the new mesh
+*********************************************************************/
+struct WarmStartReport
+{
+  std::size_t n_boundary_edges          { 0 };
+  std::size_t n_reused_boundary_edges   { 0 };
+  std::size_t n_previous_elements       { 0 };
+  std::size_t n_reused_elements         { 0 };
+  std::size_t n_changed_edges           { 0 };
+  std::size_t n_segment_tests           { 0 };
+  double      reused_area               { 0.0 };
+  double      domain_area               { 0.0 };
+
+  /*------------------------------------------------------------------
+  | The fraction of the domain, that is covered by reused elements
+  ------------------------------------------------------------------*/
+  double reused_area_fraction() const
+  { return ( domain_area > 0.0 ) ? reused_area / domain_area : 0.0; }
+
+  /*------------------------------------------------------------------
+  | Write the report
+  ------------------------------------------------------------------*/
+  void write(std::ostream& os) const
+  {
+    os << "WARM-START\n"
+       << "boundary edges:   " << n_reused_boundary_edges << " / "
+       << n_boundary_edges << " reused\n"
+       << "elements:         " << n_reused_elements << " / "
+       << n_previous_elements << " reused\n"
+       << "changed edges:    " << n_changed_edges << " ("
+       << n_segment_tests << " element tests)\n"
+       << "area:             " << 100.0 * reused_area_fraction()
+       << " % reused\n";
+  }
+
+}; // WarmStartReport
+
+
+/*********************************************************************
+* This class transfers the elements of a previous mesh to a new
+* mesh of a modified domain. The new mesh must have been prepared
+* for the given domain, i.e. it contains only its boundary edges.
+*
+* Boundary edges of both meshes, which coincide, are considered as
+* unchanged. All other boundary edges of both meshes are changed
+* geometry. Previous elements are transferred, if they are located
+* inside the new domain and if they are not located within a band
+* of <band_factor> times the local size function around the
+* changed geometry. The transferred elements are bounded by
+* interior edges, which define the advancing front of the remaining
+* gaps - these are filled by a subsequent triangulation.
+*
+* The size function of the domain is assumed to be unchanged far
+* away from the modified geometry.
+*
+* The changed boundary edges are stored in a quadtree by their 
+* centroids, such that every previous element is only tested 
+* against the changed edges in its vicinity.
+*********************************************************************/
+class MeshWarmStart
+{
+public:
+  using VertexVector   = std::vector<Vertex*>;
+  using BoolVector     = std::vector<bool>;
+
+  /*------------------------------------------------------------------
+  | A changed boundary edge and the width of the band around it
+  ------------------------------------------------------------------*/
+  struct Segment
+  {
+    Vec2d  v1;
+    Vec2d  v2;
+    Vec2d  c;
+    double band;
+
+    const Vec2d& xy() const { return c; }
+  };
+
+  using SegmentVector  = std::vector<Segment>;
+  using SegmentTree    = QuadTree<const Segment, double>;
+  using SegmentTreePtr = std::unique_ptr<SegmentTree>;
+  using SegmentPtrs    = SegmentTree::Vector;
+
+  /*------------------------------------------------------------------
+  | Constructor / Destructor
+  ------------------------------------------------------------------*/
+  MeshWarmStart(Mesh& previous, Mesh& mesh, const Domain& domain)
+  : previous_ { &previous }
+  , mesh_     { &mesh }
+  , domain_   { &domain }
+  {}
+
+  virtual ~MeshWarmStart() {}
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  double band_factor() const { return band_factor_; }
+  double tolerance() const { return tolerance_; }
+  const WarmStartReport& report() const { return report_; }
+
+  /*------------------------------------------------------------------
+  | Setters
+  ------------------------------------------------------------------*/
+  void band_factor(double b) { band_factor_ = b; }
+  void tolerance(double t) { tolerance_ = t; }
+
+  /*------------------------------------------------------------------
+  | Transfer the previous elements to the new mesh
+  ------------------------------------------------------------------*/
+  bool transfer()
+  {
+    if ( transferred_ )
+      return false;
+
+    MeshCleanup::assign_mesh_indices( *previous_ );
+
+    new_vertices_.assign( previous_->n_vertices(), nullptr );
+    in_band_.assign( previous_->n_vertices(), false );
+
+    report_ = {};
+    report_.n_boundary_edges    = mesh_->n_boundary_edges();
+    report_.n_previous_elements = previous_->n_elements();
+    report_.domain_area         = domain_->area();
+
+    match_boundary_vertices();
+    collect_changed_boundary_edges();
+    build_segment_tree();
+    mark_vertices_in_band();
+
+    for ( const auto& q_ptr : previous_->quads() )
+      if ( is_reusable( *q_ptr ) )
+        transfer_element( *q_ptr );
+
+    for ( const auto& t_ptr : previous_->triangles() )
+      if ( is_reusable( *t_ptr ) )
+        transfer_element( *t_ptr );
+
+    transferred_ = true;
+
+    return true;
+
+  } // MeshWarmStart::transfer()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Map previous boundary vertices onto coincident boundary vertices
+  | of the new mesh
+  ------------------------------------------------------------------*/
+  void match_boundary_vertices()
+  {
+    for ( const auto& v_ptr : previous_->vertices() )
+    {
+      if ( !v_ptr->on_boundary() )
+        continue;
+
+      const Vec2d& xy = v_ptr->xy();
+      const double tol = tolerance_ * domain_->size_function( xy );
+
+      for ( Vertex* v : mesh_->vertices().get_items(xy, tol) )
+      {
+        if ( !v->on_boundary() )
+          continue;
+
+        new_vertices_[ v_ptr->index() ] = v;
+        break;
+      }
+    }
+
+  } // MeshWarmStart::match_boundary_vertices()
+
+  /*------------------------------------------------------------------
+  | Collect all boundary edges of both meshes, that have no
+  | counterpart in the other mesh
+  ------------------------------------------------------------------*/
+  void collect_changed_boundary_edges()
+  {
+    std::unordered_set<const Edge*> reused_edges {};
+
+    for ( const auto& e_ptr : previous_->boundary_edges() )
+    {
+      Vertex* v1 = new_vertices_[ e_ptr->v1().index() ];
+      Vertex* v2 = new_vertices_[ e_ptr->v2().index() ];
+
+      Edge* e_new = ( v1 && v2 )
+                  ? mesh_->get_boundary_edge( *v1, *v2, true )
+                  : nullptr;
+
+      if ( e_new )
+        reused_edges.insert( e_new );
+      else
+        add_changed_edge( *e_ptr );
+    }
+
+    for ( const auto& e_ptr : mesh_->boundary_edges() )
+      if ( reused_edges.count( e_ptr.get() ) == 0 )
+        add_changed_edge( *e_ptr );
+
+    report_.n_reused_boundary_edges = reused_edges.size();
+    report_.n_changed_edges         = changed_edges_.size();
+
+  } // MeshWarmStart::collect_changed_boundary_edges()
+
+  /*------------------------------------------------------------------
+  | Add a changed boundary edge
+  ------------------------------------------------------------------*/
+  void add_changed_edge(const Edge& e)
+  {
+    const Vec2d& c = e.xy();
+
+    changed_edges_.push_back( { e.v1().xy(), e.v2().xy(), c, 
+                                band_width( c ) } );
+
+    max_half_length_ = MAX( max_half_length_, 0.5 * e.length() );
+
+  } // MeshWarmStart::add_changed_edge()
+
+  /*------------------------------------------------------------------
+  | Store all changed boundary edges in a quadtree, which covers
+  | the bounding box of their centroids
+  ------------------------------------------------------------------*/
+  void build_segment_tree()
+  {
+    if ( changed_edges_.empty() )
+      return;
+
+    Vec2d xy_min = changed_edges_[0].c;
+    Vec2d xy_max = changed_edges_[0].c;
+
+    for ( const Segment& s : changed_edges_ )
+    {
+      xy_min = { MIN(xy_min.x, s.c.x), MIN(xy_min.y, s.c.y) };
+      xy_max = { MAX(xy_max.x, s.c.x), MAX(xy_max.y, s.c.y) };
+    }
+
+    const Vec2d  center = 0.5 * ( xy_min + xy_max );
+    const double scale  = 1.01 * MAX( xy_max.x - xy_min.x, 
+                                      xy_max.y - xy_min.y ) 
+                        + 2.0 * max_half_length_;
+
+    segment_tree_ = std::make_unique<SegmentTree>( 
+      scale, ContainerQuadTreeItems, ContainerQuadTreeDepth, center );
+
+    for ( const Segment& s : changed_edges_ )
+      segment_tree_->add( &s );
+
+  } // MeshWarmStart::build_segment_tree()
+
+  /*------------------------------------------------------------------
+  | Mark all previous vertices, that are located in the band around
+  | the changed boundary edges
+  ------------------------------------------------------------------*/
+  void mark_vertices_in_band()
+  {
+    for ( const Segment& s : changed_edges_ )
+    {
+      const double r = 0.5 * ( s.v2 - s.v1 ).norm() + s.band;
+
+      for ( Vertex* v : previous_->vertices().get_items(s.c, r) )
+        if ( distance_point_edge_sqr(v->xy(), s.v1, s.v2)
+             < s.band * s.band )
+          in_band_[ v->index() ] = true;
+    }
+
+  } // MeshWarmStart::mark_vertices_in_band()
+
+  /*------------------------------------------------------------------
+  | Check if a previous element can be transferred to the new mesh
+  ------------------------------------------------------------------*/
+  bool is_reusable(const Facet& f)
+  {
+    for ( std::size_t i = 0; i < f.n_vertices(); ++i )
+    {
+      const Vertex& v = f.vertex(i);
+
+      if ( in_band_[ v.index() ] )
+        return false;
+
+      if ( v.on_boundary() && !new_vertices_[ v.index() ] )
+        return false;
+    }
+
+    // The centroid of an element is located within its longest edge 
+    // to all of its vertices, hence only changed edges in this range 
+    // plus their half length can touch the element
+    if ( segment_tree_ )
+    {
+      const double r 
+        = f.max_edge_length() + max_half_length_ + TQ_SMALL;
+
+      found_.clear();
+      segment_tree_->get_items( f.xy(), r, found_ );
+
+      // Only elements, whose edges are longer than the local band, 
+      // might span over the changed geometry with all vertices 
+      // outside of the band
+      for ( const Segment* s : found_ )
+      {
+        if ( f.max_edge_length() < s->band )
+          continue;
+
+        ++report_.n_segment_tests;
+
+        if ( intersects_segment( f, *s ) )
+          return false;
+      }
+    }
+
+    return domain_->is_inside( f );
+
+  } // MeshWarmStart::is_reusable()
+
+  /*------------------------------------------------------------------
+  | Check if a segment touches or crosses a given element
+  ------------------------------------------------------------------*/
+  static inline bool intersects_segment(const Facet& f, const Segment& s)
+  {
+    if ( f.n_vertices() == 3 )
+    {
+      const Vec2d& p = f.vertex(0).xy();
+      const Vec2d& q = f.vertex(1).xy();
+      const Vec2d& r = f.vertex(2).xy();
+
+      return (  in_on_triangle( s.v1, p, q, r )
+             || line_tri_intersection( s.v1, s.v2, p, q, r ) );
+    }
+
+    const Vec2d& p = f.vertex(0).xy();
+    const Vec2d& q = f.vertex(1).xy();
+    const Vec2d& r = f.vertex(2).xy();
+    const Vec2d& t = f.vertex(3).xy();
+
+    return (  in_on_quad( s.v1, p, q, r, t )
+           || line_quad_intersection( s.v1, s.v2, p, q, r, t ) );
+
+  } // MeshWarmStart::intersects_segment()
+
+  /*------------------------------------------------------------------
+  | Copy an element to the new mesh. All its edges that are not
+  | shared with other transferred elements or with the boundary are
+  | added as interior edges, which are oriented such that the
+  | element is located to their right - thus they point in the
+  | direction of the advancing front.
+  ------------------------------------------------------------------*/
+  void transfer_element(const Facet& f)
+  {
+    const std::size_t n = f.n_vertices();
+
+    VertexVector verts ( n, nullptr );
+
+    for ( std::size_t i = 0; i < n; ++i )
+      verts[i] = &new_vertex( f.vertex(i) );
+
+    if ( n == 3 )
+      mesh_->add_triangle( *verts[0], *verts[1], *verts[2], f.color() );
+    else
+      mesh_->add_quad( *verts[0], *verts[1], *verts[2], *verts[3],
+                       f.color() );
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+      Vertex& v1 = *verts[i];
+      Vertex& v2 = *verts[(i+1) % n];
+
+      if ( mesh_->get_boundary_edge( v1, v2 ) ||
+           mesh_->get_interior_edge( v1, v2 ) )
+        continue;
+
+      mesh_->add_interior_edge( v2, v1 );
+    }
+
+    mesh_->add_area( f.area() );
+
+    report_.reused_area += f.area();
+    ++report_.n_reused_elements;
+
+  } // MeshWarmStart::transfer_element()
+
+  /*------------------------------------------------------------------
+  | Get the new vertex of a previous vertex - interior vertices are
+  | copied upon their first request
+  ------------------------------------------------------------------*/
+  Vertex& new_vertex(const Vertex& v)
+  {
+    Vertex*& v_new = new_vertices_[ v.index() ];
+
+    if ( !v_new )
+    {
+      v_new = &mesh_->add_vertex( v.xy() );
+      v_new->add_property( v.properties() );
+      v_new->remove_property( VertexProperty::on_front );
+    }
+
+    return *v_new;
+
+  } // MeshWarmStart::new_vertex()
+
+  /*------------------------------------------------------------------
+  | The width of the band around changed geometry
+  ------------------------------------------------------------------*/
+  double band_width(const Vec2d& xy) const
+  { return band_factor_ * domain_->size_function( xy ); }
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  Mesh*             previous_;
+  Mesh*             mesh_;
+  const Domain*     domain_;
+
+  VertexVector      new_vertices_    {};
+  BoolVector        in_band_         {};
+  SegmentVector     changed_edges_   {};
+  double            max_half_length_ { 0.0 };
+  SegmentTreePtr    segment_tree_    {};
+  SegmentPtrs       found_           {};
+  WarmStartReport   report_          {};
+
+  double            band_factor_     { 2.0 };
+  double            tolerance_       { 1.0E-6 };
+  bool              transferred_     { false };
+
+}; // MeshWarmStart
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
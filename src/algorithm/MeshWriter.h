@@ -12,6 +12,9 @@
 
 #include "Mesh.h"
 #include "MeshCleanup.h"
+#include "MeshHighOrder.h"
+#include "MeshColoring.h"
+#include "MeshDual.h"
 
 namespace TQMesh {
 namespace TQAlgorithm {
@@ -29,6 +32,18 @@ enum class MeshExportType {
 };
 
 
+/*********************************************************************
+* Optional data, that is exported along with a mesh. Every entry 
+* is only exported, if it matches the current state of the mesh.
+*********************************************************************/
+struct MeshExportOptions
+{
+  const MeshHighOrder* high_order { nullptr };
+  const MeshColoring*  coloring   { nullptr };
+  const MeshDual*      dual       { nullptr };
+};
+
+
 /*********************************************************************
 * Class for the export of meshes
 *********************************************************************/
@@ -36,11 +51,16 @@ class MeshWriter
 {
 public:
   /*------------------------------------------------------------------
-  | Constructor
+  | Constructor - if the nodes of second order elements are provided,
+  | the mesh is exported with P2 triangles and Q8 / Q9 quads. 
+  | If an element coloring or the median-dual metrics are provided,
+  | they are exported along with the mesh.
   ------------------------------------------------------------------*/
-  MeshWriter(Mesh& mesh, const Domain& domain)
+  MeshWriter(Mesh& mesh, const Domain& domain, 
+             const MeshExportOptions& options = {})
   : mesh_ { &mesh }
   , domain_ { &domain }
+  , options_ { options }
   {}
 
   ~MeshWriter() {}
@@ -50,10 +70,40 @@ public:
   ------------------------------------------------------------------*/
   bool write(const std::string& filename, MeshExportType export_type)
   {
+    SizeFunctionPhaseScope phase { domain_->size_function_profiler(), 
+                                   SizeFunctionPhase::Export };
+
     MeshCleanup::assign_size_function_to_vertices(*mesh_, *domain_);
     MeshCleanup::assign_mesh_indices(*mesh_);
     MeshCleanup::setup_facet_connectivity(*mesh_);
 
+    // The optional data is validated for every export, since the 
+    // mesh may have been modified in between
+    high_order_ = options_.high_order;
+    coloring_   = options_.coloring;
+    dual_       = options_.dual;
+
+    if ( high_order_ && !high_order_->matches(*mesh_) )
+    {
+      LOG(WARNING) << "MeshWriter::write(): The high order nodes do not "
+                   << "match the mesh - exporting linear elements.";
+      high_order_ = nullptr;
+    }
+
+    if ( coloring_ && !coloring_->matches(*mesh_) )
+    {
+      LOG(WARNING) << "MeshWriter::write(): The element coloring does "
+                   << "not match the mesh - it is not exported.";
+      coloring_ = nullptr;
+    }
+
+    if ( dual_ && !dual_->matches(*mesh_) )
+    {
+      LOG(WARNING) << "MeshWriter::write(): The median-dual metrics do "
+                   << "not match the mesh - they are not exported.";
+      dual_ = nullptr;
+    }
+
     switch (export_type)
     {
       case MeshExportType::COUT:
@@ -88,12 +138,44 @@ private:
 
     outfile << (*mesh_);
 
+    write_periodic_vertex_pairs( outfile );
+
+    if ( high_order_ )
+      high_order_->write( outfile );
+
+    if ( coloring_ )
+      coloring_->write( outfile );
+
+    if ( dual_ )
+      dual_->write( outfile );
+
     outfile.close();
 
     return true;
 
   } // MeshWriter::write_to_txt()
 
+  /*------------------------------------------------------------------
+  | Export the pairs of periodic boundary vertices in terms of 
+  | source index, target index, source marker and target marker
+  ------------------------------------------------------------------*/
+  void write_periodic_vertex_pairs(std::ostream& os) const
+  {
+    if ( domain_->periodic_pairs().size() < 1 )
+      return;
+
+    auto pairs = MeshCleanup::get_periodic_vertex_pairs(*mesh_, *domain_);
+
+    os << "PERIODICVERTICES " << pairs.size() << "\n";
+    for ( const auto& p : pairs )
+      os << std::setprecision(0) << std::fixed
+        << std::setw(4) << p.source->index() << ","
+        << std::setw(4) << p.target->index() << ","
+        << std::setw(4) << p.source_marker << ","
+        << std::setw(4) << p.target_marker << "\n";
+
+  } // MeshWriter::write_periodic_vertex_pairs()
+
   /*------------------------------------------------------------------
   | Export the mesh to a vtu file
   ------------------------------------------------------------------*/
@@ -113,9 +195,11 @@ private:
     std::vector<int>    in_quad_layer {};
     std::vector<int>    is_fixed {};
     std::vector<int>    element_color {};
+    std::vector<int>    assembly_color {};
     std::vector<double> edge_length {};
     std::vector<double> max_angle {};
     std::vector<double> cell_quality {};
+    std::vector<double> dual_volume {};
 
     size_t i_offset = 0;
 
@@ -128,8 +212,28 @@ private:
       size_function.push_back( domain_->size_function(v_ptr->xy()) ); 
       in_quad_layer.push_back( static_cast<int>( v_ptr->in_quad_layer() ) );
       is_fixed.push_back( static_cast<int>( v_ptr->is_fixed() ) );
+
+      if ( dual_ )
+        dual_volume.push_back( dual_->volumes()[v_ptr->index()] );
     }
 
+    if ( high_order_ )
+      for ( const Vec2d& xy : high_order_->nodes() )
+      {
+        points.push_back( xy.x );
+        points.push_back( xy.y );
+        points.push_back( 0.0 );
+
+        size_function.push_back( domain_->size_function(xy) );
+        in_quad_layer.push_back( 0 );
+        is_fixed.push_back( 0 );
+
+        if ( dual_ )
+          dual_volume.push_back( 0.0 );
+      }
+
+    size_t i_quad = 0;
+
     for ( const auto& q_ptr : mesh_->quads() )
     {
       connectivity.push_back( q_ptr->v1().index() );
@@ -138,13 +242,34 @@ private:
       connectivity.push_back( q_ptr->v4().index() );
 
       i_offset += 4;
-      offsets.push_back( i_offset );
 
-      /// Type == 9 -> VTK_QUAD
-      types.push_back( 9 );
+      if ( !high_order_ )
+      {
+        /// Type == 9 -> VTK_QUAD
+        types.push_back( 9 );
+      }
+      else
+      {
+        const auto& nodes = high_order_->quad_nodes()[i_quad++];
+        const size_t n_nodes = high_order_->quad_centers() ? 5 : 4;
+
+        for ( size_t i = 0; i < n_nodes; ++i )
+          connectivity.push_back( high_order_->node_index(nodes[i]) );
+
+        i_offset += n_nodes;
+
+        /// Type == 28 -> VTK_BIQUADRATIC_QUAD
+        /// Type == 23 -> VTK_QUADRATIC_QUAD
+        types.push_back( high_order_->quad_centers() ? 28 : 23 );
+      }
+
+      offsets.push_back( i_offset );
 
       element_color.push_back( q_ptr->color() );
 
+      if ( coloring_ )
+        assembly_color.push_back( coloring_->color(*q_ptr) );
+
       edge_length.push_back( q_ptr->max_edge_length() );
       max_angle.push_back( q_ptr->max_angle() * 180. / M_PI );
 
@@ -152,6 +277,8 @@ private:
       cell_quality.push_back( q_ptr->quality(s) );
     }
 
+    size_t i_tri = 0;
+
     for ( const auto& t_ptr : mesh_->triangles() )
     {
       connectivity.push_back( t_ptr->v1().index() );
@@ -159,13 +286,30 @@ private:
       connectivity.push_back( t_ptr->v3().index() );
 
       i_offset += 3;
-      offsets.push_back( i_offset );
 
-      /// Type == 5 -> VTK_TRIANGLE
-      types.push_back( 5 );
+      if ( !high_order_ )
+      {
+        /// Type == 5 -> VTK_TRIANGLE
+        types.push_back( 5 );
+      }
+      else
+      {
+        for ( size_t i : high_order_->triangle_nodes()[i_tri++] )
+          connectivity.push_back( high_order_->node_index(i) );
+
+        i_offset += 3;
+
+        /// Type == 22 -> VTK_QUADRATIC_TRIANGLE
+        types.push_back( 22 );
+      }
+
+      offsets.push_back( i_offset );
 
       element_color.push_back( t_ptr->color() );
 
+      if ( coloring_ )
+        assembly_color.push_back( coloring_->color(*t_ptr) );
+
       edge_length.push_back( t_ptr->max_edge_length() );
       max_angle.push_back( t_ptr->max_angle() * 180. / M_PI );
 
@@ -176,10 +320,29 @@ private:
 
     VtuWriter writer { points, connectivity, offsets, types };
 
+    if ( domain_->periodic_pairs().size() > 0 )
+    {
+      std::vector<int> periodic_source ( points.size() / 3, -1 );
+
+      for ( const auto& p : 
+            MeshCleanup::get_periodic_vertex_pairs(*mesh_, *domain_) )
+        periodic_source[p.target->index()] = p.source->index();
+
+      writer.add_point_data( periodic_source, "periodic_source", 1 );
+    }
+
     writer.add_point_data( size_function, "size_function", 1 );
     writer.add_point_data( in_quad_layer, "in_quad_layer", 1 );
     writer.add_point_data( is_fixed, "fixed_vertices", 1 );
+
+    if ( dual_ )
+      writer.add_point_data( dual_volume, "dual_volume", 1 );
+
     writer.add_cell_data( element_color, "element_color", 1 );
+
+    if ( coloring_ )
+      writer.add_cell_data( assembly_color, "assembly_color", 1 );
+
     writer.add_cell_data( edge_length, "edge_length", 1 );
     writer.add_cell_data( max_angle, "max_angle", 1 );
     writer.add_cell_data( cell_quality, "cell_quality", 1 );
@@ -193,8 +356,13 @@ private:
   /*------------------------------------------------------------------
   | Attributes
   ------------------------------------------------------------------*/
-  Mesh*         mesh_;
-  const Domain* domain_;
+  Mesh*                mesh_;
+  const Domain*        domain_;
+  MeshExportOptions    options_;
+
+  const MeshHighOrder* high_order_ { nullptr };
+  const MeshColoring*  coloring_   { nullptr };
+  const MeshDual*      dual_       { nullptr };
 
 }; // MeshWriter
 
@@ -47,11 +47,35 @@ public:
   Mesh& mesh() { return mesh_; }
   bool show_progress() const { return show_progress_; }
 
+  /*------------------------------------------------------------------
+  | Access the validation cascades of new triangles and vertices,
+  | which also hold the per-check rejection statistics
+  ------------------------------------------------------------------*/
+  const ValidationCascade& triangle_checks() const 
+  { return front_update_.triangle_checks(); }
+  ValidationCascade& triangle_checks() 
+  { return front_update_.triangle_checks(); }
+  const ValidationCascade& vertex_checks() const 
+  { return front_update_.vertex_checks(); }
+  ValidationCascade& vertex_checks() 
+  { return front_update_.vertex_checks(); }
+
   /*------------------------------------------------------------------
   | Triangulate a given initialized mesh structure
   ------------------------------------------------------------------*/
   virtual bool generate_elements() = 0;
 
+  /*------------------------------------------------------------------
+  | Restore the default settings of this strategy, while its 
+  | internal buffers are kept for subsequent runs
+  ------------------------------------------------------------------*/
+  virtual void reset_settings()
+  {
+    show_progress_ = false;
+    front_.order( FrontOrder::Length );
+    front_update_.reset_settings();
+  }
+
 protected:
 
   /*------------------------------------------------------------------
@@ -67,6 +91,12 @@ protected:
     if (sort_edges)
       front_.sort_edges( false );
 
+    front_update_.init_front_check();
+
+    // Every meshing run starts with fresh check statistics
+    front_update_.triangle_checks().reset();
+    front_update_.vertex_checks().reset();
+
     return base;
   }
 
@@ -8,6 +8,10 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <queue>
+#include <cmath>
 
 #include "VecND.h"
 
@@ -17,6 +21,7 @@
 #include "Quad.h"
 #include "Mesh.h"
 #include "Domain.h"
+#include "MeshCleanup.h"
 
 namespace TQMesh {
 namespace TQAlgorithm {
@@ -46,6 +51,12 @@ public:
 
   virtual bool modify() = 0;
 
+  /*------------------------------------------------------------------
+  | Restore the default settings of this strategy, while its 
+  | internal buffers are kept for subsequent runs
+  ------------------------------------------------------------------*/
+  virtual void reset_settings() {}
+
 protected:
   /*------------------------------------------------------------------
   | Attributes
@@ -129,7 +140,10 @@ private:
       const double b_r = b->facet_r()->min_edge_length();
       const double b_ang = MIN(b_l, b_r);
 
-      return a_ang < b_ang;
+      if ( a_ang != b_ang )
+        return a_ang < b_ang;
+
+      return a->creation_index() < b->creation_index();
     });
 
   } // Tri2QuadStrategy::collect_triangle_edges()
@@ -215,5 +229,909 @@ private:
 }; // Tri2QuadStrategy
 
 
+/*********************************************************************
+* Equalize the vertex valences of quad elements by local topological
+* operations. Irregular vertices are processed from a priority queue
+* with decreasing irregularity, which is the deviation of the number
+* of adjacent quads from the ideal number - which is four for 
+* interior vertices and the interior angle in multiples of 90 degrees
+* for boundary vertices.
+*
+* The following operations are applied:
+* - Doublet removal: Two quads that share two edges are merged 
+*   (see MeshCleanup::clear_double_quad_edges())
+* - Diagonal swap: The edge between two quads is replaced by 
+*   another diagonal of the hexagon spanned by both quads
+* - Vertex split: An interior vertex of high valence is split into
+*   two vertices, which are connected by a new quad
+* - Diagonal collapse: A quad is removed by merging two of its 
+*   opposite interior vertices of low valence
+*
+* An operation is only applied, if it reduces the sum of squared 
+* irregularities. Afterwards, the free vertices of the modified 
+* patch are relaxed and the operation is reverted, if any of the 
+* patch quads is not convex. Vertices that are adjacent to triangles 
+* are not accounted for - thus mixed meshes are only modified within 
+* their quad regions.
+*********************************************************************/
+class ValenceStrategy : public ModificationStrategy
+{
+public:
+
+  using VertexChange  = std::pair<Vertex*,int>;
+  using VertexChanges = std::vector<VertexChange>;
+  using FacetVector   = std::vector<Facet*>;
+  using VertexVector  = std::vector<Vertex*>;
+
+  /*------------------------------------------------------------------
+  |
+  ------------------------------------------------------------------*/
+  ValenceStrategy(Mesh& mesh, const Domain& domain)
+  : ModificationStrategy(mesh, domain) {}
+
+  ~ValenceStrategy() {}
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  double max_angle() const { return max_angle_; }
+  unsigned int relaxation_steps() const { return relaxation_steps_; }
+  std::size_t n_swaps() const { return n_swaps_; }
+  std::size_t n_splits() const { return n_splits_; }
+  std::size_t n_collapses() const { return n_collapses_; }
+  std::size_t n_doublets() const { return n_doublets_; }
+
+  /*------------------------------------------------------------------
+  | Setters 
+  ------------------------------------------------------------------*/
+  ValenceStrategy& max_angle(double a) 
+  { max_angle_ = a; return *this; }
+  ValenceStrategy& relaxation_steps(unsigned int n) 
+  { relaxation_steps_ = n; return *this; }
+
+  /*------------------------------------------------------------------
+  | Restore the default settings
+  ------------------------------------------------------------------*/
+  void reset_settings() override
+  {
+    max_angle_        = 0.9 * M_PI;
+    relaxation_steps_ = 3;
+  }
+
+  /*------------------------------------------------------------------
+  |
+  ------------------------------------------------------------------*/
+  bool modify() override
+  {
+    n_swaps_     = 0;
+    n_splits_    = 0;
+    n_collapses_ = 0;
+    n_doublets_  = 0;
+
+    // Remove doublets
+    const std::size_t n_verts = mesh_->n_vertices();
+    MeshCleanup::clear_double_quad_edges(*mesh_, true);
+    mesh_->clear_waste();
+    n_doublets_ = n_verts - mesh_->n_vertices();
+
+    // Process irregular vertices
+    for ( const auto& v_ptr : mesh_->vertices() )
+      push_vertex( *v_ptr );
+
+    while ( !queue_.empty() )
+    {
+      QueueEntry entry = queue_.top();
+      queue_.pop();
+
+      // Skip outdated entries
+      if ( ABS( irregularity( *entry.v ) ) != entry.key )
+        continue;
+
+      improve_vertex( *entry.v );
+    }
+
+    mesh_->clear_waste();
+
+    MeshCleanup::assign_mesh_indices(*mesh_);
+    MeshCleanup::setup_facet_connectivity(*mesh_);
+
+    return true;
+
+  } // ValenceStrategy::modify()
+
+  /*------------------------------------------------------------------
+  | The irregularity of a vertex - vertices outside of the quad
+  | region are considered as regular
+  ------------------------------------------------------------------*/
+  static inline int irregularity(const Vertex& v)
+  {
+    if ( !in_quad_region(v) )
+      return 0;
+
+    const int n_facets = static_cast<int>( v.facets().size() );
+
+    return n_facets - ideal_valence(v);
+
+  } // ValenceStrategy::irregularity()
+
+protected:
+
+  /*------------------------------------------------------------------
+  | Queue entries with decreasing irregularity - ties are resolved
+  | by the creation index for a deterministic order
+  ------------------------------------------------------------------*/
+  struct QueueEntry
+  {
+    int     key;
+    Vertex* v;
+
+    bool operator<(const QueueEntry& other) const
+    {
+      if ( key != other.key )
+        return key < other.key;
+      return v->creation_index() > other.v->creation_index();
+    }
+  };
+
+  /*------------------------------------------------------------------
+  | A candidate operation:
+  | - Swap:     Swap edge (v,w) to the hexagon diagonal (i,i+3)
+  | - Split:    Split vertex v along its ring vertices (x1,x2), 
+  |             which are k quads apart
+  | - Collapse: Merge vertex w into the opposite vertex v of their
+  |             shared quad
+  |
+  | Operations only refer to vertices, since facets are re-created, 
+  | when an operation is reverted. For the same reason, splits do 
+  | not rely on star indices, as the quads around a vertex may be 
+  | ordered differently after a revert.
+  ------------------------------------------------------------------*/
+  enum class OperationType { Swap, Split, Collapse };
+
+  struct Operation
+  {
+    int           dE    { 0 };
+    OperationType type  { OperationType::Swap };
+    Vertex*       v     { nullptr };
+    Vertex*       w     { nullptr };
+    std::size_t   i     { 0 };
+    std::size_t   k     { 0 };
+    Vertex*       x1    { nullptr };
+    Vertex*       x2    { nullptr };
+  };
+
+  /*------------------------------------------------------------------
+  | The record of an applied operation, which is required to 
+  | revert it 
+  ------------------------------------------------------------------*/
+  struct Patch
+  {
+    std::vector<std::array<Vertex*,4>>    old_quads   {};
+    std::vector<int>                      old_colors  {};
+    std::vector<std::pair<Vertex*,Vertex*>> old_edges {};
+    std::vector<std::pair<Vertex*,Vec2d>> old_coords  {};
+    std::vector<Quad*>                    new_quads   {};
+    std::vector<Edge*>                    new_edges   {};
+    Vertex*                               new_vertex  { nullptr };
+    Vertex*                               old_vertex  { nullptr };
+    VertexVector                          free_verts  {};
+  };
+
+  /*------------------------------------------------------------------
+  | Check if a vertex is only adjacent to quads
+  ------------------------------------------------------------------*/
+  static inline bool in_quad_region(const Vertex& v)
+  {
+    if ( v.facets().size() < 1 )
+      return false;
+
+    for ( const Facet* f : v.facets() )
+      if ( f->n_vertices() != 4 )
+        return false;
+
+    return true;
+
+  } // ValenceStrategy::in_quad_region()
+
+  /*------------------------------------------------------------------
+  | The ideal number of quads adjacent to a vertex
+  ------------------------------------------------------------------*/
+  static inline int ideal_valence(const Vertex& v)
+  {
+    if ( !v.on_boundary() )
+      return 4;
+
+    double angle_sum = 0.0;
+
+    for ( const Facet* f : v.facets() )
+    {
+      const std::size_t n = f->n_vertices();
+      const std::size_t k = f->get_vertex_index(v);
+
+      const Vec2d& xy_prev = f->vertex( (k + n - 1) % n ).xy();
+      const Vec2d& xy_next = f->vertex( (k + 1) % n ).xy();
+
+      angle_sum += angle( xy_prev - v.xy(), xy_next - v.xy() );
+    }
+
+    return MAX( 1, static_cast<int>( std::round( angle_sum / M_PI_2 ) ) );
+
+  } // ValenceStrategy::ideal_valence()
+
+  /*------------------------------------------------------------------
+  | Add an irregular vertex to the queue
+  ------------------------------------------------------------------*/
+  void push_vertex(Vertex& v)
+  {
+    const int key = ABS( irregularity(v) );
+
+    if ( key > 0 )
+      queue_.push( { key, &v } );
+
+  } // ValenceStrategy::push_vertex()
+
+  /*------------------------------------------------------------------
+  | Compute the change of the sum of squared irregularities for 
+  | given changes of the number of adjacent quads. 
+  | Returns false, if the changes result in invalid vertices.
+  ------------------------------------------------------------------*/
+  static inline bool energy_change(const VertexChanges& changes, int& dE)
+  {
+    dE = 0;
+
+    for ( const VertexChange& c : changes )
+    {
+      const Vertex& v = *c.first;
+
+      if ( !in_quad_region(v) )
+        continue;
+
+      const int n_facets = static_cast<int>( v.facets().size() ) + c.second;
+
+      if ( n_facets < ( v.on_boundary() ? 1 : 3 ) )
+        return false;
+
+      const int d = irregularity(v);
+      dE += (d + c.second) * (d + c.second) - d * d;
+    }
+
+    return true;
+
+  } // ValenceStrategy::energy_change()
+
+  /*------------------------------------------------------------------
+  | Check if a facet is convex and if its interior angles are below
+  | the maximum angle
+  ------------------------------------------------------------------*/
+  bool is_valid_facet(const Facet& f) const
+  {
+    const std::size_t n = f.n_vertices();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+      const Vec2d& xy = f.vertex(i).xy();
+      const Vec2d a = f.vertex( (i + n - 1) % n ).xy() - xy;
+      const Vec2d b = f.vertex( (i + 1) % n ).xy() - xy;
+
+      if ( cross(b, a) <= 0.0 || angle(a, b) > max_angle_ )
+        return false;
+    }
+
+    return true;
+
+  } // ValenceStrategy::is_valid_facet()
+
+  /*------------------------------------------------------------------
+  | Get the two quads that are adjacent to the edge (a,b), as well 
+  | as the hexagon (a, r, s, b, p, q) that is spanned by them:
+  |
+  |                q           p
+  |                 x---------x
+  |                 |   q_l   |
+  |                 |         |
+  |               a x-------->x b
+  |                 |         |
+  |                 |   q_r   |
+  |                 x---------x
+  |                r           s
+  |
+  | Returns false if the edge is not located between two quads
+  ------------------------------------------------------------------*/
+  bool get_hexagon(Vertex& a, Vertex& b, Facet*& q_l, Facet*& q_r,
+                   Vertex* hex[6]) const
+  {
+    if ( !mesh_->get_interior_edge(a, b) )
+      return false;
+
+    q_l = nullptr;
+    q_r = nullptr;
+
+    for ( Facet* f : a.facets() )
+    {
+      if ( f->n_vertices() != 4 || f->get_edge_index(a, b) < 0 )
+        continue;
+
+      const std::size_t i_a = f->get_vertex_index(a);
+
+      if ( &f->vertex( (i_a + 1) % 4 ) == &b )
+        q_l = f;
+      else
+        q_r = f;
+    }
+
+    if ( !q_l || !q_r || q_l->color() != q_r->color() )
+      return false;
+
+    const std::size_t i_l = q_l->get_vertex_index(a);
+    const std::size_t i_r = q_r->get_vertex_index(a);
+
+    hex[0] = &a;
+    hex[1] = &q_r->vertex( (i_r + 1) % 4 );
+    hex[2] = &q_r->vertex( (i_r + 2) % 4 );
+    hex[3] = &b;
+    hex[4] = &q_l->vertex( (i_l + 2) % 4 );
+    hex[5] = &q_l->vertex( (i_l + 3) % 4 );
+
+    for ( std::size_t i = 0; i < 6; ++i )
+      for ( std::size_t j = i+1; j < 6; ++j )
+        if ( hex[i] == hex[j] )
+          return false;
+
+    return true;
+
+  } // ValenceStrategy::get_hexagon()
+
+  /*------------------------------------------------------------------
+  | Get the quads around an interior vertex in counter-clockwise 
+  | order, such that quad i spans from ring vertex i to i+1.
+  | Returns false if the vertex is not surrounded by quads.
+  ------------------------------------------------------------------*/
+  static inline bool get_quad_star(Vertex& v, FacetVector& quads,
+                                   VertexVector& ring)
+  {
+    quads.clear();
+    ring.clear();
+
+    if ( v.on_boundary() || !in_quad_region(v) )
+      return false;
+
+    Facet* q = v.facets().front();
+
+    for ( std::size_t n = 0; n < v.facets().size(); ++n )
+    {
+      const std::size_t k = q->get_vertex_index(v);
+      quads.push_back( q );
+      ring.push_back( &q->vertex( (k + 1) % 4 ) );
+
+      // Find the next quad, which starts at the end of the current
+      Vertex* v_next = &q->vertex( (k + 3) % 4 );
+      Facet*  q_next = nullptr;
+
+      for ( Facet* f : v.facets() )
+      {
+        const std::size_t i_f = f->get_vertex_index(v);
+        if ( &f->vertex( (i_f + 1) % 4 ) == v_next )
+          q_next = f;
+      }
+
+      if ( !q_next )
+        return false;
+
+      q = q_next;
+    }
+
+    return ( q == quads.front() );
+
+  } // ValenceStrategy::get_quad_star()
+
+  /*------------------------------------------------------------------
+  | Collect the diagonal swaps of the edge (a,b), which reduce the
+  | irregularity
+  ------------------------------------------------------------------*/
+  void collect_swaps(Vertex& a, Vertex& b)
+  {
+    if ( a.is_fixed() && b.is_fixed() )
+      return;
+
+    Facet* q_l; 
+    Facet* q_r;
+    Vertex* hex[6];
+
+    if ( !get_hexagon(a, b, q_l, q_r, hex) )
+      return;
+
+    // Each edge is only considered in one direction
+    if ( a.creation_index() > b.creation_index() )
+      return;
+
+    for ( std::size_t i = 1; i < 3; ++i )
+    {
+      Vertex& h1 = *hex[i];
+      Vertex& h2 = *hex[i+3];
+
+      if ( mesh_->get_edge(h1, h2) )
+        continue;
+
+      int dE = 0;
+
+      if ( !energy_change( { {&a,-1}, {&b,-1}, {&h1,1}, {&h2,1} }, dE ) )
+        continue;
+
+      if ( dE < 0 )
+        candidates_.push_back( 
+          { dE, OperationType::Swap, &a, &b, i, 0 } );
+    }
+
+  } // ValenceStrategy::collect_swaps()
+
+  /*------------------------------------------------------------------
+  | Collect the splits of an interior vertex v along its ring 
+  | vertices (i,i+k), which reduce the irregularity. The quads from 
+  | i to i+k are attached to a new vertex w, the remaining quads 
+  | stay with v:
+  |
+  |                    x_(i+k)      
+  |                      x
+  |                    /   \     
+  |                 w x     x v       
+  |                    \   /    
+  |                      x   
+  |                     x_i
+  |
+  ------------------------------------------------------------------*/
+  void collect_splits(Vertex& v)
+  {
+    if ( v.is_fixed() || irregularity(v) < 1 )
+      return;
+
+    if ( !get_quad_star(v, star_, ring_) )
+      return;
+
+    const std::size_t n = star_.size();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+      for ( std::size_t k = 2; k + 2 <= n; ++k )
+      {
+        Vertex& x1 = *ring_[i];
+        Vertex& x2 = *ring_[(i + k) % n];
+
+        if ( mesh_->get_edge(x1, x2) )
+          continue;
+
+        const int n_k = static_cast<int>(k);
+        const int d_w = (n_k + 1) - 4;
+
+        int dE = 0;
+
+        if ( !energy_change( { {&v, 1-n_k}, {&x1, 1}, {&x2, 1} }, dE ) )
+          continue;
+
+        dE += d_w * d_w;
+
+        if ( dE < 0 )
+          candidates_.push_back( 
+            { dE, OperationType::Split, &v, nullptr, i, k, &x1, &x2 } );
+      }
+    }
+
+  } // ValenceStrategy::collect_splits()
+
+  /*------------------------------------------------------------------
+  | Collect the collapses of the quads adjacent to vertex v, which 
+  | reduce the irregularity. The opposite vertex c of quad q is 
+  | merged into v, such that q vanishes:
+  |
+  |                    c                     
+  |                    x                    
+  |                  /   \                 
+  |               d x  q  x b    -->    d x---x b    
+  |                  \   /                    v    
+  |                    x                    
+  |                    v                    
+  |
+  ------------------------------------------------------------------*/
+  void collect_collapses(Vertex& v)
+  {
+    if ( v.is_fixed() || v.on_boundary() || !in_quad_region(v) )
+      return;
+
+    for ( Facet* q : v.facets() )
+    {
+      const std::size_t k = q->get_vertex_index(v);
+
+      Vertex& b = q->vertex( (k + 1) % 4 );
+      Vertex& c = q->vertex( (k + 2) % 4 );
+      Vertex& d = q->vertex( (k + 3) % 4 );
+
+      if ( c.is_fixed() || c.on_boundary() || !in_quad_region(c) )
+        continue;
+
+      // Both vertices must only share the neighbors b and d
+      bool shared_neighbor = false;
+
+      for ( Edge* e : c.edges() )
+      {
+        Vertex& x = ( &e->v1() == &c ) ? e->v2() : e->v1();
+        if ( &x != &b && &x != &d && mesh_->get_edge(v, x) )
+          shared_neighbor = true;
+      }
+
+      for ( const Facet* f : c.facets() )
+        if ( f != q && f->get_vertex_index(v) >= 0 )
+          shared_neighbor = true;
+
+      if ( shared_neighbor )
+        continue;
+
+      const int n_c = static_cast<int>( c.facets().size() );
+      const int d_c = irregularity( c );
+
+      int dE = 0;
+
+      if ( !energy_change( { {&v, n_c-2}, {&b,-1}, {&d,-1} }, dE ) )
+        continue;
+
+      dE -= d_c * d_c;
+
+      if ( dE < 0 )
+        candidates_.push_back( 
+          { dE, OperationType::Collapse, &v, &c, 0, 0 } );
+    }
+
+  } // ValenceStrategy::collect_collapses()
+
+  /*------------------------------------------------------------------
+  | Search and apply the best operation for an irregular vertex
+  ------------------------------------------------------------------*/
+  void improve_vertex(Vertex& v)
+  {
+    candidates_.clear();
+
+    // Swaps of all edges of the adjacent quads
+    facets_.assign( v.facets().begin(), v.facets().end() );
+
+    for ( Facet* f : facets_ )
+      for ( std::size_t i = 0; i < 4; ++i )
+        collect_swaps( f->vertex(i), f->vertex( (i+1) % 4 ) );
+
+    collect_splits( v );
+    collect_collapses( v );
+
+    std::stable_sort( candidates_.begin(), candidates_.end(),
+    []( const Operation& a, const Operation& b ) 
+    { return a.dE < b.dE; });
+
+    for ( const Operation& op : candidates_ )
+    {
+      Patch patch {};
+      bool applied = false;
+
+      switch ( op.type )
+      {
+        case OperationType::Swap:     
+          applied = apply_swap( op, patch ); break;
+        case OperationType::Split:    
+          applied = apply_split( op, patch ); break;
+        case OperationType::Collapse: 
+          applied = apply_collapse( op, patch ); break;
+      }
+
+      if ( !applied )
+        continue;
+
+      if ( !relax_patch( patch ) )
+      {
+        revert_patch( patch );
+        continue;
+      }
+
+      if ( patch.old_vertex )
+        mesh_->remove_vertex( *patch.old_vertex );
+
+      switch ( op.type )
+      {
+        case OperationType::Swap:     ++n_swaps_; break;
+        case OperationType::Split:    ++n_splits_; break;
+        case OperationType::Collapse: ++n_collapses_; break;
+      }
+
+      for ( Quad* q : patch.new_quads )
+        for ( std::size_t i = 0; i < 4; ++i )
+          push_vertex( q->vertex(i) );
+
+      return;
+    }
+
+  } // ValenceStrategy::improve_vertex()
+
+  /*------------------------------------------------------------------
+  | Replace the edge (a,b) by the hexagon diagonal (i,i+3).
+  | Returns false if the edge is no longer located between two quads.
+  ------------------------------------------------------------------*/
+  bool apply_swap(const Operation& op, Patch& patch)
+  {
+    Facet* q_l;
+    Facet* q_r;
+    Vertex* hex[6];
+
+    if ( !get_hexagon(*op.v, *op.w, q_l, q_r, hex) )
+      return false;
+
+    const std::size_t i = op.i;
+    const int color = q_l->color();
+
+    remove_edge( *op.v, *op.w, patch );
+    remove_quad( *q_l, patch );
+    remove_quad( *q_r, patch );
+
+    add_quad( { hex[i], hex[i+1], hex[i+2], hex[i+3] }, color, patch );
+    add_quad( { hex[i+3], hex[(i+4)%6], hex[(i+5)%6], hex[i] }, color, 
+              patch );
+    add_edge( *hex[i], *hex[i+3], patch );
+
+    patch.free_verts.assign( hex, hex + 6 );
+
+    return true;
+
+  } // ValenceStrategy::apply_swap()
+
+  /*------------------------------------------------------------------
+  | Split a vertex v along its ring vertices (x1,x2).
+  | The star of v is re-computed and the ring vertices are located
+  | in it. Returns false if they are no longer k quads apart or if 
+  | they have been connected in the meantime.
+  ------------------------------------------------------------------*/
+  bool apply_split(const Operation& op, Patch& patch)
+  {
+    Vertex& v = *op.v;
+
+    if ( !get_quad_star(v, star_, ring_) )
+      return false;
+
+    const std::size_t n = star_.size();
+
+    auto it_1 = std::find( ring_.begin(), ring_.end(), op.x1 );
+    auto it_2 = std::find( ring_.begin(), ring_.end(), op.x2 );
+
+    if ( it_1 == ring_.end() || it_2 == ring_.end() )
+      return false;
+
+    const std::size_t i_1 = std::distance( ring_.begin(), it_1 );
+    const std::size_t i_2 = std::distance( ring_.begin(), it_2 );
+
+    if ( (i_2 + n - i_1) % n != op.k )
+      return false;
+
+    if ( mesh_->get_edge( *op.x1, *op.x2 ) )
+      return false;
+
+    const std::size_t i = i_1;
+    const std::size_t k = op.k;
+    const int color = star_[i]->color();
+
+    // The new vertex is located at the centroid of its quads
+    Vec2d xy_w { 0.0, 0.0 };
+
+    for ( std::size_t j = i; j < i + k; ++j )
+      xy_w += star_[j % n]->xy() / static_cast<double>(k);
+
+    xy_w = 0.5 * ( v.xy() + xy_w );
+
+    Vertex& w = mesh_->add_vertex( xy_w );
+    patch.new_vertex = &w;
+
+    for ( std::size_t j = i; j < i + k; ++j )
+    {
+      Facet* q = star_[j % n];
+      const std::size_t i_v = q->get_vertex_index(v);
+
+      Vertex* q1 = &q->vertex( (i_v + 1) % 4 );
+      Vertex* q2 = &q->vertex( (i_v + 2) % 4 );
+      Vertex* q3 = &q->vertex( (i_v + 3) % 4 );
+      const int q_color = q->color();
+
+      remove_quad( *q, patch );
+      add_quad( { &w, q1, q2, q3 }, q_color, patch );
+    }
+
+    // Edges between v and the inner ring vertices of w are 
+    // reconnected to w
+    for ( std::size_t j = i + 1; j < i + k; ++j )
+      remove_edge( v, *ring_[j % n], patch );
+
+    for ( std::size_t j = i; j <= i + k; ++j )
+      add_edge( w, *ring_[j % n], patch );
+
+    add_quad( { &v, op.x1, &w, op.x2 }, color, patch );
+
+    patch.free_verts = { &v, &w };
+
+    return true;
+
+  } // ValenceStrategy::apply_split()
+
+  /*------------------------------------------------------------------
+  | Collapse a quad by merging vertex w into the opposite vertex v.
+  | The vertex w is only detached from the mesh and removed, once 
+  | the patch turns out to be valid.
+  | Returns false if v and w no longer share a quad.
+  ------------------------------------------------------------------*/
+  bool apply_collapse(const Operation& op, Patch& patch)
+  {
+    Vertex& v = *op.v;
+    Vertex& w = *op.w;
+
+    Facet* q_vw = nullptr;
+
+    for ( Facet* q : v.facets() )
+      if ( q->get_vertex_index(w) >= 0 )
+      {
+        q_vw = q;
+        break;
+      }
+
+    if ( !q_vw )
+      return false;
+
+    remove_quad( *q_vw, patch );
+
+    facets_.assign( w.facets().begin(), w.facets().end() );
+
+    for ( Facet* f : facets_ )
+    {
+      std::array<Vertex*,4> verts {};
+      for ( std::size_t i = 0; i < 4; ++i )
+        verts[i] = ( &f->vertex(i) == &w ) ? &v : &f->vertex(i);
+
+      const int color = f->color();
+      remove_quad( *f, patch );
+      add_quad( verts, color, patch );
+    }
+
+    edges_.assign( w.edges().begin(), w.edges().end() );
+
+    for ( Edge* e : edges_ )
+    {
+      Vertex& x = ( &e->v1() == &w ) ? e->v2() : e->v1();
+
+      remove_edge( w, x, patch );
+
+      if ( !mesh_->get_edge(v, x) )
+        add_edge( v, x, patch );
+    }
+
+    move_vertex( v, 0.5 * (v.xy() + w.xy()), patch );
+
+    patch.old_vertex = &w;
+    patch.free_verts = { &v };
+
+    for ( Edge* e : v.edges() )
+      patch.free_verts.push_back( 
+        ( &e->v1() == &v ) ? &e->v2() : &e->v1() );
+
+    return true;
+
+  } // ValenceStrategy::apply_collapse()
+
+  /*------------------------------------------------------------------
+  | Relax the free vertices of a patch towards the centroids of 
+  | their adjacent facets. Returns true if all facets of the patch
+  | are valid.
+  ------------------------------------------------------------------*/
+  bool relax_patch(Patch& patch)
+  {
+    for ( unsigned int iter = 0; iter < relaxation_steps_; ++iter )
+    {
+      for ( Vertex* v : patch.free_verts )
+      {
+        if ( v->on_boundary() || v->is_fixed() )
+          continue;
+
+        Vec2d xy { 0.0, 0.0 };
+
+        for ( const Facet* f : v->facets() )
+          xy += f->xy();
+
+        xy /= static_cast<double>( v->facets().size() );
+
+        move_vertex( *v, xy, patch );
+      }
+    }
+
+    for ( Vertex* v : patch.free_verts )
+      for ( const Facet* f : v->facets() )
+        if ( !is_valid_facet( *f ) )
+          return false;
+
+    return true;
+
+  } // ValenceStrategy::relax_patch()
+
+  /*------------------------------------------------------------------
+  | Revert all modifications of a patch
+  ------------------------------------------------------------------*/
+  void revert_patch(Patch& patch)
+  {
+    for ( Quad* q : patch.new_quads )
+      mesh_->remove_quad( *q );
+
+    for ( Edge* e : patch.new_edges )
+      mesh_->remove_interior_edge( *e );
+
+    if ( patch.new_vertex )
+      mesh_->remove_vertex( *patch.new_vertex );
+
+    for ( auto it = patch.old_coords.rbegin(); 
+          it != patch.old_coords.rend(); ++it )
+      MeshCleanup::set_vertex_coordinates( *it->first, it->second );
+
+    for ( std::size_t i = 0; i < patch.old_quads.size(); ++i )
+    {
+      const auto& q = patch.old_quads[i];
+      mesh_->add_quad( *q[0], *q[1], *q[2], *q[3], patch.old_colors[i] )
+        .is_active( true );
+    }
+
+    for ( const auto& e : patch.old_edges )
+      mesh_->add_interior_edge( *e.first, *e.second );
+
+  } // ValenceStrategy::revert_patch()
+
+  /*------------------------------------------------------------------
+  | Modifications of the mesh, which are recorded in a patch
+  ------------------------------------------------------------------*/
+  void remove_quad(Facet& q, Patch& patch)
+  {
+    patch.old_quads.push_back( { &q.vertex(0), &q.vertex(1), 
+                                 &q.vertex(2), &q.vertex(3) } );
+    patch.old_colors.push_back( q.color() );
+    mesh_->remove_quad( static_cast<Quad&>(q) );
+  }
+
+  void add_quad(const std::array<Vertex*,4>& v, int color, Patch& patch)
+  {
+    Quad& q = mesh_->add_quad( *v[0], *v[1], *v[2], *v[3], color );
+    q.is_active( true );
+    patch.new_quads.push_back( &q );
+  }
+
+  void remove_edge(Vertex& v1, Vertex& v2, Patch& patch)
+  {
+    Edge* e = mesh_->get_interior_edge( v1, v2 );
+    patch.old_edges.push_back( { &e->v1(), &e->v2() } );
+    mesh_->remove_interior_edge( *e );
+  }
+
+  void add_edge(Vertex& v1, Vertex& v2, Patch& patch)
+  { patch.new_edges.push_back( &mesh_->add_interior_edge( v1, v2 ) ); }
+
+  void move_vertex(Vertex& v, const Vec2d& xy, Patch& patch)
+  {
+    patch.old_coords.push_back( { &v, v.xy() } );
+    MeshCleanup::set_vertex_coordinates( v, xy );
+  }
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  double                          max_angle_        { 0.9 * M_PI };
+  unsigned int                    relaxation_steps_ { 3 };
+
+  std::size_t                     n_swaps_          { 0 };
+  std::size_t                     n_splits_         { 0 };
+  std::size_t                     n_collapses_      { 0 };
+  std::size_t                     n_doublets_       { 0 };
+
+  std::priority_queue<QueueEntry> queue_            {};
+  std::vector<Operation>          candidates_       {};
+  FacetVector                     facets_           {};
+  std::vector<Edge*>              edges_            {};
+  FacetVector                     star_             {};
+  VertexVector                    ring_             {};
+
+}; // ValenceStrategy
+
+
 } // namespace TQAlgorithm
 } // namespace TQMesh
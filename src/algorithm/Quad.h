@@ -266,6 +266,17 @@ public:
                        const double range) const
   { return QuadGeometry::check_intersection(*this, quads, range); }
 
+  /*------------------------------------------------------------------
+  | Returns true if the quad intersects with an edge of a given 
+  | advancing front 
+  | The factor range scales the vicinity range from which 
+  | front edges to pick from
+  ------------------------------------------------------------------*/
+  template <typename Front>
+  bool intersects_front(const Front& front,
+                        const double range) const
+  { return QuadGeometry::check_intersection(*this, front, range); }
+
   /*------------------------------------------------------------------
   | Returns true if a quad edge is too close to a vertex in a given 
   | advancing front 
@@ -276,9 +287,9 @@ public:
   | from a quad edge
   ------------------------------------------------------------------*/
   template <typename Front>
-  bool intersects_front(const Front& front,
-                        const double range) const
-  { return QuadGeometry::check_intersection(*this, front, range); }
+  bool is_too_close(const Front& front, const double range,
+                    const double min_dist_sqr) const
+  { return QuadGeometry::is_too_close(*this, front, range, min_dist_sqr); }
 
   /*------------------------------------------------------------------
   | Returns true if the quad encloses an advancing front vertex.
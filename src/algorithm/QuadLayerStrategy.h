@@ -8,6 +8,9 @@
 #pragma once
 
 #include <vector>
+#include <utility>
+#include <unordered_set>
+#include <algorithm>
 
 #include "utils.h"
 #include "Vertex.h"
@@ -120,6 +123,9 @@ public:
   ------------------------------------------------------------------*/
   void smooth_heights(const Domain& domain)
   {
+    SizeFunctionPhaseScope phase { domain.size_function_profiler(), 
+                                   SizeFunctionPhase::CandidateCreation };
+
     for ( size_t i = 1; i < heights_.size()-1; ++i )
     {
       const double h1 = heights_[i-1];
@@ -525,6 +531,8 @@ class QuadLayerStrategy : public MeshingStrategy
 public:
   using VertexVector   = std::vector<Vertex*>;
   using TriVector      = std::vector<Triangle*>;
+  using IntVector      = std::vector<int>;
+  using LayerEndings   = std::vector<std::pair<Vertex*,Vertex*>>;
 
   /*------------------------------------------------------------------
   | Constructor / Destructor 
@@ -543,6 +551,9 @@ public:
   double angle_factor() const { return angle_factor_; }
   const Vec2d& starting_position() const { return xy_start_; }
   const Vec2d& ending_position() const { return xy_end_; }
+  const IntVector& markers() const { return markers_; }
+  bool triangle_layers() const { return triangle_layers_; }
+  bool check_front() const { return front_update_.check_front(); }
 
   /*------------------------------------------------------------------
   | Setters 
@@ -556,15 +567,52 @@ public:
   QuadLayerStrategy& growth_rate(double r) 
   { growth_rate_ = r; return *this; }
   QuadLayerStrategy& starting_position(const Vec2d& v) 
-  { xy_start_ = v; return *this; }
+  { xy_start_ = v; markers_.clear(); return *this; }
   QuadLayerStrategy& starting_position(double x, double y) 
-  { xy_start_ = {x,y}; return *this; }
+  { xy_start_ = {x,y}; markers_.clear(); return *this; }
   QuadLayerStrategy& ending_position(const Vec2d& v) 
-  { xy_end_ = v; return *this; }
+  { xy_end_ = v; markers_.clear(); return *this; }
   QuadLayerStrategy& ending_position(double x, double y) 
-  { xy_end_ = {x,y}; return *this; }
+  { xy_end_ = {x,y}; markers_.clear(); return *this; }
   QuadLayerStrategy& angle_factor(double a) 
   { angle_factor_ = a; return *this; }
+  QuadLayerStrategy& check_front(bool c) 
+  { front_update_.check_front(c); return *this; }
+
+  /*------------------------------------------------------------------
+  | Generate the quad layers along all boundary edges with the given
+  | markers. If markers are set, the starting and ending positions
+  | are ignored - setting one of these positions clears the markers.
+  ------------------------------------------------------------------*/
+  QuadLayerStrategy& markers(const IntVector& m)
+  { markers_ = m; return *this; }
+
+  /*------------------------------------------------------------------
+  | Emit the layers as pairs of stretched triangles instead of 
+  | quads. The layering, heights and growth are the same as for 
+  | quad layers.
+  ------------------------------------------------------------------*/
+  QuadLayerStrategy& triangle_layers(bool t)
+  { triangle_layers_ = t; return *this; }
+
+  /*------------------------------------------------------------------
+  | Restore the default settings
+  ------------------------------------------------------------------*/
+  void reset_settings() override
+  {
+    MeshingStrategy::reset_settings();
+
+    n_layers_        = 0;
+    first_height_    = 0.0;
+    growth_rate_     = 0.0;
+    triangle_layers_ = false;
+    angle_factor_    = 1.0;
+    xy_start_        = {};
+    xy_end_          = {};
+
+    markers_.clear();
+
+  } // QuadLayerStrategy::reset_settings()
 
 
   /*------------------------------------------------------------------
@@ -584,12 +632,21 @@ public:
     // Remove invalid mesh edges that are no longer needed
     remove_invalid_mesh_edges();
 
+    // Starting and ending vertices of all quad layers
+    LayerEndings endings {};
+
+    if ( markers_.size() > 0 )
+      endings = collect_marker_layer_endings();
+    else
+      endings.push_back( { &front_.get_closest_vertex( xy_start_ ), 
+                           &front_.get_closest_vertex( xy_end_ ) } );
+
     // Perform the actual mesh generation
     double height = first_height_;
-    bool success = true;
-    for ( size_t i_layer = 0; i_layer < n_layers_; ++i_layer)
+    bool success = ( endings.size() > 0 );
+    for ( size_t i_layer = 0; success && i_layer < n_layers_; ++i_layer)
     {
-      success = generate_quad_layer(height);
+      success = generate_quad_layers(endings, height);
 
       if (!success) break;
 
@@ -602,51 +659,131 @@ public:
     // Remove remaining edges from the front
     front_.clear_edges();
 
-    return success;
+    return ( success && front_update_.front_is_valid() );
 
   } // generate_elements()
 
 private:
 
   /*------------------------------------------------------------------
-  | 
+  | Generate one level of quad layers for all given starting and 
+  | ending vertices. The layers are processed one after another, 
+  | since each of them modifies the advancing front and the mesh 
+  | in the vicinity of its neighbours. This way, adjacent walls 
+  | interact in the same way as if their layers were generated 
+  | by separate calls.
   ------------------------------------------------------------------*/
-  bool generate_quad_layer(double height)
+  bool generate_quad_layers(LayerEndings& endings, double height)
   {
-    // Determine the edges in the advancing front, that correspond 
-    // to the current start and ending positions for the quad layer 
-    if ( !find_start_and_ending_edges(xy_start_, xy_end_) )
-      return false;
+    for ( auto& ending : endings )
+    {
+      // Determine the edges in the advancing front, that correspond 
+      // to the current start and ending vertices of the quad layer 
+      if ( !find_start_and_ending_edges(*ending.first, *ending.second) )
+        return false;
+
+      // Create the quad layer structure, which keeps track of the 
+      // target vertex coordinates, that are projected from the base 
+      // vertex coordinates
+      QuadLayerVertices quad_layer_verts { *e_start_, *e_end_, 
+                                            closed_layer_, height,
+                                            angle_factor_ };
+      quad_layer_verts.smooth_heights( domain_ );
+      quad_layer_verts.setup_vertex_projection( mesh_, front_ );
+
+      // For each base edge in the quad layer, try to create a quad
+      // element with its given projected coordinates
+      create_quad_layer( quad_layer_verts );
+
+      // Triangulate the quad layer based edges, where the generation
+      // of quads did not succeed
+      finish_quad_layer( quad_layer_verts );
+
+      // Set new start and ending vertices
+      if ( !find_next_layer_endings( quad_layer_verts, ending ) )
+        return false;
+    }
 
-    // Create the quad layer structure, which keeps track of the target
-    // vertex coordinates, that are projected from the base vertex 
-    // coordinates
-    QuadLayerVertices quad_layer_verts { *e_start_, *e_end_, 
-                                          closed_layer_, height,
-                                          angle_factor_ };
-    quad_layer_verts.smooth_heights( domain_ );
-    quad_layer_verts.setup_vertex_projection( mesh_, front_ );
+    // Remove deleted entities
+    mesh_.clear_waste();
 
-    // For each base edge in the quad layer, try to create a quad
-    // element with its given projected coordinates
-    create_quad_layer( quad_layer_verts );
+    return true;
 
-    // Triangulate the quad layer based edges, where the generation
-    // of quads did not succeed
-    finish_quad_layer( quad_layer_verts );
+  } // generate_quad_layers()
 
-    // Remove deleted entities
-    mesh_.clear_waste();
+  /*------------------------------------------------------------------
+  | Collect the starting and ending vertices of all quad layers, 
+  | that are defined by the selected boundary markers. 
+  | Connected chains of front edges with selected markers are found 
+  | in a single traversal of the front. Chains that cover a complete
+  | front loop lead to closed layers.
+  | This is only done for the first layer level. The endings of all
+  | further levels are taken from the projected vertices of the 
+  | previous level, such that no additional front searches are 
+  | needed.
+  ------------------------------------------------------------------*/
+  LayerEndings collect_marker_layer_endings()
+  {
+    LayerEndings endings {};
+
+    auto selected = [this](const Edge* e)
+    { 
+      return ( e && std::find(markers_.begin(), markers_.end(), 
+                              e->marker()) != markers_.end() );
+    };
+
+    std::unordered_set<const Edge*> visited {};
+
+    // Open chains start at selected edges without selected 
+    // predecessor
+    for ( const auto& e_ptr : front_ )
+    {
+      Edge* e_start = e_ptr.get();
+
+      if ( !selected(e_start) || selected(e_start->get_prev_edge()) )
+        continue;
+
+      Edge* e_end = e_start;
+      visited.insert( e_end );
 
-    // Set new start and ending vertex coordinates
-    return find_next_layer_endings( quad_layer_verts );
+      while ( selected( e_end->get_next_edge() ) )
+      {
+        e_end = e_end->get_next_edge();
+        visited.insert( e_end );
+      }
 
-  } // generate_quad_layer()
+      endings.push_back( { &e_start->v1(), &e_end->v2() } );
+    }
+
+    // Remaining selected edges belong to completely selected loops
+    for ( const auto& e_ptr : front_ )
+    {
+      Edge* e_start = e_ptr.get();
+
+      if ( !selected(e_start) || visited.count(e_start) > 0 )
+        continue;
+
+      Edge* e_cur = e_start;
+
+      do 
+      {
+        visited.insert( e_cur );
+        e_cur = e_cur->get_next_edge();
+      } while ( e_cur && e_cur != e_start );
+
+      endings.push_back( { &e_start->v1(), &e_start->v1() } );
+    }
+
+    return std::move( endings );
+
+  } // QuadLayerStrategy::collect_marker_layer_endings()
 
   /*------------------------------------------------------------------
-  | 
+  | Find the starting and ending vertices of the next quad layer, 
+  | based on the projected vertices of the current one
   ------------------------------------------------------------------*/
-  bool find_next_layer_endings(QuadLayerVertices& quad_layer_verts)
+  bool find_next_layer_endings(QuadLayerVertices& quad_layer_verts,
+                               std::pair<Vertex*,Vertex*>& ending)
   {
     // Search for starting vertex
     Vertex* v1 = nullptr;
@@ -663,7 +800,7 @@ private:
     // Search for ending vertex
     Vertex* v2 = v1;
 
-    if ( !closed_layer_ )
+    if ( !quad_layer_verts.is_closed() )
       for (int i = n-1; i >= 0; --i)
       {
         v2 = quad_layer_verts.v2_proj()[i];
@@ -676,8 +813,8 @@ private:
     if ( !v1 || !v2 )
       return false;
 
-    xy_start_ = v1->xy();
-    xy_end_   = v2->xy();
+    ending.first  = v1;
+    ending.second = v2;
 
     return true;
 
@@ -736,6 +873,8 @@ private:
   |     ---------x-------------x------------x-------
   |            v1_base       v2_base
   |   
+  | Both triangles are merged to a quad, unless triangle layers 
+  | are generated.
   ------------------------------------------------------------------*/
   std::pair<Vertex*, Vertex*>
   create_quad_layer_element(Edge& base,
@@ -775,6 +914,10 @@ private:
     Vertex& v_proj_p2 = t2->v3();
     v_proj.second = &v_proj_p2;
 
+    // Keep both triangles for triangular boundary layers
+    if ( triangle_layers_ )
+      return v_proj;
+
 
     // Merge both triangles t1 & t2 to a quad
     // --> First remove the interior edge between these triangles
@@ -906,16 +1049,10 @@ private:
 
   /*------------------------------------------------------------------
   | Find the starting end ending edge in the advancing front that 
-  | correspond to the currently set start and ending coordinets 
+  | correspond to the given start and ending vertices
   ------------------------------------------------------------------*/
-  bool find_start_and_ending_edges(const Vec2d& xy_start,
-                                   const Vec2d& xy_end)
+  bool find_start_and_ending_edges(Vertex& v_start, Vertex& v_end)
   {
-    // Find closest vertices in current front structure to  
-    // current start and ending vertex coordinates
-    Vertex& v_start = front_.get_closest_vertex( xy_start );
-    Vertex& v_end   = front_.get_closest_vertex( xy_end );
-
     // Get advancing front edges adjacent to input vertices
     Edge* e_start = front_.get_edge(v_start, 1); 
     Edge* e_end   = front_.get_edge(v_end, 2); 
@@ -963,9 +1100,11 @@ private:
   /*------------------------------------------------------------------
   | Attributes
   ------------------------------------------------------------------*/
-  size_t n_layers_     {};
-  double first_height_ {};
-  double growth_rate_  {};
+  size_t    n_layers_     {};
+  double    first_height_ {};
+  double    growth_rate_  {};
+  IntVector markers_      {};
+  bool      triangle_layers_ { false };
 
   // Meshing constants
   double angle_factor_ = 1.0;
@@ -8,6 +8,9 @@
 #pragma once
 
 #include <vector>
+#include <queue>
+#include <utility>
+#include <cmath>
 
 #include "VecND.h"
 
@@ -17,6 +20,7 @@
 #include "Quad.h"
 #include "Mesh.h"
 #include "Domain.h"
+#include "MeshCleanup.h"
 
 namespace TQMesh {
 namespace TQAlgorithm {
@@ -47,6 +51,12 @@ public:
 
   virtual bool refine() = 0;
 
+  /*------------------------------------------------------------------
+  | Restore the default settings of this strategy, while its 
+  | internal buffers are kept for subsequent runs
+  ------------------------------------------------------------------*/
+  virtual void reset_settings() {}
+
 protected:
   /*------------------------------------------------------------------
   | Attributes
@@ -324,5 +334,785 @@ private:
 };
 
 
+/*********************************************************************
+* Delaunay refinement of triangular meshes in the spirit of the
+* algorithms of Chew and Ruppert. Bad triangles are refined by the
+* insertion of a vertex at their circumcenter:
+*
+*   > Quality: The ratio of circumradius to shortest edge exceeds
+*              a given bound B - the default bound B = sqrt(2)
+*              corresponds to a minimum angle of about 20.7 degrees
+*   > Size:    The longest edge exceeds the local size function
+*              times a given factor
+*
+* The bad triangles are processed in a priority queue, starting with
+* the worst triangles. Every new vertex is inserted into the triangle
+* that contains it, which is found by walking from the bad triangle
+* through the facet neighbor connectivity. The Delaunay property is
+* subsequently restored by edge flips. Boundary edges are never
+* flipped, i.e. the mesh is a constrained Delaunay triangulation.
+*
+* A boundary edge is encroached, if a vertex is located within its
+* diametral circle. Encroached boundary edges are split at their
+* midpoint. If the circumcenter of a bad triangle encroaches any
+* boundary edge or if it is located outside of the mesh, the
+* respective boundary edges are split instead and the triangle is
+* refined later on - if it still exists.
+*
+* Since the initial mesh is not necessarily a Delaunay triangulation,
+* it is made Delaunay by edge flips in advance. Small angles between
+* boundary edges might prevent the convergence of the refinement.
+* Therefore, triangles are only refined due to their quality and
+* boundary edges are only split, as long as their edges exceed a
+* given fraction of the size function.
+*
+* Interior edges between triangles of different colors - e.g. the
+* interfaces of merged meshes - are treated like boundary edges:
+* They are never flipped or crossed and they are split at their
+* midpoint if they are encroached. Hence, the colored regions of
+* the mesh are kept.
+* Only pure triangle meshes without twin edges can be refined.
+*********************************************************************/
+class DelaunayRefinementStrategy : public RefinementStrategy
+{
+public:
+
+  using VertexPair  = std::pair<Vertex*,Vertex*>;
+  using VertexPairs = std::vector<VertexPair>;
+
+  /*------------------------------------------------------------------
+  | Constructor
+  ------------------------------------------------------------------*/
+  DelaunayRefinementStrategy(Mesh& mesh, const Domain& domain)
+  : RefinementStrategy(mesh, domain)
+  {}
+
+  ~DelaunayRefinementStrategy() {}
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  double max_radius_edge_ratio() const { return max_ratio_; }
+  double size_factor() const { return size_factor_; }
+  double min_size_factor() const { return min_size_factor_; }
+  std::size_t max_insertions() const { return max_insertions_; }
+  std::size_t n_insertions() const { return n_insertions_; }
+  std::size_t n_boundary_splits() const { return n_bdry_splits_; }
+  std::size_t n_interface_splits() const { return n_intf_splits_; }
+  std::size_t n_flips() const { return n_flips_; }
+
+  /*------------------------------------------------------------------
+  | Setters - <max_insertions> limits the number of new vertices,
+  | including the vertices of split boundary edges
+  ------------------------------------------------------------------*/
+  DelaunayRefinementStrategy& max_radius_edge_ratio(double b)
+  { max_ratio_ = MAX( 1.0, b ); return *this; }
+  DelaunayRefinementStrategy& size_factor(double f)
+  { size_factor_ = f; return *this; }
+  DelaunayRefinementStrategy& min_size_factor(double f)
+  { min_size_factor_ = f; return *this; }
+  DelaunayRefinementStrategy& max_insertions(std::size_t n)
+  { max_insertions_ = n; return *this; }
+
+  /*------------------------------------------------------------------
+  | Restore the default settings
+  ------------------------------------------------------------------*/
+  void reset_settings() override
+  {
+    max_ratio_       = M_SQRT2;
+    size_factor_     = 1.5;
+    min_size_factor_ = 0.1;
+    max_insertions_  = 1000000;
+  }
+
+  /*------------------------------------------------------------------
+  | The actual mesh refinement
+  ------------------------------------------------------------------*/
+  bool refine() override
+  {
+    mesh_->clear_waste();
+
+    n_insertions_  = 0;
+    n_bdry_splits_ = 0;
+    n_intf_splits_ = 0;
+    n_flips_       = 0;
+
+    if ( size_factor_ <= 0.0 )
+      TERMINATE("DelaunayRefinementStrategy::refine(): "
+                "Invalid size factor.");
+
+    // Only triangles can be refined by vertex insertion
+    if ( mesh_->n_quads() > 0 )
+      return false;
+
+    // Check if mesh has any twin edges - only meshes without
+    // twin edges can be refined in order to maintain conformity
+    // between neighboring meshes
+    for ( auto& e_ptr : mesh_->boundary_edges() )
+      if ( e_ptr->twin_edge() )
+        return false;
+
+    MeshCleanup::setup_facet_connectivity( *mesh_ );
+
+    // Boundary and color interface edges are only split, hence their
+    // initial lengths bound the search radius for encroached edges
+    max_constr_len_ = 0.0;
+    has_interfaces_    = false;
+
+    for ( auto& e_ptr : mesh_->boundary_edges() )
+      max_constr_len_ = MAX( max_constr_len_, e_ptr->length() );
+
+    for ( auto& e_ptr : mesh_->interior_edges() )
+      if ( is_color_interface( e_ptr->v1(), e_ptr->v2() ) )
+      {
+        max_constr_len_ = MAX( max_constr_len_, e_ptr->length() );
+        has_interfaces_ = true;
+      }
+
+    // Make the initial mesh Delaunay
+    VertexPairs flips {};
+
+    for ( auto& e_ptr : mesh_->interior_edges() )
+      flips.push_back( { &e_ptr->v1(), &e_ptr->v2() } );
+
+    restore_delaunay( flips );
+
+    // Split all encroached boundary edges
+    for ( auto& e_ptr : mesh_->boundary_edges() )
+    {
+      Triangle* t = adjacent_triangle( e_ptr->v1(), e_ptr->v2() );
+
+      if ( t && encroaches( opposite_vertex( *t, e_ptr->v1(),
+                                             e_ptr->v2() ).xy(),
+                            *e_ptr ) )
+        encroached_.push_back( { &e_ptr->v1(), &e_ptr->v2() } );
+    }
+
+    // Split all encroached color interface edges
+    for ( auto& e_ptr : mesh_->interior_edges() )
+    {
+      Vertex& a = e_ptr->v1();
+      Vertex& b = e_ptr->v2();
+
+      if ( !has_interfaces_ || !is_color_interface( a, b ) )
+        continue;
+
+      Triangle* t1 = adjacent_triangle( a, b );
+      Triangle* t2 = adjacent_triangle( b, a );
+
+      if (  encroaches( opposite_vertex( *t1, a, b ).xy(), *e_ptr )
+         || encroaches( opposite_vertex( *t2, a, b ).xy(), *e_ptr ) )
+        encroached_.push_back( { &a, &b } );
+    }
+
+    split_encroached_edges();
+
+    // Refine all bad triangles
+    queue_ = {};
+
+    for ( auto& t_ptr : mesh_->triangles() )
+      push_triangle( *t_ptr );
+
+    while ( !queue_.empty() && n_new_vertices() < max_insertions_ )
+    {
+      Triangle* t = queue_.top().t;
+      queue_.pop();
+
+      // Skip triangles, that have been removed in the meantime
+      if ( !t->in_container() )
+        continue;
+
+      refine_triangle( *t );
+    }
+
+    queue_ = {};
+    encroached_.clear();
+
+    mesh_->clear_waste();
+
+    MeshCleanup::assign_mesh_indices( *mesh_ );
+    MeshCleanup::setup_facet_connectivity( *mesh_ );
+
+    return true;
+
+  } // DelaunayRefinementStrategy::refine()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Queue entries with decreasing badness - ties are resolved
+  | by the creation index for a deterministic order
+  ------------------------------------------------------------------*/
+  struct QueueEntry
+  {
+    double    key;
+    Triangle* t;
+
+    bool operator<(const QueueEntry& other) const
+    {
+      if ( key != other.key )
+        return key < other.key;
+      return t->creation_index() > other.t->creation_index();
+    }
+  };
+
+  /*------------------------------------------------------------------
+  | The location of a point: The triangle that contains it - or
+  | the boundary or color interface edge (a,b), that separates it
+  | from the region of the start triangle
+  ------------------------------------------------------------------*/
+  struct Location
+  {
+    Triangle* t { nullptr };
+    Vertex*   a { nullptr };
+    Vertex*   b { nullptr };
+  };
+
+  /*------------------------------------------------------------------
+  | An edge of the polygon, that is re-triangulated around a new
+  | vertex, as well as the color of its former triangle
+  ------------------------------------------------------------------*/
+  struct LinkEdge
+  {
+    Vertex* a;
+    Vertex* b;
+    int     color;
+  };
+
+  /*------------------------------------------------------------------
+  | The number of vertices, that have been added to the mesh
+  ------------------------------------------------------------------*/
+  std::size_t n_new_vertices() const
+  { return n_insertions_ + n_bdry_splits_ + n_intf_splits_; }
+
+  /*------------------------------------------------------------------
+  | Add a triangle to the queue, if it is too large or if its
+  | radius-edge ratio exceeds the given bound
+  ------------------------------------------------------------------*/
+  void push_triangle(Triangle& t)
+  {
+    const double h = domain_->size_function( t.xy() );
+
+    double key = t.max_edge_length() / ( size_factor_ * h );
+
+    if ( t.min_edge_length() > min_size_factor_ * h )
+      key = MAX( key, t.circumradius()
+                    / ( max_ratio_ * t.min_edge_length() ) );
+
+    if ( key > 1.0 )
+      queue_.push( { key, &t } );
+
+  } // DelaunayRefinementStrategy::push_triangle()
+
+  /*------------------------------------------------------------------
+  | Refine a bad triangle by the insertion of its circumcenter
+  ------------------------------------------------------------------*/
+  void refine_triangle(Triangle& t)
+  {
+    const Vec2d xy = t.circumcenter();
+
+    Location loc = locate( t, xy );
+
+    VertexPairs encroached {};
+
+    if ( loc.a )
+      encroached.push_back( { loc.a, loc.b } );
+    else if ( !loc.t )
+      return;
+    else
+    {
+      const double r = 0.5 * max_constr_len_;
+
+      for ( Edge* e : mesh_->get_bdry_edges( xy, r ) )
+        if ( encroaches( xy, *e ) )
+          encroached.push_back( { &e->v1(), &e->v2() } );
+
+      if ( has_interfaces_ )
+        for ( Edge* e : mesh_->get_intr_edges( xy, r ) )
+          if (  encroaches( xy, *e )
+             && is_color_interface( e->v1(), e->v2() ) )
+            encroached.push_back( { &e->v1(), &e->v2() } );
+    }
+
+    if ( encroached.size() < 1 )
+    {
+      insert_vertex( *loc.t, xy );
+      split_encroached_edges();
+      return;
+    }
+
+    // Split the constrained edges instead of inserting the circumcenter
+    bool split = false;
+
+    for ( const VertexPair& e : encroached )
+      split |= split_constrained_edge( *e.first, *e.second );
+
+    split_encroached_edges();
+
+    if ( split && t.in_container() )
+      push_triangle( t );
+
+  } // DelaunayRefinementStrategy::refine_triangle()
+
+  /*------------------------------------------------------------------
+  | Walk from a given triangle towards a point. The walk crosses
+  | every triangle edge, that has the point on its right side.
+  | The first edge to check is rotated in every step, in order to
+  | avoid cycles. The walk stops at edges to triangles of another
+  | color.
+  ------------------------------------------------------------------*/
+  Location locate(Triangle& t_start, const Vec2d& xy) const
+  {
+    Triangle* t = &t_start;
+
+    for ( std::size_t step = 0; step <= mesh_->n_triangles(); ++step )
+    {
+      bool inside = true;
+
+      for ( std::size_t j = 0; j < 3 && inside; ++j )
+      {
+        const std::size_t i = ( j + step ) % 3;
+
+        Vertex& a = t->vertex( (i+1) % 3 );
+        Vertex& b = t->vertex( (i+2) % 3 );
+
+        if ( cross( b.xy() - a.xy(), xy - a.xy() ) >= 0.0 )
+          continue;
+
+        Facet* f_nbr = t->neighbor( i );
+
+        if ( NullFacet::is_null( f_nbr ) || f_nbr->color() != t->color() )
+          return { nullptr, &a, &b };
+
+        t = static_cast<Triangle*>( f_nbr );
+        inside = false;
+      }
+
+      if ( inside )
+        return { t, nullptr, nullptr };
+    }
+
+    return {};
+
+  } // DelaunayRefinementStrategy::locate()
+
+  /*------------------------------------------------------------------
+  | Check if a point is located within the diametral circle of
+  | an edge
+  ------------------------------------------------------------------*/
+  static inline bool encroaches(const Vec2d& xy, const Edge& e)
+  { return ( xy - e.xy() ).norm() < 0.5 * e.length() * ( 1.0 - TOLERANCE ); }
+
+  /*------------------------------------------------------------------
+  | The triangle, that contains the edge (a,b) in counter-clockwise
+  | direction - or a nullptr if there is no such triangle
+  ------------------------------------------------------------------*/
+  static inline Triangle* adjacent_triangle(const Vertex& a,
+                                            const Vertex& b)
+  {
+    for ( Facet* f : a.facets() )
+    {
+      if ( f->n_vertices() != 3 )
+        continue;
+
+      const std::size_t k = f->get_vertex_index( a );
+
+      if ( &f->vertex( (k+1) % 3 ) == &b )
+        return static_cast<Triangle*>( f );
+    }
+
+    return nullptr;
+
+  } // DelaunayRefinementStrategy::adjacent_triangle()
+
+  /*------------------------------------------------------------------
+  | Check if the edge (a,b) separates two triangles of different
+  | colors
+  ------------------------------------------------------------------*/
+  static inline bool is_color_interface(const Vertex& a, const Vertex& b)
+  {
+    const Triangle* t1 = adjacent_triangle( a, b );
+    const Triangle* t2 = adjacent_triangle( b, a );
+
+    return t1 && t2 && t1->color() != t2->color();
+
+  } // DelaunayRefinementStrategy::is_color_interface()
+
+  /*------------------------------------------------------------------
+  | Check if the edge (a,b) is a boundary edge or a color interface
+  ------------------------------------------------------------------*/
+  bool is_constrained(const Vertex& a, const Vertex& b) const
+  {
+    if ( mesh_->get_boundary_edge( a, b ) )
+      return true;
+
+    return has_interfaces_ && is_color_interface( a, b );
+
+  } // DelaunayRefinementStrategy::is_constrained()
+
+  /*------------------------------------------------------------------
+  | The vertex of a triangle opposite to its edge (a,b)
+  ------------------------------------------------------------------*/
+  static inline Vertex& opposite_vertex(Triangle& t, const Vertex& a,
+                                        const Vertex& b)
+  { return t.vertex( t.get_edge_index( a, b ) ); }
+
+  /*------------------------------------------------------------------
+  | Update the neighbor connectivity of a new triangle and of its
+  | adjacent triangles
+  ------------------------------------------------------------------*/
+  static inline void link_neighbors(Triangle& t)
+  {
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+      Vertex& a = t.vertex( (i+1) % 3 );
+      Vertex& b = t.vertex( (i+2) % 3 );
+
+      Triangle* t_nbr = adjacent_triangle( b, a );
+
+      if ( !t_nbr )
+      {
+        t.neighbor( i, &NullFacet::get_instance() );
+        continue;
+      }
+
+      t.neighbor( i, t_nbr );
+      t_nbr->neighbor( t_nbr->get_edge_index( a, b ), &t );
+    }
+
+  } // DelaunayRefinementStrategy::link_neighbors()
+
+  /*------------------------------------------------------------------
+  | Insert a new vertex into a triangle, that contains it.
+  | Vertices on an interior edge split the edge and its two
+  | adjacent triangles.
+  ------------------------------------------------------------------*/
+  void insert_vertex(Triangle& t, const Vec2d& xy)
+  {
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+      Vertex& a = t.vertex( (i+1) % 3 );
+      Vertex& b = t.vertex( (i+2) % 3 );
+
+      const Vec2d d = b.xy() - a.xy();
+
+      if ( ABS( cross( d, xy - a.xy() ) ) > TOLERANCE * d.norm_sqr() )
+        continue;
+
+      Edge*     e     = mesh_->get_interior_edge( a, b );
+      Triangle* t_nbr = adjacent_triangle( b, a );
+
+      if ( !e || !t_nbr )
+      {
+        split_boundary_edge( a, b );
+        return;
+      }
+
+      ++n_insertions_;
+
+      split_interior_edge( *e, t, *t_nbr, xy );
+      return;
+    }
+
+    Vertex& v = mesh_->add_vertex( xy );
+
+    std::vector<LinkEdge> link {};
+
+    for ( std::size_t i = 0; i < 3; ++i )
+      link.push_back( { &t.vertex(i), &t.vertex( (i+1) % 3 ), t.color() } );
+
+    mesh_->remove_triangle( t );
+
+    ++n_insertions_;
+
+    retriangulate( v, link );
+
+  } // DelaunayRefinementStrategy::insert_vertex()
+
+  /*------------------------------------------------------------------
+  | Split a boundary edge (a,b) at its midpoint. Returns false, if
+  | the edge does not exist or if it is too short.
+  ------------------------------------------------------------------*/
+  bool split_boundary_edge(Vertex& a, Vertex& b)
+  {
+    Edge* e = mesh_->get_boundary_edge( a, b );
+
+    if ( !e )
+      return false;
+
+    const Vec2d xy = e->xy();
+
+    if ( e->length() < min_size_factor_ * domain_->size_function( xy ) )
+      return false;
+
+    Vertex& v1 = e->v1();
+    Vertex& v2 = e->v2();
+
+    Triangle* t = adjacent_triangle( v1, v2 );
+
+    if ( !t )
+      return false;
+
+    Vertex& c = opposite_vertex( *t, v1, v2 );
+    Vertex& v = mesh_->add_vertex( xy );
+
+    v.add_property( v1.properties() );
+    v.add_property( v2.properties() );
+
+    ASSERT( v.has_property( VertexProperty::on_boundary ),
+      "DelaunayRefinementStrategy::split_boundary_edge(): Missing "
+      "vertex property \"on_boundary\".");
+
+    std::vector<LinkEdge> link { { &v2, &c, t->color() },
+                                 { &c, &v1, t->color() } };
+
+    const int marker = e->marker();
+
+    mesh_->remove_boundary_edge( *e );
+    mesh_->remove_triangle( *t );
+
+    mesh_->boundary_edges().add_edge( v1, v, marker );
+    mesh_->boundary_edges().add_edge( v, v2, marker );
+
+    ++n_bdry_splits_;
+
+    retriangulate( v, link );
+
+    return true;
+
+  } // DelaunayRefinementStrategy::split_boundary_edge()
+
+  /*------------------------------------------------------------------
+  | Split a color interface edge (a,b) at its midpoint. Returns
+  | false, if the edge does not exist or if it is too short.
+  ------------------------------------------------------------------*/
+  bool split_interface_edge(Vertex& a, Vertex& b)
+  {
+    Edge* e = mesh_->get_interior_edge( a, b );
+
+    if ( !e || !is_color_interface( a, b ) )
+      return false;
+
+    const Vec2d xy = e->xy();
+
+    if ( e->length() < min_size_factor_ * domain_->size_function( xy ) )
+      return false;
+
+    Triangle* t1 = adjacent_triangle( a, b );
+    Triangle* t2 = adjacent_triangle( b, a );
+
+    ++n_intf_splits_;
+
+    split_interior_edge( *e, *t1, *t2, xy );
+
+    return true;
+
+  } // DelaunayRefinementStrategy::split_interface_edge()
+
+  /*------------------------------------------------------------------
+  | Split a boundary edge or a color interface edge (a,b)
+  ------------------------------------------------------------------*/
+  bool split_constrained_edge(Vertex& a, Vertex& b)
+  {
+    if ( mesh_->get_boundary_edge( a, b ) )
+      return split_boundary_edge( a, b );
+
+    return split_interface_edge( a, b );
+
+  } // DelaunayRefinementStrategy::split_constrained_edge()
+
+  /*------------------------------------------------------------------
+  | Insert a new vertex at <xy> on the interior edge <e>, which is
+  | shared by the triangles <t1> and <t2>. Both triangles are split
+  | and the new triangles keep the colors of their former triangle.
+  ------------------------------------------------------------------*/
+  void split_interior_edge(Edge& e, Triangle& t1, Triangle& t2,
+                           const Vec2d& xy)
+  {
+    const std::size_t i = t1.get_edge_index( e.v1(), e.v2() );
+
+    Vertex& a = t1.vertex( (i+1) % 3 );
+    Vertex& b = t1.vertex( (i+2) % 3 );
+    Vertex& c = t1.vertex( i );
+    Vertex& o = opposite_vertex( t2, a, b );
+
+    Vertex& v = mesh_->add_vertex( xy );
+
+    std::vector<LinkEdge> link { { &b, &c, t1.color() },
+                                 { &c, &a, t1.color() },
+                                 { &a, &o, t2.color() },
+                                 { &o, &b, t2.color() } };
+
+    mesh_->remove_interior_edge( e );
+    mesh_->remove_triangle( t1 );
+    mesh_->remove_triangle( t2 );
+
+    retriangulate( v, link );
+
+  } // DelaunayRefinementStrategy::split_interior_edge()
+
+  /*------------------------------------------------------------------
+  | Split all boundary and color interface edges, that have been
+  | marked as encroached
+  ------------------------------------------------------------------*/
+  void split_encroached_edges()
+  {
+    while ( !encroached_.empty() && n_new_vertices() < max_insertions_ )
+    {
+      VertexPair e = encroached_.back();
+      encroached_.pop_back();
+
+      split_constrained_edge( *e.first, *e.second );
+    }
+
+    encroached_.clear();
+
+  } // DelaunayRefinementStrategy::split_encroached_edges()
+
+  /*------------------------------------------------------------------
+  | Connect a new vertex to all edges of its surrounding polygon
+  | and restore the Delaunay property by edge flips. Boundary and
+  | color interface edges, that are encroached by the new vertex,
+  | are marked for splitting.
+  ------------------------------------------------------------------*/
+  void retriangulate(Vertex& v, const std::vector<LinkEdge>& link)
+  {
+    std::vector<Triangle*> new_tris {};
+    VertexPairs flips {};
+
+    for ( const LinkEdge& l : link )
+    {
+      new_tris.push_back( &mesh_->add_triangle( v, *l.a, *l.b, l.color ) );
+      flips.push_back( { l.a, l.b } );
+
+      // The vertices of a split boundary edge are already connected
+      // to the new vertex
+      if ( !mesh_->get_edge( v, *l.b ) )
+        mesh_->interior_edges().add_edge( v, *l.b );
+    }
+
+    for ( Triangle* t : new_tris )
+    {
+      link_neighbors( *t );
+      push_triangle( *t );
+    }
+
+    restore_delaunay( flips );
+
+    for ( Facet* f : v.facets() )
+    {
+      Triangle& t = *static_cast<Triangle*>( f );
+
+      const std::size_t k = t.get_vertex_index( v );
+      Vertex& a = t.vertex( (k+1) % 3 );
+      Vertex& b = t.vertex( (k+2) % 3 );
+
+      Edge* e = mesh_->get_edge( a, b );
+
+      if ( e && is_constrained( a, b ) && encroaches( v.xy(), *e ) )
+        encroached_.push_back( { &a, &b } );
+    }
+
+  } // DelaunayRefinementStrategy::retriangulate()
+
+  /*------------------------------------------------------------------
+  | Flip all interior edges of the given stack, which are not
+  | locally Delaunay. The outer edges of flipped edges are checked
+  | subsequently. Edges between triangles of different colors are
+  | never flipped.
+  |
+  |                  b                            b
+  |                  o                            o
+  |                / | \                        /   \
+  |              /   |   \                    /       \
+  |          c o  t1 | t2  o d     ->     c o-----------o d
+  |              \   |   /                    \       /
+  |                \ | /                        \   /
+  |                  o                            o
+  |                  a                            a
+  ------------------------------------------------------------------*/
+  void restore_delaunay(VertexPairs& flips)
+  {
+    while ( !flips.empty() )
+    {
+      Vertex& a = *flips.back().first;
+      Vertex& b = *flips.back().second;
+      flips.pop_back();
+
+      Edge* e = mesh_->get_interior_edge( a, b );
+
+      if ( !e )
+        continue;
+
+      Triangle* t1 = adjacent_triangle( a, b );
+      Triangle* t2 = adjacent_triangle( b, a );
+
+      if ( !t1 || !t2 || t1->color() != t2->color() )
+        continue;
+
+      Vertex& c = opposite_vertex( *t1, a, b );
+      Vertex& d = opposite_vertex( *t2, a, b );
+
+      const double dist = ( d.xy() - t1->circumcenter() ).norm();
+
+      if ( dist >= t1->circumradius() * ( 1.0 - TOLERANCE ) )
+        continue;
+
+      // Only edges of convex quadrilaterals can be flipped
+      if (  !is_left( a.xy(), d.xy(), c.xy() )
+         || !is_left( d.xy(), b.xy(), c.xy() ) )
+        continue;
+
+      const int color_1 = t1->color();
+      const int color_2 = t2->color();
+
+      mesh_->remove_interior_edge( *e );
+      mesh_->remove_triangle( *t1 );
+      mesh_->remove_triangle( *t2 );
+
+      Triangle& t_ac = mesh_->add_triangle( a, d, c, color_1 );
+      Triangle& t_bc = mesh_->add_triangle( d, b, c, color_2 );
+
+      mesh_->interior_edges().add_edge( c, d );
+
+      link_neighbors( t_ac );
+      link_neighbors( t_bc );
+
+      push_triangle( t_ac );
+      push_triangle( t_bc );
+
+      ++n_flips_;
+
+      flips.push_back( { &a, &d } );
+      flips.push_back( { &d, &b } );
+      flips.push_back( { &b, &c } );
+      flips.push_back( { &c, &a } );
+    }
+
+  } // DelaunayRefinementStrategy::restore_delaunay()
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  static constexpr double TOLERANCE = 1.0E-10;
+
+  double                          max_ratio_       { M_SQRT2 };
+  double                          size_factor_     { 1.5 };
+  double                          min_size_factor_ { 0.1 };
+  std::size_t                     max_insertions_  { 1000000 };
+
+  std::size_t                     n_insertions_    { 0 };
+  std::size_t                     n_bdry_splits_   { 0 };
+  std::size_t                     n_intf_splits_   { 0 };
+  std::size_t                     n_flips_         { 0 };
+
+  double                          max_constr_len_  { 0.0 };
+  bool                            has_interfaces_  { false };
+  std::priority_queue<QueueEntry> queue_           {};
+  VertexPairs                     encroached_      {};
+
+}; // DelaunayRefinementStrategy
+
+
 } // namespace TQAlgorithm
 } // namespace TQMesh
@@ -0,0 +1,273 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <array>          // std::array
+#include <vector>         // std::vector
+#include <chrono>         // std::chrono
+#include <ostream>        // std::ostream
+#include <iomanip>        // std::setw, std::setprecision
+#include <cstdint>        // uint8_t
+#include <algorithm>      // std::fill
+
+#include "VecND.h"
+
+#include "utils.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* The meshing phases, to which size function evaluations are
+* attributed
+*********************************************************************/
+enum class SizeFunctionPhase : uint8_t {
+  Other             = 0,
+  FrontRefinement   = 1,
+  CandidateCreation = 2,
+  Ranking           = 3,
+  Smoothing         = 4,
+  Export            = 5,
+};
+
+/*********************************************************************
+* An opt-in profiler for the evaluations of a domain's size function.
+* For every evaluation, the number of calls and the elapsed time are
+* accumulated for the currently active phase. If a heat map has been
+* initialized, the evaluations are also counted on a coarse
+* cartesian grid, in order to locate the regions where the size
+* function is evaluated most.
+*********************************************************************/
+class SizeFunctionProfiler
+{
+public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+
+  static constexpr size_t N_PHASES = 6;
+
+  /*------------------------------------------------------------------
+  | Getter
+  ------------------------------------------------------------------*/
+  bool enabled() const { return enabled_; }
+  SizeFunctionPhase phase() const { return phase_; }
+
+  size_t n_calls(SizeFunctionPhase p) const
+  { return n_calls_[static_cast<size_t>(p)]; }
+  double time(SizeFunctionPhase p) const
+  { return time_[static_cast<size_t>(p)]; }
+
+  const std::vector<size_t>& heat_map() const { return heat_map_; }
+  size_t n_outside_heat_map() const { return n_outside_; }
+
+  /*------------------------------------------------------------------
+  | Get the number of calls and the time of all phases
+  ------------------------------------------------------------------*/
+  size_t n_calls() const
+  {
+    size_t n = 0;
+    for ( size_t n_p : n_calls_ )
+      n += n_p;
+    return n;
+  }
+
+  double time() const
+  {
+    double t = 0.0;
+    for ( double t_p : time_ )
+      t += t_p;
+    return t;
+  }
+
+  /*------------------------------------------------------------------
+  | Setter
+  ------------------------------------------------------------------*/
+  void enable(bool e) { enabled_ = e; }
+  void phase(SizeFunctionPhase p) { phase_ = p; }
+
+  /*------------------------------------------------------------------
+  | Get the name of a phase
+  ------------------------------------------------------------------*/
+  static const char* phase_name(SizeFunctionPhase p)
+  {
+    switch ( p )
+    {
+      case SizeFunctionPhase::FrontRefinement:   return "front refinement";
+      case SizeFunctionPhase::CandidateCreation: return "candidate creation";
+      case SizeFunctionPhase::Ranking:           return "ranking";
+      case SizeFunctionPhase::Smoothing:         return "smoothing";
+      case SizeFunctionPhase::Export:            return "export";
+      default:                                   return "other";
+    }
+  }
+
+  /*------------------------------------------------------------------
+  | Initialize the heat map on a cartesian grid with <Nx> x <Ny> cells
+  ------------------------------------------------------------------*/
+  void init_heat_map(const Vec2d& xy_min, const Vec2d& xy_max,
+                     unsigned int Nx, unsigned int Ny)
+  {
+    if ( Nx < 1 || Ny < 1 || xy_max.x <= xy_min.x || xy_max.y <= xy_min.y )
+      TERMINATE("SizeFunctionProfiler::init_heat_map(): "
+                "Invalid heat map dimensions.");
+
+    xy_min_ = xy_min;
+    xy_max_ = xy_max;
+    Nx_     = Nx;
+    Ny_     = Ny;
+
+    heat_map_.assign( Nx_ * Ny_, 0 );
+    n_outside_ = 0;
+
+  } // SizeFunctionProfiler::init_heat_map()
+
+  /*------------------------------------------------------------------
+  | Reset all counters, but keep the heat map dimensions
+  ------------------------------------------------------------------*/
+  void reset()
+  {
+    n_calls_.fill( 0 );
+    time_.fill( 0.0 );
+    std::fill( heat_map_.begin(), heat_map_.end(), 0 );
+    n_outside_ = 0;
+
+  } // SizeFunctionProfiler::reset()
+
+  /*------------------------------------------------------------------
+  | Record an evaluation at <xy>, which has been started at <t0>
+  ------------------------------------------------------------------*/
+  void record(const Vec2d& xy, const Timepoint& t0)
+  {
+    const double dt
+      = std::chrono::duration<double>( Clock::now() - t0 ).count();
+
+    const size_t i_phase = static_cast<size_t>( phase_ );
+    ++n_calls_[i_phase];
+    time_[i_phase] += dt;
+
+    if ( heat_map_.size() == 0 )
+      return;
+
+    const double fx = (xy.x - xy_min_.x) / (xy_max_.x - xy_min_.x);
+    const double fy = (xy.y - xy_min_.y) / (xy_max_.y - xy_min_.y);
+
+    if ( fx < 0.0 || fx >= 1.0 || fy < 0.0 || fy >= 1.0 )
+    {
+      ++n_outside_;
+      return;
+    }
+
+    const size_t i = static_cast<size_t>( fx * Nx_ );
+    const size_t j = static_cast<size_t>( fy * Ny_ );
+
+    ++heat_map_[ j * Nx_ + i ];
+
+  } // SizeFunctionProfiler::record()
+
+  /*------------------------------------------------------------------
+  | Write the number of calls and the timings of all phases
+  ------------------------------------------------------------------*/
+  void write_report(std::ostream& os) const
+  {
+    os << "SIZE-FUNCTION-PROFILE\n";
+    os << std::setw(20) << std::left << "phase" << std::right
+       << std::setw(12) << "calls"
+       << std::setw(14) << "time [s]"
+       << std::setw(16) << "time/call [us]" << "\n";
+
+    for ( size_t i = 0; i < N_PHASES; ++i )
+    {
+      const SizeFunctionPhase p = static_cast<SizeFunctionPhase>(i);
+      const double t_call = ( n_calls_[i] > 0 )
+        ? 1.0E6 * time_[i] / static_cast<double>(n_calls_[i]) : 0.0;
+
+      os << std::setw(20) << std::left << phase_name(p) << std::right
+         << std::setw(12) << n_calls_[i]
+         << std::setw(14) << std::setprecision(6) << std::fixed
+         << time_[i]
+         << std::setw(16) << std::setprecision(3) << std::fixed
+         << t_call << "\n";
+    }
+
+    os << std::setw(20) << std::left << "total" << std::right
+       << std::setw(12) << n_calls()
+       << std::setw(14) << std::setprecision(6) << std::fixed
+       << time() << "\n";
+
+  } // SizeFunctionProfiler::write_report()
+
+  /*------------------------------------------------------------------
+  | Export the heat map of evaluations - the layout follows
+  | SizeFunction::export_size_function()
+  ------------------------------------------------------------------*/
+  void export_heat_map(std::ostream& os) const
+  {
+    os << "SIZE-FUNCTION-EVALUATIONS "
+       << std::setprecision(5) << std::fixed
+       << xy_min_.x << " " << xy_min_.y << " "
+       << xy_max_.x << " " << xy_max_.y << " "
+       << Nx_ << " " << Ny_ << "\n";
+
+    for ( unsigned int j = 0; j < Ny_; ++j )
+    {
+      for ( unsigned int i = 0; i < Nx_; ++i )
+        os << heat_map_[j * Nx_ + i] << ( (i==Nx_-1) ? "" : "," );
+      os << "\n";
+    }
+
+  } // SizeFunctionProfiler::export_heat_map()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  bool                          enabled_   { false };
+  SizeFunctionPhase             phase_     { SizeFunctionPhase::Other };
+
+  std::array<size_t,N_PHASES>   n_calls_   {};
+  std::array<double,N_PHASES>   time_      {};
+
+  Vec2d                         xy_min_    {};
+  Vec2d                         xy_max_    {};
+  unsigned int                  Nx_        { 0 };
+  unsigned int                  Ny_        { 0 };
+  std::vector<size_t>           heat_map_  {};
+  size_t                        n_outside_ { 0 };
+
+}; // SizeFunctionProfiler
+
+
+/*********************************************************************
+* Sets the phase of a size function profiler for the lifetime of
+* this object and restores the previous phase afterwards
+*********************************************************************/
+class SizeFunctionPhaseScope
+{
+public:
+  SizeFunctionPhaseScope(SizeFunctionProfiler& profiler,
+                         SizeFunctionPhase     phase)
+  : profiler_ { profiler }
+  , prev_phase_ { profiler.phase() }
+  { profiler_.phase( phase ); }
+
+  ~SizeFunctionPhaseScope() { profiler_.phase( prev_phase_ ); }
+
+  SizeFunctionPhaseScope(const SizeFunctionPhaseScope&) = delete;
+  SizeFunctionPhaseScope& operator=(const SizeFunctionPhaseScope&) = delete;
+
+private:
+  SizeFunctionProfiler& profiler_;
+  SizeFunctionPhase     prev_phase_;
+
+}; // SizeFunctionPhaseScope
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
@@ -0,0 +1,300 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <array>          // std::array
+#include <vector>         // std::vector
+#include <ostream>        // std::ostream
+#include <cstdint>        // uint64_t
+#include <unordered_map>  // std::unordered_map
+
+#include "VecND.h"
+
+#include "utils.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* An adaptive quadtree approximation of an expensive user size
+* function. Every cell stores the function values at its corners,
+* which are interpolated bilinearly for any point inside of the cell.
+*
+* A cell is refined, if the function values at its edge midpoints
+* and its centroid deviate from the interpolated values by more than
+* a given relative tolerance - or if its depth is below a given
+* minimum depth. These deviations are stored as error estimate of
+* the cell. Since the children of a refined cell reuse the sampled
+* values, every sampled point is interpolated exactly.
+* Cells at the maximum depth, which do not meet the tolerance, are
+* reported as unresolved.
+*
+* The error estimate relies on the sampled points, hence features
+* of the user function that are smaller than the cells of the
+* minimum depth might be missed.
+* The tree must be re-initialized if the user function is changed.
+*********************************************************************/
+class SizeFunctionTree
+{
+public:
+
+  /*------------------------------------------------------------------
+  | Getter
+  ------------------------------------------------------------------*/
+  bool empty() const { return nodes_.size() == 0; }
+  size_t n_cells() const { return nodes_.size(); }
+  size_t n_leaves() const { return n_leaves_; }
+  size_t n_samples() const { return n_samples_; }
+  size_t n_unresolved_cells() const { return n_unresolved_; }
+  size_t depth() const { return depth_; }
+  double tolerance() const { return tolerance_; }
+  double max_error() const { return max_error_; }
+  const Vec2d& xy_min() const { return xy_min_; }
+  double extent() const { return extent_; }
+
+  /*------------------------------------------------------------------
+  | Remove all cells
+  ------------------------------------------------------------------*/
+  void clear()
+  {
+    nodes_.clear();
+    samples_.clear();
+    n_leaves_     = 0;
+    n_samples_    = 0;
+    n_unresolved_ = 0;
+    depth_        = 0;
+    max_error_    = 0.0;
+
+  } // SizeFunctionTree::clear()
+
+  /*------------------------------------------------------------------
+  | Return true, if a given point is located inside of the tree.
+  | In this case, the interpolated function value is returned
+  | in <h>.
+  ------------------------------------------------------------------*/
+  inline bool lookup(const Vec2d& xy, double& h) const
+  {
+    if ( empty() )
+      return false;
+
+    double fx = (xy.x - xy_min_.x) / extent_;
+    double fy = (xy.y - xy_min_.y) / extent_;
+
+    if ( fx < 0.0 || fy < 0.0 || fx > 1.0 || fy > 1.0 )
+      return false;
+
+    // Descend to the leaf, while keeping the local coordinates
+    const Node* n = &nodes_[0];
+
+    while ( n->child > 0 )
+    {
+      fx *= 2.0;
+      fy *= 2.0;
+
+      const size_t i = ( fx >= 1.0 ) ? 1 : 0;
+      const size_t j = ( fy >= 1.0 ) ? 1 : 0;
+
+      fx -= static_cast<double>(i);
+      fy -= static_cast<double>(j);
+
+      n = &nodes_[n->child + 2*j + i];
+    }
+
+    const std::array<double,4>& f = n->f;
+
+    h = (1.0-fy) * ( (1.0-fx) * f[0] + fx * f[1] )
+      +      fy  * ( (1.0-fx) * f[2] + fx * f[3] );
+
+    return true;
+
+  } // SizeFunctionTree::lookup()
+
+  /*------------------------------------------------------------------
+  | Build the tree for the user function <f> in the square, that
+  | encloses the bounding box [xy_min, xy_max]
+  ------------------------------------------------------------------*/
+  template <typename Function>
+  void init(const Function& f, const Vec2d& xy_min, const Vec2d& xy_max,
+            double tolerance, size_t max_depth, size_t min_depth)
+  {
+    if ( tolerance <= 0.0 )
+      TERMINATE("SizeFunctionTree::init(): Invalid tolerance.");
+
+    if ( max_depth < 1 || max_depth > MAX_DEPTH || min_depth > max_depth )
+      TERMINATE("SizeFunctionTree::init(): Invalid tree depth.");
+
+    clear();
+
+    tolerance_ = tolerance;
+    max_depth_ = max_depth;
+    min_depth_ = min_depth;
+
+    xy_min_ = xy_min;
+    extent_ = MAX( xy_max.x - xy_min.x, xy_max.y - xy_min.y );
+
+    if ( extent_ <= 0.0 )
+      TERMINATE("SizeFunctionTree::init(): Invalid bounding box.");
+
+    // Cells of the maximum depth span two sample intervals,
+    // such that their midpoints can be sampled
+    resolution_ = uint64_t{1} << (max_depth_ + 1);
+
+    nodes_.push_back( {} );
+    refine( f, 0, 0, 0, 0 );
+
+    samples_.clear();
+
+  } // SizeFunctionTree::init()
+
+  /*------------------------------------------------------------------
+  | Write a summary of the tree
+  ------------------------------------------------------------------*/
+  void write(std::ostream& os) const
+  {
+    os << "SIZE-FUNCTION-TREE\n"
+       << "cells:              " << n_cells() << "\n"
+       << "leaves:             " << n_leaves() << "\n"
+       << "depth:              " << depth() << "\n"
+       << "samples:            " << n_samples() << "\n"
+       << "tolerance:          " << tolerance() << "\n"
+       << "max. error:         " << max_error() << "\n"
+       << "unresolved cells:   " << n_unresolved_cells() << "\n";
+  }
+
+private:
+
+  /*------------------------------------------------------------------
+  | A cell of the tree - the corner values are ordered as
+  | (x0,y0), (x1,y0), (x0,y1), (x1,y1) and the children are stored
+  | consecutively in the same order
+  ------------------------------------------------------------------*/
+  struct Node
+  {
+    std::array<double,4> f     { 0.0, 0.0, 0.0, 0.0 };
+    double               error { 0.0 };
+    size_t               child { 0 };
+  };
+
+  /*------------------------------------------------------------------
+  | Sample the user function at a given integer location - every
+  | location is evaluated only once
+  ------------------------------------------------------------------*/
+  template <typename Function>
+  double sample(const Function& f, uint64_t i, uint64_t j)
+  {
+    const uint64_t key = i * (resolution_ + 1) + j;
+
+    auto iter = samples_.find( key );
+    if ( iter != samples_.end() )
+      return iter->second;
+
+    const double scale = extent_ / static_cast<double>(resolution_);
+    const Vec2d xy { xy_min_.x + scale * static_cast<double>(i),
+                     xy_min_.y + scale * static_cast<double>(j) };
+
+    const double h = f( xy );
+
+    if ( h <= 0.0 )
+      TERMINATE("SizeFunctionTree::init(): "
+                "Encountered invalid value (<=0).");
+
+    samples_[key] = h;
+    ++n_samples_;
+
+    return h;
+
+  } // SizeFunctionTree::sample()
+
+  /*------------------------------------------------------------------
+  | Estimate the interpolation error of a cell and refine it if
+  | needed. The cell's lower left corner is located at the integer
+  | location (i,j).
+  ------------------------------------------------------------------*/
+  template <typename Function>
+  void refine(const Function& f, size_t n, size_t depth,
+              uint64_t i, uint64_t j)
+  {
+    const uint64_t s = resolution_ >> depth;
+    const uint64_t m = s / 2;
+
+    std::array<double,4> c { sample(f, i,   j  ), sample(f, i+s, j  ),
+                             sample(f, i,   j+s), sample(f, i+s, j+s) };
+
+    // Compare the sampled midpoint values to their interpolation
+    const std::array<double,5> h_mid { sample(f, i+m, j  ),
+                                       sample(f, i,   j+m),
+                                       sample(f, i+s, j+m),
+                                       sample(f, i+m, j+s),
+                                       sample(f, i+m, j+m) };
+
+    const std::array<double,5> h_int { 0.5  * (c[0] + c[1]),
+                                       0.5  * (c[0] + c[2]),
+                                       0.5  * (c[1] + c[3]),
+                                       0.5  * (c[2] + c[3]),
+                                       0.25 * (c[0] + c[1] + c[2] + c[3]) };
+
+    double error = 0.0;
+    for ( size_t k = 0; k < 5; ++k )
+      error = MAX( error, ABS(h_mid[k] - h_int[k]) / h_mid[k] );
+
+    nodes_[n].f     = c;
+    nodes_[n].error = error;
+
+    depth_ = MAX( depth_, depth );
+
+    const bool refine_cell = ( depth < min_depth_ || error > tolerance_ );
+
+    if ( !refine_cell || depth == max_depth_ )
+    {
+      ++n_leaves_;
+      max_error_ = MAX( max_error_, error );
+
+      if ( error > tolerance_ )
+        ++n_unresolved_;
+
+      return;
+    }
+
+    const size_t child = nodes_.size();
+    nodes_[n].child = child;
+    nodes_.resize( child + 4 );
+
+    refine( f, child,   depth+1, i,   j   );
+    refine( f, child+1, depth+1, i+m, j   );
+    refine( f, child+2, depth+1, i,   j+m );
+    refine( f, child+3, depth+1, i+m, j+m );
+
+  } // SizeFunctionTree::refine()
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  static constexpr size_t MAX_DEPTH = 24;
+
+  Vec2d               xy_min_       {};
+  double              extent_       { 1.0 };
+  double              tolerance_    { 1.0E-2 };
+  size_t              max_depth_    { 0 };
+  size_t              min_depth_    { 0 };
+  uint64_t            resolution_   { 0 };
+
+  std::vector<Node>   nodes_        {};
+  std::unordered_map<uint64_t,double> samples_ {};
+
+  size_t              n_leaves_     { 0 };
+  size_t              n_samples_    { 0 };
+  size_t              n_unresolved_ { 0 };
+  size_t              depth_        { 0 };
+  double              max_error_    { 0.0 };
+
+}; // SizeFunctionTree
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
@@ -53,6 +53,18 @@ public:
   ------------------------------------------------------------------*/
   virtual bool smooth(int iterations) = 0;
 
+  /*------------------------------------------------------------------
+  | Restore the default settings of this strategy, while its 
+  | internal buffers are kept for subsequent runs
+  ------------------------------------------------------------------*/
+  void reset_settings()
+  {
+    eps_                  = 0.75;
+    decay_                = 1.00;
+    quad_layer_smoothing_ = false;
+    angle_factor_         = 0.5;
+  }
+
 protected:
   /*------------------------------------------------------------------
   | This is the general loop for smoothing strategies
@@ -110,24 +122,27 @@ protected:
 
   /*------------------------------------------------------------------
   | Sets up the vertex->vertex connectivity that is needed for the 
-  | smoothing 
+  | smoothing. The neighbor vectors of previous calls are kept, 
+  | such that repeated smoothing passes reuse their memory.
   ------------------------------------------------------------------*/
   void init_vertex_connectivity()
   {
-    // Clear the vertex connectivity container
-    v_conn_.clear();
-
     Vertices& vertices = mesh_->vertices();
 
+    v_conn_.resize( vertices.size() );
+
     // For each vertex, gather all vertices that are connected
     // to it via its adjacent facets
+    std::size_t i_v = 0;
+
     for ( auto& v_ptr : vertices )
     {
-      v_conn_.push_back( { v_ptr.get() ,{} } );
-
-      auto& v_nbrs = v_conn_.back();
+      auto& v_nbrs = v_conn_[i_v++];
       auto& nbrs   = v_nbrs.second;
 
+      v_nbrs.first = v_ptr.get();
+      nbrs.clear();
+
       // Gather neighbors
       for ( auto f : v_ptr->facets() )
       {
@@ -153,7 +168,10 @@ protected:
         const double a1 = std::atan2(dxy1.y, dxy1.x);
         const double a2 = std::atan2(dxy2.y, dxy2.x);
 
-        return ( a1 < a2 );
+        if ( a1 != a2 )
+          return ( a1 < a2 );
+
+        return ( v1->creation_index() < v2->creation_index() );
       });
     }
 
@@ -442,6 +460,9 @@ public:
   ------------------------------------------------------------------*/
   bool smooth(int iterations) override
   {
+    SizeFunctionPhaseScope phase { domain_->size_function_profiler(), 
+                                   SizeFunctionPhase::Smoothing };
+
     init_vertex_connectivity();
 
     collect_dispalcement_directions();
@@ -525,6 +546,9 @@ public:
   ------------------------------------------------------------------*/
   bool smooth(int iterations) override
   {
+    SizeFunctionPhaseScope phase { domain_->size_function_profiler(), 
+                                   SizeFunctionPhase::Smoothing };
+
     init_vertex_connectivity();
 
     collect_dispalcement_directions();
@@ -591,7 +615,10 @@ public:
   | Constructor
   ------------------------------------------------------------------*/
   MixedSmoothingStrategy(Mesh& mesh, const Domain& domain) 
-  : SmoothingStrategy(mesh, domain) {}
+  : SmoothingStrategy(mesh, domain) 
+  , laplace_ { mesh, domain }
+  , torsion_ { mesh, domain }
+  {}
 
   ~MixedSmoothingStrategy() {}
 
@@ -618,14 +645,17 @@ public:
   ------------------------------------------------------------------*/
   bool smooth(int iterations) override
   {
-    LaplaceSmoothingStrategy laplace { *mesh_, *domain_ };
+    SizeFunctionPhaseScope phase { domain_->size_function_profiler(), 
+                                   SizeFunctionPhase::Smoothing };
+
+    LaplaceSmoothingStrategy& laplace = laplace_;
     laplace.epsilon( eps_ );
     laplace.decay( decay_ );
     laplace.quad_layer_smoothing( quad_layer_smoothing_ );
     laplace.init_vertex_connectivity();
     laplace.collect_dispalcement_directions();
 
-    TorsionSmoothingStrategy torsion { *mesh_, *domain_ };
+    TorsionSmoothingStrategy& torsion = torsion_;
     torsion.epsilon( eps_ );
     torsion.decay( decay_ );
     torsion.angle_factor( angle_factor_ );
@@ -655,6 +685,13 @@ protected:
   Vec2d compute_displacement(const VConn& v_conn) const override
   { return {0.0, 0.0}; }
 
+  /*------------------------------------------------------------------
+  | Attributes - the sub-strategies are kept, in order to reuse
+  | their connectivity buffers in subsequent smoothing passes
+  ------------------------------------------------------------------*/
+  LaplaceSmoothingStrategy laplace_;
+  TorsionSmoothingStrategy torsion_;
+
 }; // MixedSmoothingStrategy
 
 } // namespace TQAlgorithm
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <unordered_set>
 
 #include "Vertex.h"
 #include "Edge.h"
@@ -16,6 +18,7 @@
 #include "MeshCleanup.h"
 #include "MeshingStrategy.h"
 #include "EntityChecks.h"
+#include "FrontMonitor.h"
 
 namespace TQMesh {
 namespace TQAlgorithm {
@@ -48,6 +51,16 @@ public:
   double min_cell_quality() const { return front_update_.min_cell_quality(); }
   double max_cell_angle() const { return front_update_.max_cell_angle(); }
   double base_vertex_factor() const { return base_vertex_factor_; }
+  bool check_front() const { return front_update_.check_front(); }
+  const TriangleScore& triangle_score() const 
+  { return front_update_.triangle_score(); }
+  const FrontMonitor& front_monitor() const { return front_monitor_; }
+  FrontMonitor& front_monitor() { return front_monitor_; }
+  bool aborted() const { return aborted_; }
+  size_t n_retreats() const { return retreats_.size(); }
+  size_t max_retreats() const { return max_retreats_; }
+  double retreat_radius_factor() const { return retreat_factor_; }
+  FrontOrder front_order() const { return front_.order(); }
 
   /*------------------------------------------------------------------
   | Setters 
@@ -66,6 +79,34 @@ public:
   { front_update_.max_cell_angle(v); return *this; }
   TriangulationStrategy& base_vertex_factor(double v) 
   { base_vertex_factor_ = v; return *this; }
+  TriangulationStrategy& check_front(bool c) 
+  { front_update_.check_front(c); return *this; }
+  TriangulationStrategy& triangle_score(const TriangleScore& s) 
+  { front_update_.triangle_score(s); return *this; }
+  TriangulationStrategy& max_retreats(size_t n) 
+  { max_retreats_ = n; return *this; }
+  TriangulationStrategy& retreat_radius_factor(double v) 
+  { retreat_factor_ = v; return *this; }
+  TriangulationStrategy& front_order(FrontOrder o) 
+  { front_.order(o); return *this; }
+
+  /*------------------------------------------------------------------
+  | Restore the default settings
+  ------------------------------------------------------------------*/
+  void reset_settings() override
+  {
+    MeshingStrategy::reset_settings();
+
+    n_elements_         = 0;
+    mesh_range_factor_  = 1.0;
+    base_vertex_factor_ = 1.5;
+    wide_search_factor_ = 10.0;
+    max_retreats_       = 0;
+    retreat_factor_     = 2.0;
+
+    front_monitor_      = FrontMonitor {};
+
+  } // TriangulationStrategy::reset_settings()
 
   /*------------------------------------------------------------------
   | Triangulate a given initialized mesh structure
@@ -77,6 +118,9 @@ public:
 
     // Reset counter for generated elements
     n_generated_ = 0;
+    retreats_.clear();
+    aborted_     = false;
+    front_monitor_.reset();
 
     // Prepare the mesh  
     MeshCleanup::setup_facet_connectivity(mesh_);
@@ -91,8 +135,9 @@ public:
     bool success = advancing_front_loop(base_edge, n_elements_);
 
     // In case of a failed meshing attempt, use the exhaustive 
-    // search approach to fill gaps
-    if ( !success )
+    // search approach to fill gaps - unless the front has been 
+    // considered as hopeless
+    if ( !success && !aborted_ )
     {
       int n_remaining = MAX(0, static_cast<int>(n_elements_-n_generated_));
       success = exhaustive_search_loop(base_edge, n_remaining);
@@ -105,14 +150,15 @@ public:
     front_.clear_edges();
 
     // Improve mesh quality
-    if ( EntityChecks::check_mesh_validity(mesh_) ) 
+    if ( EntityChecks::check_mesh_validity(mesh_, 
+                                           MeshCheckMode::EdgeTable) ) 
     {
       MeshCleanup::clear_double_quad_edges(mesh_);
       MeshCleanup::clear_double_triangle_edges(mesh_);
       MeshCleanup::merge_degenerate_triangles(mesh_);
     }
 
-    return success;
+    return ( success && front_update_.front_is_valid() );
 
   } // TriangulationStrategy::generate_elements()
 
@@ -147,7 +193,7 @@ public:
     // Remove remaining edges from the front
     front_.clear_edges();
 
-    return success;
+    return ( success && front_update_.front_is_valid() );
 
   } // TriangulationStrategy::generate_elements_exhaustive()
 
@@ -162,6 +208,9 @@ private:
     // h := sqrt(3) / 2 
     constexpr double h  = 0.8660254038; 
 
+    SizeFunctionPhaseScope phase { domain_.size_function_profiler(), 
+                                   SizeFunctionPhase::CandidateCreation };
+
     const double l1  = base_edge.length() * h * base_vertex_factor_;
     const double l2  = domain_.size_function( base_edge.xy() );
     const double len = MIN(l1, l2);
@@ -192,6 +241,8 @@ private:
       {
         ++n_generated_;
 
+        front_monitor_.record_success();
+
         // Sort front edges after a wide search
         if ( wide_search )
           front_.sort_edges( false );
@@ -209,6 +260,8 @@ private:
       {
         base_edge = front_.set_base_next();
         ++iteration;
+
+        front_monitor_.record_failure();
       }
 
       // All front edges failed to create new elements
@@ -218,6 +271,8 @@ private:
       {
         wide_search = true;
         iteration = 0;
+
+        front_monitor_.record_wide_search(front_, n_generated_);
       }
 
       update_progress_bar();
@@ -231,16 +286,247 @@ private:
       if (n_elements > 0 && n_generated_ == n_elements)
         return true;
 
+      // React on a degenerated front, either by a local retreat
+      // or by aborting the element generation
+      if ( !front_monitor_.is_healthy() && 
+           front_monitor_.reaction() != FrontHealthReaction::None )
+      {
+        if ( front_monitor_.reaction() == FrontHealthReaction::Abort ||
+             !retreat_front() )
+          return abort_element_generation();
+
+        base_edge   = front_.set_base_first();
+        iteration   = 0;
+        wide_search = false;
+        continue;
+      }
+
       // All front edges faild to create new elements, even
       // when using the wide search 
-      // --> Meshing algorithm failed
+      // --> Retreat the front locally and re-advance, or
+      //     let the meshing algorithm fail
       if ( iteration == front_.size() && wide_search )
-        return false;
+      {
+        if ( !retreat_front() )
+          return false;
+
+        base_edge   = front_.set_base_first();
+        iteration   = 0;
+        wide_search = false;
+      }
     }
 
   } // TriangulationStrategy::advancing_front_loop()
 
 
+  /*------------------------------------------------------------------
+  | Abort the element generation due to an unhealthy front and 
+  | report the state of the front
+  ------------------------------------------------------------------*/
+  bool abort_element_generation()
+  {
+    aborted_ = true;
+
+    front_monitor_.evaluate( front_, n_generated_ );
+
+    LOG(WARNING) << "TriangulationStrategy: Aborted the element "
+                 << "generation due to a degenerated advancing front.";
+    if ( WARNING <= LOG_PROPERTIES.level() )
+      front_monitor_.health().write( LOG_PROPERTIES.get_ostream(WARNING) );
+
+    return false;
+
+  } // TriangulationStrategy::abort_element_generation()
+
+  /*------------------------------------------------------------------
+  | Retreat the advancing front around its most degenerated location,
+  | which is the vertex with the smallest front angle among all front
+  | vertices that are adjacent to generated triangles. All triangles
+  | within a radius of <retreat_factor_> times the local front edge 
+  | length are removed and the front is restored along the boundary 
+  | of the removed region. The front edges are then sorted by their 
+  | distance to the retreat location, such that the gap is 
+  | re-advanced first. Repeated retreats at the same location use 
+  | increasing radii. Only successful retreats count towards the 
+  | maximum number of retreats.
+  | Since the front is restored by other means than the front 
+  | update, it is validated entirely afterwards, if front checks
+  | are enabled. Retreats are rare, so this does not affect the 
+  | overall cost.
+  | Returns false if no retreat is possible or if the restored 
+  | front is invalid.
+  ------------------------------------------------------------------*/
+  bool retreat_front()
+  {
+    if ( retreats_.size() >= max_retreats_ )
+      return false;
+
+    // Locate the retreat center
+    const Edge* e_min = nullptr;
+    double alpha_min  = 2.0 * M_PI;
+
+    for ( const auto& e_ptr : front_ )
+    {
+      const Edge* e_next = e_ptr->get_next_edge();
+
+      if ( !e_next || e_ptr->v2().facets().size() < 1 )
+        continue;
+
+      const double alpha = FrontMonitor::front_angle( *e_ptr, *e_next );
+
+      if ( alpha < alpha_min )
+      {
+        alpha_min = alpha;
+        e_min     = e_ptr.get();
+      }
+    }
+
+    if ( !e_min )
+      return false;
+
+    const Vec2d  xy = e_min->v2().xy();
+    const double h  = 0.5 * ( e_min->length() 
+                            + e_min->get_next_edge()->length() );
+
+    double level = 1.0;
+    for ( const auto& r : retreats_ )
+      if ( ( r.first - xy ).norm() <= r.second )
+        level += 1.0;
+
+    const double radius = level * retreat_factor_ * h;
+
+    std::size_t n_removed = remove_triangles( xy, radius );
+
+    if ( n_removed < 1 )
+      return false;
+
+    retreats_.push_back( { xy, radius } );
+
+    n_generated_ = MAX(0, n_generated_ - static_cast<int>(n_removed));
+
+    front_update_.check_modified_front();
+
+    if ( !front_update_.front_is_valid() )
+      return false;
+
+    DEBUG_LOG("RETREAT FRONT AT " << xy << ": REMOVED " 
+              << n_removed << " TRIANGLES");
+
+    front_.sort_edges( xy );
+    front_monitor_.recover();
+
+    return true;
+
+  } // TriangulationStrategy::retreat_front()
+
+  /*------------------------------------------------------------------
+  | Remove all triangles with centroids within a radius around <xy> 
+  | and restore the advancing front along the boundary of the 
+  | removed region. Returns the number of removed triangles.
+  ------------------------------------------------------------------*/
+  std::size_t remove_triangles(const Vec2d& xy, double radius)
+  {
+    TriVector removed = mesh_.triangles().get_items( xy, radius );
+
+    if ( removed.size() < 1 )
+      return 0;
+
+    std::unordered_set<const Facet*> is_removed ( removed.begin(), 
+                                                  removed.end() );
+    VertexVector verts {};
+
+    for ( Triangle* t : removed )
+    {
+      for ( std::size_t i = 0; i < 3; ++i )
+      {
+        Vertex& a = t->vertex(i);
+        Vertex& b = t->vertex( (i+1) % 3 );
+
+        verts.push_back( &a );
+
+        // Get the facet on the opposite side of the edge (a,b)
+        const Facet* nbr = nullptr;
+
+        for ( const Facet* f : a.facets() )
+          if ( f != t && f->get_edge_index(a, b) >= 0 )
+            nbr = f;
+
+        // Both sides are removed 
+        // -> Remove the interior mesh edge
+        if ( nbr && is_removed.count( nbr ) > 0 )
+        {
+          Edge* e = mesh_.get_interior_edge(a, b);
+          if ( e ) 
+            mesh_.remove_interior_edge( *e );
+          continue;
+        }
+
+        // The other side is not meshed yet
+        // -> Remove the front edge
+        Edge* e_front = front_.get_edge(b, a, true);
+
+        if ( e_front )
+        {
+          front_.remove( *e_front );
+          continue;
+        }
+
+        // The other side is meshed or located outside of the domain
+        // -> The edge becomes a front edge
+        Edge* e_bdry = mesh_.get_boundary_edge(a, b);
+
+        if ( e_bdry )
+        {
+          front_.add_edge( a, b, e_bdry->marker() );
+          continue;
+        }
+
+        Edge* e_intr = mesh_.get_interior_edge(a, b);
+        if ( e_intr )
+          mesh_.remove_interior_edge( *e_intr );
+
+        front_.add_edge( a, b );
+      }
+    }
+
+    for ( Triangle* t : removed )
+    {
+      mesh_.add_area( -t->area() );
+      mesh_.remove_triangle( *t );
+    }
+
+    // Remove vertices that are no longer connected to the mesh and
+    // update the front state of the remaining vertices
+    std::sort( verts.begin(), verts.end() );
+    verts.erase( std::unique( verts.begin(), verts.end() ), verts.end() );
+
+    for ( Vertex* v : verts )
+    {
+      bool on_front = false;
+
+      for ( const auto& e : v->edges() )
+        if ( &e->edgelist() == &front_ )
+          on_front = true;
+
+      if (  !on_front && v->facets().size() < 1 
+         && !v->on_boundary() && !v->is_fixed() )
+      {
+        mesh_.remove_vertex( *v );
+        continue;
+      }
+
+      if ( on_front )
+        v->add_property( VertexProperty::on_front );
+      else
+        v->remove_property( VertexProperty::on_front );
+    }
+
+    mesh_.clear_waste();
+
+    return removed.size();
+
+  } // TriangulationStrategy::remove_triangles()
+
   /*------------------------------------------------------------------
   | Triangulate the advancing front using an exhaustive search 
   | approach
@@ -323,6 +609,13 @@ private:
   double base_vertex_factor_ = 1.5;
   double wide_search_factor_ = 10.0;
   int    n_generated_        = 0;
+  bool   aborted_            = false;
+  size_t max_retreats_       = 0;
+  double retreat_factor_     = 2.0;
+
+  std::vector<std::pair<Vec2d,double>> retreats_ {};
+
+  FrontMonitor front_monitor_ {};
 
 }; // TriangulationStrategy
 
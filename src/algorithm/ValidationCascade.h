@@ -0,0 +1,247 @@
+/*
+* This source file is part of the tqmesh library.
+* This code was written by Florian Setzwein in 2022,
+* and is covered under the MIT License
+* Refer to the accompanying documentation for details
+* on usage and license.
+*/
+#pragma once
+
+#include <vector>         // std::vector
+#include <chrono>         // std::chrono
+#include <ostream>        // std::ostream
+#include <iomanip>        // std::setw, std::setprecision
+#include <algorithm>      // std::stable_sort
+#include <numeric>        // std::iota
+#include <initializer_list>
+
+#include "utils.h"
+
+namespace TQMesh {
+namespace TQAlgorithm {
+
+using namespace CppUtils;
+
+/*********************************************************************
+* The statistics of a single check within a validation cascade
+*********************************************************************/
+struct CheckStatistics
+{
+  const char* name        { "" };
+  size_t      n_evaluated { 0 };
+  size_t      n_rejected  { 0 };
+  size_t      n_timed     { 0 };
+  double      time        { 0.0 };
+
+  /*------------------------------------------------------------------
+  | The fraction of evaluated candidates, that were rejected
+  ------------------------------------------------------------------*/
+  double rejection_rate() const
+  {
+    return ( n_evaluated > 0 )
+      ? static_cast<double>(n_rejected) / static_cast<double>(n_evaluated)
+      : 0.0;
+  }
+
+  /*------------------------------------------------------------------
+  | The mean time of an evaluation in seconds, estimated from the
+  | timed evaluations
+  ------------------------------------------------------------------*/
+  double mean_cost() const
+  {
+    return ( n_timed > 0 )
+      ? time / static_cast<double>(n_timed) : 0.0;
+  }
+
+}; // CheckStatistics
+
+
+/*********************************************************************
+* A cascade of checks, which must all be passed by a candidate.
+* The evaluation stops at the first check that rejects the candidate.
+*
+* The first <n_pinned> checks are cheap checks, which are always
+* evaluated first in their given order. All remaining checks are
+* reordered periodically by their rejection rate per unit of
+* evaluation time, such that expensive checks are only evaluated
+* for candidates that have passed the checks that reject most
+* candidates cheaply. Since all checks are independent predicates,
+* the order changes only the cost of the validation, but not its
+* outcome.
+*
+* The reordering is disabled by default, since its gain is small 
+* for the checks of the mesh generation. If it is enabled, only 
+* every <timing_interval>-th evaluation of a check is timed, in 
+* order to keep the clock overhead out of the evaluation loop.
+*********************************************************************/
+class ValidationCascade
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /*------------------------------------------------------------------
+  | Constructor
+  ------------------------------------------------------------------*/
+  ValidationCascade(std::initializer_list<const char*> names,
+                    size_t n_pinned = 0)
+  : n_pinned_ { n_pinned }
+  {
+    for ( const char* name : names )
+    {
+      CheckStatistics s {};
+      s.name = name;
+      stats_.push_back( s );
+    }
+
+    ASSERT( n_pinned_ <= stats_.size(),
+      "ValidationCascade: Invalid number of pinned checks." );
+
+    order_.resize( stats_.size() );
+    std::iota( order_.begin(), order_.end(), 0 );
+  }
+
+  /*------------------------------------------------------------------
+  | Getters
+  ------------------------------------------------------------------*/
+  size_t size() const { return stats_.size(); }
+  size_t n_pinned() const { return n_pinned_; }
+  size_t n_candidates() const { return n_candidates_; }
+  size_t n_rejected() const { return n_rejected_; }
+  bool adaptive() const { return adaptive_; }
+  size_t reorder_interval() const { return reorder_interval_; }
+  size_t timing_interval() const { return timing_interval_; }
+  const std::vector<size_t>& order() const { return order_; }
+  const CheckStatistics& statistics(size_t i) const { return stats_[i]; }
+
+  /*------------------------------------------------------------------
+  | Setters - a non-adaptive cascade keeps its current order and
+  | does not measure evaluation times
+  ------------------------------------------------------------------*/
+  void adaptive(bool a) { adaptive_ = a; }
+  void reorder_interval(size_t n) { reorder_interval_ = MAX(size_t{1}, n); }
+  void timing_interval(size_t n) { timing_interval_ = MAX(size_t{1}, n); }
+
+  /*------------------------------------------------------------------
+  | Reset all statistics and restore the initial order
+  ------------------------------------------------------------------*/
+  void reset()
+  {
+    for ( CheckStatistics& s : stats_ )
+    {
+      s.n_evaluated = 0;
+      s.n_rejected  = 0;
+      s.n_timed     = 0;
+      s.time        = 0.0;
+    }
+
+    std::iota( order_.begin(), order_.end(), 0 );
+    n_candidates_ = 0;
+    n_rejected_   = 0;
+
+  } // ValidationCascade::reset()
+
+  /*------------------------------------------------------------------
+  | Validate a candidate - <check(i)> must return true, if the
+  | candidate passes the i-th check
+  ------------------------------------------------------------------*/
+  template <typename Check>
+  bool run(Check&& check)
+  {
+    ++n_candidates_;
+
+    bool valid = true;
+
+    for ( size_t i : order_ )
+    {
+      CheckStatistics& s = stats_[i];
+      ++s.n_evaluated;
+
+      if ( adaptive_ && i >= n_pinned_ 
+           && ( s.n_evaluated - 1 ) % timing_interval_ == 0 )
+      {
+        const auto t0 = Clock::now();
+        valid = check( i );
+        s.time += std::chrono::duration<double>( Clock::now() - t0 ).count();
+        ++s.n_timed;
+      }
+      else
+        valid = check( i );
+
+      if ( !valid )
+      {
+        ++s.n_rejected;
+        ++n_rejected_;
+        break;
+      }
+    }
+
+    if ( adaptive_ && n_candidates_ % reorder_interval_ == 0 )
+      reorder();
+
+    return valid;
+
+  } // ValidationCascade::run()
+
+  /*------------------------------------------------------------------
+  | Write the per-check rejection rates
+  ------------------------------------------------------------------*/
+  void write(std::ostream& os) const
+  {
+    os << "VALIDATION-CASCADE " << n_candidates_ << " candidates, "
+       << n_rejected_ << " rejected\n";
+
+    for ( size_t i : order_ )
+    {
+      const CheckStatistics& s = stats_[i];
+      os << "  " << std::setw(22) << std::left << s.name << std::right
+         << std::setw(10) << s.n_evaluated << " evaluated "
+         << std::setw(10) << s.n_rejected << " rejected "
+         << std::setw(7) << std::setprecision(2) << std::fixed
+         << 100.0 * s.rejection_rate() << " %";
+
+      if ( i >= n_pinned_ && adaptive_ )
+        os << std::setw(10) << std::setprecision(3)
+           << 1.0E6 * s.mean_cost() << " us";
+
+      os << "\n";
+    }
+
+  } // ValidationCascade::write()
+
+private:
+
+  /*------------------------------------------------------------------
+  | Sort the checks behind the pinned checks by their rejection
+  | rate per unit of evaluation time in descending order
+  ------------------------------------------------------------------*/
+  void reorder()
+  {
+    auto efficiency = [this](size_t i)
+    {
+      const CheckStatistics& s = stats_[i];
+      const double cost = s.mean_cost();
+      return ( cost > 0.0 ) ? s.rejection_rate() / cost : 0.0;
+    };
+
+    std::stable_sort( order_.begin() + n_pinned_, order_.end(),
+    [&efficiency](size_t a, size_t b)
+    { return efficiency(a) > efficiency(b); });
+
+  } // ValidationCascade::reorder()
+
+  /*------------------------------------------------------------------
+  | Attributes
+  ------------------------------------------------------------------*/
+  std::vector<CheckStatistics> stats_            {};
+  std::vector<size_t>          order_            {};
+  size_t                       n_pinned_         { 0 };
+  size_t                       n_candidates_     { 0 };
+  size_t                       n_rejected_       { 0 };
+  size_t                       reorder_interval_ { 256 };
+  size_t                       timing_interval_  { 16 };
+  bool                         adaptive_         { false };
+
+}; // ValidationCascade
+
+} // namespace TQAlgorithm
+} // namespace TQMesh
@@ -176,6 +176,23 @@ private:
         .generate_elements();
     }
 
+    // Create quad layers along all boundary edges with given markers
+    for ( size_t i = 0; i < quad_layer_markers_.size(); ++i )
+    {
+      int      m = quad_layer_markers_[i];
+      int      n = quad_layer_marker_numbers_[i];
+      double   h = quad_layer_marker_heights_[i];
+      double   g = quad_layer_marker_growth_[i];
+
+      mesh_generator_.quad_layer_generation(mesh)
+        .show_progress(true)
+        .n_layers(n)
+        .first_height(h)
+        .growth_rate(g)
+        .markers({m})
+        .generate_elements();
+    }
+
     // Start meshing 
     if ( algorithm_ == "Tri-to-Quad")
     {
@@ -343,6 +360,29 @@ private:
         quad_layer_growth_.push_back( g );
     }
 
+    quad_layer_markers_.clear();
+    quad_layer_marker_numbers_.clear();
+    quad_layer_marker_heights_.clear();
+    quad_layer_marker_growth_.clear();
+
+    while( mesh_reader.query<double>("quad_layer_markers") )
+    {
+      auto para_quad_layers 
+        = mesh_reader.get_parameter<double>("quad_layer_markers");
+      print_parameter<double>(mesh_reader, "quad_layer_markers");
+
+        int    m = static_cast<int>( para_quad_layers.get_value(0) );
+        int    n = static_cast<int>( para_quad_layers.get_value(1) );
+
+        double h = para_quad_layers.get_value(2);
+        double g = para_quad_layers.get_value(3);
+
+        quad_layer_markers_.push_back( m );
+        quad_layer_marker_numbers_.push_back( n );
+        quad_layer_marker_heights_.push_back( h );
+        quad_layer_marker_growth_.push_back( g );
+    }
+
   } // MeshConstruction::init_quad_layers()
 
   /*------------------------------------------------------------------
@@ -858,6 +898,11 @@ private:
   std::vector<double>     quad_layer_heights_  {};
   std::vector<double>     quad_layer_growth_   {};
 
+  std::vector<int>        quad_layer_markers_        {};
+  std::vector<int>        quad_layer_marker_numbers_ {};
+  std::vector<double>     quad_layer_marker_heights_ {};
+  std::vector<double>     quad_layer_marker_growth_  {};
+
   std::string             algorithm_;
   int                     element_color_;
 
@@ -972,6 +1017,9 @@ private:
     mesh_reader.new_vector_parameter<double>(
         "quad_layers", "Add quad layers:", 7);
 
+    mesh_reader.new_vector_parameter<double>(
+        "quad_layer_markers", "Add quad layers at marker:", 4);
+
     mesh_reader.new_matrix_parameter<double>(
         "fixed_vertices", "Define fixed vertices:", "End fixed vertices", 4);
 
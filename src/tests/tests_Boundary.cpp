@@ -20,6 +20,7 @@
 #include "Edge.h"
 #include "Boundary.h"
 #include "Domain.h"
+#include "EntityChecks.h"
 
 namespace BoundaryTests 
 {
@@ -201,6 +202,44 @@ void shapes()
 
 } // shapes()
 
+/*********************************************************************
+* Test EntityChecks::check_domain_validity() for a perforated plate
+*********************************************************************/
+void domain_validity()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 1.0; };
+
+  Domain domain { f, 50.0 };
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  b_ext.set_shape_rectangle( 1, {10.0, 10.0}, 20.0, 20.0 );
+
+  for ( int i = 0; i < 8; ++i )
+    for ( int j = 0; j < 8; ++j )
+    {
+      Boundary& b_int = domain.add_interior_boundary();
+      b_int.set_shape_circle( 2, {1.5 + 2.4*i, 1.5 + 2.4*j}, 0.8, 12 );
+    }
+
+  CHECK( EntityChecks::check_domain_validity(domain) );
+  CHECK( EntityChecks::get_boundary_intersections(domain).size() == 0 );
+
+  // Add a hole that overlaps with two neighboring holes
+  Boundary& b_int = domain.add_interior_boundary();
+  b_int.set_shape_rectangle( 3, {2.7, 1.5}, 2.2, 0.4 );
+
+  CHECK( !EntityChecks::check_domain_validity(domain) );
+
+  // Both long sides of the rectangle cut through both circles 
+  auto intersections = EntityChecks::get_boundary_intersections(domain);
+  CHECK( intersections.size() >= 4 );
+
+  for ( size_t i = 0; i < intersections.size(); ++i )
+    for ( size_t j = i+1; j < intersections.size(); ++j )
+      CHECK( intersections[i] != intersections[j] );
+
+} // domain_validity()
+
 
 } // namespace BoundaryTests
 
@@ -214,5 +253,6 @@ void run_tests_Boundary()
   BoundaryTests::is_inside();
   BoundaryTests::clear_edges();
   BoundaryTests::shapes();
+  BoundaryTests::domain_validity();
 
 } // run_tests_Boundary()
@@ -26,6 +26,7 @@
 #include "Domain.h"
 #include "Front.h"
 #include "Mesh.h"
+#include "EntityChecks.h"
 
 namespace FrontTests 
 {
@@ -385,6 +386,93 @@ void sort_edges()
 
 } // sort_edges()
 
+/*********************************************************************
+* Test the spatially coherent Advacing Front edge order
+*********************************************************************/
+void coherent_order()
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return 0.1 + 0.05 * p.x; };
+
+  Domain domain { f, 10.0 };
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  Boundary& b_int = domain.add_interior_boundary();
+
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex( 10.0,  0.0 );
+  Vertex& v3 = domain.add_vertex( 10.0, 10.0 );
+  Vertex& v4 = domain.add_vertex(  0.0, 10.0 );
+
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  Vertex& v5 = domain.add_vertex(  4.0,  4.0 );
+  Vertex& v6 = domain.add_vertex(  4.0,  6.0 );
+  Vertex& v7 = domain.add_vertex(  6.0,  6.0 );
+  Vertex& v8 = domain.add_vertex(  6.0,  4.0 );
+
+  b_int.add_edge( v5, v6, 2 );
+  b_int.add_edge( v6, v7, 2 );
+  b_int.add_edge( v7, v8, 2 );
+  b_int.add_edge( v8, v5, 2 );
+
+  std::vector<Mesh*> dummy {};
+  FrontInitData front_init_data { domain, dummy };
+
+  Vertices vertices { 10.0 };
+
+  Front front { };
+  front.init_front( domain, front_init_data, vertices );
+
+  // Sum of the distances between consecutive front edges
+  auto traversal_length = [&front]()
+  {
+    double l = 0.0;
+    const Edge* e_prev = nullptr;
+    for ( const auto& e : front )
+    {
+      if ( e_prev )
+        l += ( e->xy() - e_prev->xy() ).norm();
+      e_prev = e.get();
+    }
+    return l;
+  };
+
+  CHECK( front.order() == FrontOrder::Length );
+
+  front.sort_edges( false );
+  const double l_length = traversal_length();
+
+  front.order( FrontOrder::Coherent );
+  front.sort_edges( false );
+  const double l_coherent = traversal_length();
+
+  CHECK( l_coherent < 0.5 * l_length );
+  CHECK( &front.base() == front.begin()->get() );
+
+  // Length classes must be arranged in descending order
+  int length_class = INT32_MAX;
+  for ( const auto& e : front )
+  {
+    CHECK( std::ilogb( e->length() ) <= length_class );
+    length_class = std::ilogb( e->length() );
+  }
+
+  // ... and in ascending order
+  front.sort_edges();
+
+  length_class = INT32_MIN;
+  for ( const auto& e : front )
+  {
+    CHECK( std::ilogb( e->length() ) >= length_class );
+    length_class = std::ilogb( e->length() );
+  }
+
+} // coherent_order()
+
 
 /*********************************************************************
 * Test the Advacing Front edge size
@@ -434,6 +522,157 @@ void edge_size()
 
 } // edge_size()
 
+/*********************************************************************
+* Test the validity checks of the advancing front
+*********************************************************************/
+void front_validity()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 1.0; };
+
+  TestBuilder test_builder { "UnitSquare", f};
+
+  FrontInitData front_init_data { test_builder.domain() };
+  Vertices vertices { 1.5 };
+
+  Front front { }; 
+  front.init_front( test_builder.domain(), front_init_data, vertices );
+
+  CHECK( EntityChecks::check_front_validity(front) );
+
+  // Open front 
+  front.remove( front.edges().front() );
+  CHECK( !EntityChecks::check_front_validity(front) );
+
+  // Closed front with intersecting loops
+  Vertices loop_vertices { 10.0 };
+  Vertex& w1 = loop_vertices.push_back( 0.0, 0.0 );
+  Vertex& w2 = loop_vertices.push_back( 2.0, 0.0 );
+  Vertex& w3 = loop_vertices.push_back( 2.0, 2.0 );
+  Vertex& w4 = loop_vertices.push_back( 0.0, 2.0 );
+  Vertex& w5 = loop_vertices.push_back( 1.0, 1.0 );
+  Vertex& w6 = loop_vertices.push_back( 3.0, 1.0 );
+  Vertex& w7 = loop_vertices.push_back( 3.0, 3.0 );
+  Vertex& w8 = loop_vertices.push_back( 1.0, 3.0 );
+
+  Front loops { };
+  loops.add_edge( w1, w2 );
+  loops.add_edge( w2, w3 );
+  loops.add_edge( w3, w4 );
+  loops.add_edge( w4, w1 );
+  CHECK( EntityChecks::check_front_validity(loops) );
+
+  loops.add_edge( w5, w6 );
+  loops.add_edge( w6, w7 );
+  loops.add_edge( w7, w8 );
+  loops.add_edge( w8, w5 );
+  CHECK( !EntityChecks::check_front_validity(loops) );
+
+  // Clockwise front 
+  Front cw_front { };
+  cw_front.add_edge( w1, w4 );
+  cw_front.add_edge( w4, w3 );
+  cw_front.add_edge( w3, w2 );
+  cw_front.add_edge( w2, w1 );
+  CHECK( !EntityChecks::check_front_validity(cw_front) );
+
+  // Local update check: A new triangle is attached to the first 
+  // loop, while its front edges are only partially updated
+  Front front_a { };
+  front_a.add_edge( w1, w2 );
+  front_a.add_edge( w2, w3 );
+  front_a.add_edge( w3, w4 );
+  front_a.add_edge( w4, w1 );
+
+  Vertex& w9 = loop_vertices.push_back( 1.0, 0.8 );
+  Triangles triangles { 10.0 };
+  Triangle& t_new = triangles.push_back( w1, w2, w9 );
+
+  front_a.remove( *front_a.get_edge( w1, w2, true ) );
+  Edge& e_19 = front_a.add_edge( w1, w9 );
+  CHECK( !EntityChecks::check_front_update(front_a, t_new, {&e_19}, 
+                                           {&w1, &w2, &w9}, 2.0) );
+
+  Edge& e_92 = front_a.add_edge( w9, w2 );
+  CHECK( EntityChecks::check_front_update(front_a, t_new, {&e_19, &e_92}, 
+                                          {&w1, &w2, &w9}, 2.0) );
+
+  // Local update check: The new triangle crosses the front 
+  Vertex& w10 = loop_vertices.push_back( 1.0, 2.5 );
+  Triangle& t_cross = triangles.push_back( w1, w2, w10 );
+
+  front_a.remove( e_19 );
+  front_a.remove( e_92 );
+  Edge& e_1_10 = front_a.add_edge( w1, w10 );
+  Edge& e_10_2 = front_a.add_edge( w10, w2 );
+  CHECK( !EntityChecks::check_front_update(front_a, t_cross, 
+                                           {&e_1_10, &e_10_2}, 
+                                           {&w1, &w2, &w10}, 2.0) );
+
+} // front_validity()
+
+/*********************************************************************
+* Test the boundary edge discretization by adaptive quadrature
+*********************************************************************/
+void edge_quadrature()
+{
+  size_t n_evals = 0;
+
+  for ( const bool graded : { false, true } )
+  {
+    UserSizeFunction f = [&n_evals, graded](const Vec2d& p) 
+    { ++n_evals; return graded ? 0.045 + 0.05*p.x : 0.01; };
+
+    TestBuilder test_builder { "UnitSquare", f };
+    Domain& domain = test_builder.domain();
+
+    FrontInitData front_init_data { domain };
+
+    // Reference discretization by the predictor-corrector march
+    Vertices vertices_pc { 1.5 };
+    Front    front_pc { }; 
+
+    n_evals = 0;
+    front_pc.init_front( domain, front_init_data, vertices_pc );
+    const size_t n_evals_pc = n_evals;
+
+    // Discretization by adaptive quadrature
+    domain.edge_discretization( EdgeDiscretization::Quadrature );
+
+    Vertices vertices_q { 1.5 };
+    Front    front_q { }; 
+
+    n_evals = 0;
+    front_q.init_front( domain, front_init_data, vertices_q );
+    const size_t n_evals_q = n_evals;
+
+    CHECK( EQ(front_q.area(), 1.0) );
+    CHECK( EntityChecks::check_front_validity( front_q ) );
+
+    const size_t n_pc = front_pc.size();
+    const size_t n_q  = front_q.size();
+
+    CHECK( n_pc == n_q );
+
+    // Edge lengths follow the size function
+    for ( const auto& e_ptr : front_q )
+    {
+      const double rho = domain.size_function( e_ptr->xy() );
+      CHECK( ABS(e_ptr->length() - rho) < 0.05 * rho );
+    }
+
+    // Number of evaluations does not scale with the number of edges
+    CHECK( n_evals_q < n_evals_pc / 4 );
+
+    if ( !graded )
+    {
+      CHECK( n_pc == 400 );
+      CHECK( n_q  == 400 );
+      CHECK( n_evals_q == 4 * 15 );
+    }
+  }
+
+} // edge_quadrature()
+
 
 } // namespace FrontTests
 
@@ -467,9 +706,18 @@ void run_tests_Front()
   adjust_logging_output_stream("FrontTests.sort_edges.log");
   FrontTests::sort_edges();
 
+  adjust_logging_output_stream("FrontTests.coherent_order.log");
+  FrontTests::coherent_order();
+
   adjust_logging_output_stream("FrontTests.edge_size.log");
   FrontTests::edge_size();
 
+  adjust_logging_output_stream("FrontTests.front_validity.log");
+  FrontTests::front_validity();
+
+  adjust_logging_output_stream("FrontTests.edge_quadrature.log");
+  FrontTests::edge_quadrature();
+
   // Reset debug logging ostream
   adjust_logging_output_stream("COUT");
 
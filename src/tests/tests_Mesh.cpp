@@ -201,6 +201,7 @@ void quad_layer()
   CHECK( mesh_builder.prepare_mesh(mesh, domain) );
 
   QuadLayerStrategy quad_layer {mesh, domain};
+  quad_layer.check_front( true );
   quad_layer.n_layers( 4 );
   quad_layer.first_height( 0.15 );
   quad_layer.growth_rate( 1.0 );
@@ -210,6 +211,7 @@ void quad_layer()
   CHECK( quad_layer.generate_elements() );
 
   TriangulationStrategy triangulation {mesh, domain};
+  triangulation.check_front( true );
   triangulation.n_elements(0);
   CHECK( triangulation.generate_elements() );
 
@@ -211,6 +211,98 @@ void merge_degenerate_triangles()
 
 } // merge_degenerate_triangles()
 
+/*********************************************************************
+* Test the mesh connectivity check based on the half-edge table
+*********************************************************************/
+void check_mesh_edge_table()
+{
+  int mesh_id = 0;
+  int element_color = 0;
+
+  Mesh mesh { mesh_id, element_color };
+
+  Vertex& v1 = mesh.add_vertex({0.0, 0.0});
+  Vertex& v2 = mesh.add_vertex({3.0, 0.0});
+  Vertex& v3 = mesh.add_vertex({6.0, 0.0});
+  Vertex& v4 = mesh.add_vertex({0.0, 3.0});
+  Vertex& v5 = mesh.add_vertex({3.0, 3.0});
+  Vertex& v6 = mesh.add_vertex({6.0, 3.0});
+
+  mesh.add_quad(v1, v2, v5, v4);
+  mesh.add_triangle(v2, v3, v6);
+  Triangle& t2 = mesh.add_triangle(v2, v6, v5);
+
+  mesh.add_interior_edge(v2, v5);
+  mesh.add_interior_edge(v2, v6);
+
+  mesh.add_boundary_edge(v1, v2, 1);
+  mesh.add_boundary_edge(v2, v3, 1);
+  mesh.add_boundary_edge(v3, v6, 2);
+  mesh.add_boundary_edge(v6, v5, 3);
+  Edge& e_54 = mesh.add_boundary_edge(v5, v4, 3);
+  mesh.add_boundary_edge(v4, v1, 4);
+
+  for ( auto& e_ptr : mesh.boundary_edges() )
+  {
+    e_ptr->v1().add_property( VertexProperty::on_boundary );
+    e_ptr->v2().add_property( VertexProperty::on_boundary );
+  }
+
+  // Both modes must agree for a valid mesh
+  CHECK( EntityChecks::check_mesh_validity(mesh) );
+  CHECK( EntityChecks::check_mesh_validity(mesh, 
+                                           MeshCheckMode::EdgeTable) );
+
+  // Chunk size and number of threads must not affect the result
+  CHECK( EntityChecks::check_mesh_edge_table(mesh, 1) );
+  CHECK( EntityChecks::check_mesh_edge_table(mesh, 1, 1) );
+  CHECK( EntityChecks::check_mesh_edge_table(mesh, 2, 4) );
+
+  // The vertex indices of the mesh are not modified
+  v1.index( 7 );
+  CHECK( EntityChecks::check_mesh_edge_table(mesh, 1, 4) );
+  CHECK( v1.index() == 7 );
+
+  // Facet that is not listed by one of its vertices
+  Facet& q1 = *v1.facets().front();
+  v1.remove_facet( q1 );
+  CHECK( !EntityChecks::check_mesh_validity(mesh, 
+                                            MeshCheckMode::EdgeTable) );
+  v1.add_facet( q1 );
+  CHECK( EntityChecks::check_mesh_validity(mesh, 
+                                           MeshCheckMode::EdgeTable) );
+
+  // Missing boundary edge 
+  mesh.remove_boundary_edge( e_54 );
+  CHECK( !EntityChecks::check_mesh_validity(mesh, 
+                                            MeshCheckMode::EdgeTable) );
+  CHECK( !EntityChecks::check_mesh_edge_table(mesh, 1, 4) );
+  mesh.add_boundary_edge(v5, v4, 3);
+  CHECK( EntityChecks::check_mesh_validity(mesh, 
+                                           MeshCheckMode::EdgeTable) );
+
+  // Duplicate interior edge
+  Edge& e_dbl = mesh.add_interior_edge(v2, v5);
+  CHECK( !EntityChecks::check_mesh_validity(mesh, 
+                                            MeshCheckMode::EdgeTable) );
+  mesh.remove_interior_edge( e_dbl );
+
+  // Non-manifold edge: Third facet at edge (v2,v6)
+  Vertex& v7 = mesh.add_vertex({5.0, 1.0});
+  Triangle& t3 = mesh.add_triangle(v2, v7, v6);
+  CHECK( !EntityChecks::check_mesh_validity(mesh, 
+                                            MeshCheckMode::EdgeTable) );
+  mesh.remove_triangle( t3 );
+  mesh.remove_vertex( v7 );
+
+  // Inconsistent orientation of two adjacent facets
+  mesh.remove_triangle( t2 );
+  mesh.add_triangle(v2, v5, v6);
+  CHECK( !EntityChecks::check_mesh_validity(mesh, 
+                                            MeshCheckMode::EdgeTable) );
+
+} // check_mesh_edge_table()
+
 } // namespace CleanupTests
 
 
@@ -228,6 +320,9 @@ void run_tests_MeshCleanup()
   adjust_logging_output_stream("CleanupTests.merge_degenerate_triangles.log");
   CleanupTests::merge_degenerate_triangles();
 
+  adjust_logging_output_stream("CleanupTests.check_mesh_edge_table.log");
+  CleanupTests::check_mesh_edge_table();
+
   // Reset debug logging ostream
   adjust_logging_output_stream("COUT");
 
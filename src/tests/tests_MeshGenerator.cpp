@@ -7,7 +7,9 @@
 */
 
 #include <iostream>
+#include <fstream>
 #include <cassert>
+#include <cstdint>
 
 #include <TQMeshConfig.h>
 
@@ -28,6 +30,9 @@
 #include "MeshCleanup.h"
 #include "SmoothingStrategy.h"
 #include "EntityChecks.h"
+#include "MeshHighOrder.h"
+#include "MeshColoring.h"
+#include "MeshDual.h"
 
 namespace MeshGeneratorTests 
 {
@@ -147,6 +152,7 @@ void mesh_initializer()
 
   CHECK(
     generator.quad_layer_generation(mesh_1)
+      .check_front( true )
       .n_layers( 1 )
       .first_height( 0.20 )
       .growth_rate( 1.0 )
@@ -155,26 +161,31 @@ void mesh_initializer()
       .generate_elements()
   );
 
-  CHECK( generator.triangulation(mesh_1).generate_elements() );
+  CHECK( generator.triangulation(mesh_1)
+           .check_front( true ).generate_elements() );
   CHECK( mesh_1.n_quads() == 8 );
   CHECK( EntityChecks::check_mesh_validity( mesh_1 ) );
+  CHECK( EntityChecks::check_mesh_validity( mesh_1, 
+                                            MeshCheckMode::EdgeTable ) );
 
 
 
   // Generate mesh 2
   Mesh& mesh_2 = generator.new_mesh( domain_2, 2, 2);
 
-  generator.quad_layer_generation(mesh_2)
-    .n_layers( 1 )
+  auto& quad_layer = generator.quad_layer_generation(mesh_2);
+  quad_layer.n_layers( 1 )
     .first_height( 0.20 )
     .growth_rate( 1.0 )
     .starting_position( 0.0, 0.0 )
     .ending_position( 0.0, 0.0 );
-  CHECK( generator.quad_layer_generation(mesh_2).generate_elements() );
+  CHECK( quad_layer.generate_elements() );
 
   CHECK( generator.triangulation(mesh_2).generate_elements() );
   CHECK( mesh_2.n_quads() == 8 );
   CHECK( EntityChecks::check_mesh_validity( mesh_2 ) );
+  CHECK( EntityChecks::check_mesh_validity( mesh_2, 
+                                            MeshCheckMode::EdgeTable ) );
 
   // Refinement of mesh 1 must fail, since it is connected to 
   // mesh 2
@@ -183,6 +194,8 @@ void mesh_initializer()
   // Merge both meshes
   CHECK( generator.merge_meshes( mesh_1, mesh_2 ) );
   CHECK( EntityChecks::check_mesh_validity( mesh_1 ) );
+  CHECK( EntityChecks::check_mesh_validity( mesh_1, 
+                                            MeshCheckMode::EdgeTable ) );
   CHECK( !generator.is_valid( mesh_2 ) );
 
   //MeshCleanup::merge_triangles_to_quads(mesh_1);
@@ -201,6 +214,8 @@ void mesh_initializer()
 
   // Check mesh validity
   CHECK( EntityChecks::check_mesh_validity( mesh_1 ) );
+  CHECK( EntityChecks::check_mesh_validity( mesh_1, 
+                                            MeshCheckMode::EdgeTable ) );
 
   // Write mesh to vtu file
   std::string source_directory { TQMESH_SOURCE_DIR };
@@ -330,6 +345,1817 @@ void multiple_neighbors()
 
 } // multiple_neighbors()
 
+/*********************************************************************
+* Compute a FNV-1a checksum of a file's content
+*********************************************************************/
+static inline uint64_t file_checksum(const std::string& filename)
+{
+  std::ifstream infile( filename, std::ios::binary );
+
+  uint64_t hash = 14695981039346656037ULL;
+  char c;
+
+  while ( infile.get(c) )
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+
+} // file_checksum()
+
+/*********************************************************************
+* Generate a mixed mesh with the given quadtree parameters, export 
+* it and return the checksums of the TXT and VTU output
+*********************************************************************/
+static inline std::pair<uint64_t,uint64_t> 
+generate_checksum_mesh(const std::string& name,
+                       double quadtree_scale, size_t quadtree_items)
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return 0.4 + 0.05*p.x; };
+
+  Domain domain { f, quadtree_scale, quadtree_items };
+
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex(  5.0,  0.0 );
+  Vertex& v3 = domain.add_vertex(  5.0,  5.0 );
+  Vertex& v4 = domain.add_vertex(  0.0,  5.0 );
+
+  Vertex& v5 = domain.add_vertex(  2.0,  2.0 );
+  Vertex& v6 = domain.add_vertex(  2.0,  3.0 );
+  Vertex& v7 = domain.add_vertex(  3.0,  3.0 );
+  Vertex& v8 = domain.add_vertex(  3.0,  2.0 );
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  Boundary& b_int = domain.add_interior_boundary();
+  b_int.add_edge( v5, v6, 2 );
+  b_int.add_edge( v6, v7, 2 );
+  b_int.add_edge( v7, v8, 2 );
+  b_int.add_edge( v8, v5, 2 );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  CHECK( generator.quad_layer_generation(mesh)
+           .n_layers( 2 )
+           .first_height( 0.1 )
+           .growth_rate( 1.5 )
+           .starting_position( 2.0, 2.0 )
+           .ending_position( 2.0, 2.0 )
+           .generate_elements() );
+
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh).modify() );
+  CHECK( generator.mixed_smoothing(mesh).smooth(2) );
+
+  std::string source_dir { TQMESH_SOURCE_DIR };
+  std::string filepath 
+  { source_dir + "/auxiliary/test_data/MeshGeneratorTests." + name };
+
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::TXT ) );
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::VTU ) );
+
+  return { file_checksum( filepath + ".txt" ), 
+           file_checksum( filepath + ".vtu" ) };
+
+} // generate_checksum_mesh()
+
+/*********************************************************************
+* Test that the mesh output does not depend on memory addresses or 
+* the structure of the underlying quadtrees
+*********************************************************************/
+void deterministic_output()
+{
+  auto ref = generate_checksum_mesh("deterministic_output_1", 10.0, 50);
+
+  // Same input, but with different memory layout
+  std::vector<std::unique_ptr<double[]>> padding {};
+  for ( size_t i = 0; i < 100; ++i )
+    padding.push_back( std::make_unique<double[]>( 7*i+1 ) );
+
+  auto run = generate_checksum_mesh("deterministic_output_2", 10.0, 50);
+
+  CHECK( run.first == ref.first );
+  CHECK( run.second == ref.second );
+
+  // Same input, but with different quadtree structure
+  run = generate_checksum_mesh("deterministic_output_3", 20.0, 4);
+
+  CHECK( run.first == ref.first );
+  CHECK( run.second == ref.second );
+
+} // deterministic_output()
+
+/*********************************************************************
+* Create a tube bank domain, where the bottom wall and the three 
+* tubes are marked with 5, 2, 3 and 4
+*********************************************************************/
+static inline void build_tube_bank(Domain& domain)
+{
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex( 10.0,  0.0 );
+  Vertex& v3 = domain.add_vertex( 10.0,  6.0 );
+  Vertex& v4 = domain.add_vertex(  0.0,  6.0 );
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  b_ext.add_edge( v1, v2, 5 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  for ( int i = 0; i < 3; ++i )
+  {
+    const double x = 1.5 + 3.0 * i;
+
+    Vertex& w1 = domain.add_vertex( x,     2.5 );
+    Vertex& w2 = domain.add_vertex( x,     3.5 );
+    Vertex& w3 = domain.add_vertex( x+1.0, 3.5 );
+    Vertex& w4 = domain.add_vertex( x+1.0, 2.5 );
+
+    Boundary& b_int = domain.add_interior_boundary();
+    b_int.add_edge( w1, w2, 2+i );
+    b_int.add_edge( w2, w3, 2+i );
+    b_int.add_edge( w3, w4, 2+i );
+    b_int.add_edge( w4, w1, 2+i );
+  }
+
+} // build_tube_bank()
+
+/*********************************************************************
+* Test the generation of quad layers for several boundary markers 
+* at once
+*********************************************************************/
+void quad_layer_markers()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.4; };
+
+  // Quad layers for all walls at once
+  Domain domain_all { f, 20.0 };
+  build_tube_bank( domain_all );
+
+  MeshGenerator generator_all {};
+  Mesh& mesh_all = generator_all.new_mesh( domain_all );
+
+  CHECK( generator_all.quad_layer_generation(mesh_all)
+           .markers( {2, 3, 4, 5} )
+           .n_layers( 2 )
+           .first_height( 0.1 )
+           .growth_rate( 1.5 )
+           .generate_elements() );
+
+  // Quad layers for each wall separately
+  Domain domain_seq { f, 20.0 };
+  build_tube_bank( domain_seq );
+
+  MeshGenerator generator_seq {};
+  Mesh& mesh_seq = generator_seq.new_mesh( domain_seq );
+
+  const std::vector<std::pair<Vec2d,Vec2d>> endings 
+  { { {1.5, 2.5}, {1.5, 2.5} }, 
+    { {4.5, 2.5}, {4.5, 2.5} }, 
+    { {7.5, 2.5}, {7.5, 2.5} }, 
+    { {0.0, 0.0}, {10.0, 0.0} } };
+
+  for ( const auto& ending : endings )
+    CHECK( generator_seq.quad_layer_generation(mesh_seq)
+             .n_layers( 2 )
+             .first_height( 0.1 )
+             .growth_rate( 1.5 )
+             .starting_position( ending.first )
+             .ending_position( ending.second )
+             .generate_elements() );
+
+  CHECK( mesh_all.n_quads() > 0 );
+  CHECK( mesh_all.n_quads() == mesh_seq.n_quads() );
+  CHECK( mesh_all.n_triangles() == mesh_seq.n_triangles() );
+
+  CHECK( generator_all.triangulation(mesh_all).generate_elements() );
+  CHECK( EntityChecks::check_mesh_validity( mesh_all ) );
+
+  // Markers without any front edges do not create layers
+  Domain domain_none { f, 20.0 };
+  build_tube_bank( domain_none );
+
+  MeshGenerator generator_none {};
+  Mesh& mesh_none = generator_none.new_mesh( domain_none );
+
+  CHECK( !generator_none.quad_layer_generation(mesh_none)
+            .markers( {7} )
+            .n_layers( 1 )
+            .first_height( 0.1 )
+            .growth_rate( 1.0 )
+            .generate_elements() );
+  CHECK( mesh_none.n_quads() == 0 );
+
+} // quad_layer_markers()
+
+/*********************************************************************
+* Create a rectangular domain, whose bottom wall is split into 
+* two walls with markers 2 and 3, that are separated by a single 
+* short edge 
+*********************************************************************/
+static inline void build_adjacent_walls(Domain& domain)
+{
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex(  4.0,  0.0 );
+  Vertex& v3 = domain.add_vertex(  4.4,  0.0 );
+  Vertex& v4 = domain.add_vertex( 10.0,  0.0 );
+  Vertex& v5 = domain.add_vertex( 10.0,  6.0 );
+  Vertex& v6 = domain.add_vertex(  0.0,  6.0 );
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  b_ext.add_edge( v1, v2, 2 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 3 );
+  b_ext.add_edge( v4, v5, 3 );
+  b_ext.add_edge( v5, v6, 1 );
+  b_ext.add_edge( v6, v1, 1 );
+
+} // build_adjacent_walls()
+
+/*********************************************************************
+* Test the generation of quad layers for two adjacent walls, that 
+* are only separated by a single front edge
+*********************************************************************/
+void quad_layer_adjacent_walls()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.4; };
+
+  // Single quad layer for both walls at once
+  Domain domain_all { f, 20.0 };
+  build_adjacent_walls( domain_all );
+
+  MeshGenerator generator_all {};
+  Mesh& mesh_all = generator_all.new_mesh( domain_all );
+
+  CHECK( generator_all.quad_layer_generation(mesh_all)
+           .markers( {2, 3} )
+           .n_layers( 1 )
+           .first_height( 0.2 )
+           .growth_rate( 1.0 )
+           .generate_elements() );
+
+  // Single quad layer for each wall separately
+  Domain domain_seq { f, 20.0 };
+  build_adjacent_walls( domain_seq );
+
+  MeshGenerator generator_seq {};
+  Mesh& mesh_seq = generator_seq.new_mesh( domain_seq );
+
+  const std::vector<std::pair<Vec2d,Vec2d>> endings 
+  { { {0.0, 0.0}, {4.0, 0.0} }, 
+    { {4.4, 0.0}, {10.0, 6.0} } };
+
+  for ( const auto& ending : endings )
+    CHECK( generator_seq.quad_layer_generation(mesh_seq)
+             .n_layers( 1 )
+             .first_height( 0.2 )
+             .growth_rate( 1.0 )
+             .starting_position( ending.first )
+             .ending_position( ending.second )
+             .generate_elements() );
+
+  // Both walls interact in the same way as for separate calls
+  CHECK( mesh_all.n_quads() > 0 );
+  CHECK( mesh_all.n_quads() == mesh_seq.n_quads() );
+  CHECK( mesh_all.n_triangles() == mesh_seq.n_triangles() );
+  CHECK( mesh_all.n_vertices() == mesh_seq.n_vertices() );
+
+  for ( size_t i = 0; i < mesh_all.n_vertices(); ++i )
+    CHECK( ( mesh_all.vertices()[i].xy() 
+           - mesh_seq.vertices()[i].xy() ).norm() < 1.0E-10 );
+
+  CHECK( generator_all.triangulation(mesh_all).generate_elements() );
+  CHECK( EntityChecks::check_mesh_validity( mesh_all ) );
+
+  // Several layers for both walls at once
+  Domain domain_multi { f, 20.0 };
+  build_adjacent_walls( domain_multi );
+
+  MeshGenerator generator_multi {};
+  Mesh& mesh_multi = generator_multi.new_mesh( domain_multi );
+
+  CHECK( generator_multi.quad_layer_generation(mesh_multi)
+           .markers( {2, 3} )
+           .n_layers( 3 )
+           .first_height( 0.1 )
+           .growth_rate( 1.5 )
+           .generate_elements() );
+
+  CHECK( mesh_multi.n_quads() > mesh_all.n_quads() );
+
+  CHECK( generator_multi.triangulation(mesh_multi).generate_elements() );
+  CHECK( EntityChecks::check_mesh_validity( mesh_multi ) );
+
+} // quad_layer_adjacent_walls()
+
+/*********************************************************************
+* Test the generation of triangular boundary layers
+*********************************************************************/
+void triangle_layers()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.4; };
+
+  // Reference quad layers
+  Domain domain_quad { f, 20.0 };
+  build_tube_bank( domain_quad );
+
+  MeshGenerator generator_quad {};
+  Mesh& mesh_quad = generator_quad.new_mesh( domain_quad );
+
+  CHECK( generator_quad.quad_layer_generation(mesh_quad)
+           .markers( {2, 3, 4, 5} )
+           .n_layers( 3 )
+           .first_height( 0.05 )
+           .growth_rate( 1.5 )
+           .generate_elements() );
+
+  // Triangle layers with the same layering
+  Domain domain_tri { f, 20.0 };
+  build_tube_bank( domain_tri );
+
+  MeshGenerator generator_tri {};
+  Mesh& mesh_tri = generator_tri.new_mesh( domain_tri );
+
+  CHECK( generator_tri.quad_layer_generation(mesh_tri)
+           .triangle_layers( true )
+           .markers( {2, 3, 4, 5} )
+           .n_layers( 3 )
+           .first_height( 0.05 )
+           .growth_rate( 1.5 )
+           .generate_elements() );
+
+  CHECK( mesh_tri.n_quads() == 0 );
+  CHECK( mesh_tri.n_triangles() 
+         == 2 * mesh_quad.n_quads() + mesh_quad.n_triangles() );
+
+  // Hand over to the isotropic advancing front
+  CHECK( generator_tri.triangulation(mesh_tri).generate_elements() );
+  CHECK( mesh_tri.n_quads() == 0 );
+  CHECK( EntityChecks::check_mesh_validity( mesh_tri ) );
+
+  double area = 0.0;
+  for ( const auto& t_ptr : mesh_tri.triangles() )
+    area += t_ptr->area();
+  CHECK( ABS( area - domain_tri.area() ) < 1.0E-10 * domain_tri.area() );
+
+} // triangle_layers()
+
+/*********************************************************************
+* Test the scoring of candidate triangles in the front update
+*********************************************************************/
+void triangle_score()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.3 + 0.1*p.x; };
+
+  // Reference triangulation with the default score
+  Domain domain_ref { f, 20.0 };
+  build_tube_bank( domain_ref );
+
+  MeshGenerator generator_ref {};
+  Mesh& mesh_ref = generator_ref.new_mesh( domain_ref );
+  CHECK( generator_ref.triangulation(mesh_ref).generate_elements() );
+
+  // Triangulation with a user defined score, that is equal to the 
+  // default score
+  Domain domain { f, 20.0 };
+  build_tube_bank( domain );
+  domain.size_function_profiler().enable( true );
+
+  size_t n_scores = 0;
+  TriangleScore score = [&n_scores](const Triangle& t, const Domain& d)
+  { ++n_scores; return triangle_quality_score(t, d); };
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+  CHECK( generator.triangulation(mesh)
+           .triangle_score( score )
+           .generate_elements() );
+
+  CHECK( mesh.n_triangles() == mesh_ref.n_triangles() );
+  CHECK( EntityChecks::check_mesh_validity( mesh ) );
+
+  // Each candidate is scored exactly once and the score is the only 
+  // place where the size function is evaluated during the ranking
+  const SizeFunctionProfiler& profiler = domain.size_function_profiler();
+  CHECK( n_scores > 0 );
+  CHECK( profiler.n_calls(SizeFunctionPhase::Ranking) == n_scores );
+
+} // triangle_score()
+
+/*********************************************************************
+* Test the reuse of strategies for subsequent calls 
+*********************************************************************/
+void strategy_workspaces()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.5; };
+
+  Domain domain_1 { f };
+  Domain domain_2 { f };
+  build_tube_bank( domain_1 );
+  build_tube_bank( domain_2 );
+
+  MeshGenerator generator {};
+  Mesh& mesh_1 = generator.new_mesh( domain_1 );
+  Mesh& mesh_2 = generator.new_mesh( domain_2 );
+
+  CHECK( generator.n_strategies( mesh_1 ) == 0 );
+
+  // Alternating between strategies and meshes reuses the 
+  // strategies of each mesh
+  TriangulationStrategy* tri_1 = &generator.triangulation( mesh_1 );
+  TriangulationStrategy* tri_2 = &generator.triangulation( mesh_2 );
+  MixedSmoothingStrategy* smooth_1 = &generator.mixed_smoothing( mesh_1 );
+
+  CHECK( tri_1 != tri_2 );
+
+  CHECK( generator.quad_layer_generation( mesh_1 ).n_layers( 2 )
+                                                  .first_height( 0.1 )
+                                                  .growth_rate( 1.0 )
+                                                  .markers( {2, 3} )
+                                                  .generate_elements() );
+
+  CHECK( &generator.triangulation( mesh_1 ) == tri_1 );
+  CHECK( &generator.triangulation( mesh_2 ) == tri_2 );
+  CHECK( &generator.mixed_smoothing( mesh_1 ) == smooth_1 );
+  CHECK( generator.n_strategies( mesh_1 ) == 3 );
+
+  CHECK( tri_1->generate_elements() );
+  CHECK( tri_2->generate_elements() );
+  CHECK( generator.mixed_smoothing( mesh_1 ).smooth( 2 ) );
+  CHECK( generator.mixed_smoothing( mesh_1 ).smooth( 2 ) );
+
+  CHECK( EntityChecks::check_mesh_validity( mesh_1 ) );
+  CHECK( EntityChecks::check_mesh_validity( mesh_2 ) );
+
+  // Invalidated strategies are constructed anew 
+  generator.invalidate_strategies( mesh_1 );
+  CHECK( generator.n_strategies( mesh_1 ) == 0 );
+  CHECK( generator.n_strategies( mesh_2 ) == 1 );
+
+  generator.triangulation( mesh_1 );
+  CHECK( generator.n_strategies( mesh_1 ) == 1 );
+
+  // The settings of a strategy are kept only for the reference that
+  // has been handed out - subsequent requests restore the defaults
+  QuadLayerStrategy& quad_layers = generator.quad_layer_generation( mesh_2 );
+  quad_layers.n_layers( 3 ).markers( {2} ).triangle_layers( true );
+  CHECK( quad_layers.n_layers() == 3 );
+  CHECK( quad_layers.markers().size() == 1 );
+
+  CHECK( &generator.quad_layer_generation( mesh_2 ) == &quad_layers );
+  CHECK( quad_layers.n_layers() == 0 );
+  CHECK( quad_layers.markers().size() == 0 );
+  CHECK( !quad_layers.triangle_layers() );
+
+  // Setting a starting or ending position clears the markers
+  quad_layers.markers( {2} ).starting_position( 0.0, 0.0 );
+  CHECK( quad_layers.markers().size() == 0 );
+  quad_layers.markers( {2} ).ending_position( 0.0, 0.0 );
+  CHECK( quad_layers.markers().size() == 0 );
+
+  TriangulationStrategy& tri = generator.triangulation( mesh_2 );
+  tri.min_cell_quality( 0.5 )
+     .max_retreats( 4 )
+     .front_order( FrontOrder::Coherent );
+  tri.front_monitor().max_failed_base_edges( 8 );
+  tri.triangle_checks().adaptive( true );
+
+  CHECK( &generator.triangulation( mesh_2 ) == &tri );
+  CHECK( tri.min_cell_quality() == 0.0 );
+  CHECK( tri.max_retreats() == 0 );
+  CHECK( tri.front_order() == FrontOrder::Length );
+  CHECK( tri.front_monitor().max_failed_base_edges() == 0 );
+  CHECK( !tri.triangle_checks().adaptive() );
+
+  MixedSmoothingStrategy& smooth = generator.mixed_smoothing( mesh_2 );
+  smooth.epsilon( 0.1 ).quad_layer_smoothing( true );
+  CHECK( &generator.mixed_smoothing( mesh_2 ) == &smooth );
+  CHECK( smooth.epsilon() == 0.75 );
+  CHECK( !smooth.quad_layer_smoothing() );
+
+  // Removed meshes release their workspaces, such that new meshes 
+  // never obtain the strategies of a removed mesh
+  CHECK( generator.remove_mesh( mesh_1 ) );
+  CHECK( generator.n_strategies( mesh_1 ) == 0 );
+
+  Mesh& mesh_3 = generator.new_mesh( domain_1 );
+  CHECK( generator.n_strategies( mesh_3 ) == 0 );
+  CHECK( generator.triangulation( mesh_3 ).generate_elements() );
+  CHECK( generator.n_strategies( mesh_3 ) == 1 );
+
+} // strategy_workspaces()
+
+/*********************************************************************
+* Test the replication of a meshed unit cell
+*********************************************************************/
+void tiled_mesh()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.1; };
+
+  // The unit cell: a square with a circular hole
+  Domain cell_domain { f, 20.0 };
+
+  Vertex& v1 = cell_domain.add_vertex( 0.0, 0.0 );
+  Vertex& v2 = cell_domain.add_vertex( 1.0, 0.0 );
+  Vertex& v3 = cell_domain.add_vertex( 1.0, 1.0 );
+  Vertex& v4 = cell_domain.add_vertex( 0.0, 1.0 );
+
+  Boundary& b_ext = cell_domain.add_exterior_boundary();
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  Boundary& b_int = cell_domain.add_interior_boundary();
+  b_int.set_shape_circle( 2, {0.5, 0.5}, 0.25, 16 );
+
+  MeshGenerator generator {};
+  Mesh& cell = generator.new_mesh( cell_domain );
+  CHECK( generator.triangulation(cell).generate_elements() );
+
+  size_t n_side_edges = 0;
+  size_t n_hole_edges = 0;
+  double cell_area    = 0.0;
+
+  for ( const auto& e_ptr : cell.boundary_edges() )
+    if ( e_ptr->marker() == 1 ) ++n_side_edges; else ++n_hole_edges;
+  n_side_edges /= 4;
+
+  for ( const auto& t_ptr : cell.triangles() )
+    cell_area += t_ptr->area();
+
+  // A 4x3 array of translated cells
+  const size_t nx = 4;
+  const size_t ny = 3;
+  std::vector<MeshTransformation> placements {};
+
+  for ( size_t j = 0; j < ny; ++j )
+    for ( size_t i = 0; i < nx; ++i )
+      placements.push_back( MeshTransformation::translation(
+        { static_cast<double>(i), static_cast<double>(j) } ) );
+
+  // -> A copy at an existing location is skipped
+  placements.push_back( MeshTransformation::translation({0.0, 0.0}) );
+
+  Domain array_domain { f, 20.0 };
+  Mesh& array = generator.new_tiled_mesh( array_domain, cell, placements );
+
+  CHECK( array.n_triangles() == nx * ny * cell.n_triangles() );
+  CHECK( array.n_boundary_edges() 
+      == 2 * (nx + ny) * n_side_edges + nx * ny * n_hole_edges );
+  CHECK( array.n_vertices() 
+      == nx * ny * cell.n_vertices() 
+       - ( (nx-1) * ny + (ny-1) * nx ) * (n_side_edges + 1) 
+       + (nx-1) * (ny-1) );
+  CHECK( ABS(array.area() - nx * ny * cell_area) < 1.0E-10 * array.area() );
+  CHECK( EntityChecks::check_mesh_validity( array ) );
+
+  // A mirrored and a rotated copy next to the original cell
+  std::vector<MeshTransformation> transformed {
+    MeshTransformation {},
+    MeshTransformation::mirror( {1.0, 0.0}, {0.0, 1.0} ),
+    MeshTransformation::rotation( 0.5*M_PI, {0.0, 0.0} ) 
+  };
+
+  Mesh& mirrored = generator.new_tiled_mesh( array_domain, cell, transformed );
+
+  CHECK( mirrored.n_triangles() == 3 * cell.n_triangles() );
+  CHECK( mirrored.n_boundary_edges() 
+      == 8 * n_side_edges + 3 * n_hole_edges );
+  CHECK( EntityChecks::check_mesh_validity( mirrored ) );
+
+  for ( const auto& t_ptr : mirrored.triangles() )
+    CHECK( t_ptr->area() > 0.0 );
+
+  // Invalid copies next to the original cell are rejected:
+  // -> A partially overlapping copy
+  // -> A scaled copy within the elements of the original cell
+  // -> A copy, whose interface vertices do not match
+  MeshTiling tiling { mirrored, cell };
+
+  const size_t n_verts = mirrored.n_vertices();
+  const size_t n_tris  = mirrored.n_triangles();
+
+  CHECK( !tiling.add_copy( MeshTransformation::translation({0.5, 0.0}) ) );
+  CHECK( !tiling.add_copy( MeshTransformation { 0.15, 0.0, 0.0, 0.15, 
+                                                {0.02, 0.02} } ) );
+  CHECK( !tiling.add_copy( MeshTransformation::translation({0.5, 1.0}) ) );
+
+  CHECK( tiling.n_copies() == 0 );
+  CHECK( mirrored.n_vertices() == n_verts );
+  CHECK( mirrored.n_triangles() == n_tris );
+
+  // -> A matching copy is still accepted
+  CHECK( tiling.add_copy( MeshTransformation::translation({0.0, 1.0}) ) );
+  CHECK( tiling.n_copies() == 1 );
+  CHECK( EntityChecks::check_mesh_validity( mirrored ) );
+
+} // tiled_mesh()
+
+/*********************************************************************
+* Build a rectangular channel with a square obstacle at <x>
+*********************************************************************/
+static inline void build_channel(Domain& domain, double x)
+{
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex( 10.0,  0.0 );
+  Vertex& v3 = domain.add_vertex( 10.0,  6.0 );
+  Vertex& v4 = domain.add_vertex(  0.0,  6.0 );
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  Vertex& w1 = domain.add_vertex( x,     2.5 );
+  Vertex& w2 = domain.add_vertex( x,     3.5 );
+  Vertex& w3 = domain.add_vertex( x+1.0, 3.5 );
+  Vertex& w4 = domain.add_vertex( x+1.0, 2.5 );
+
+  Boundary& b_int = domain.add_interior_boundary();
+  b_int.add_edge( w1, w2, 2 );
+  b_int.add_edge( w2, w3, 2 );
+  b_int.add_edge( w3, w4, 2 );
+  b_int.add_edge( w4, w1, 2 );
+
+} // build_channel()
+
+/*********************************************************************
+* Test the warm start of meshes for modified domains
+*********************************************************************/
+void warm_start()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.4; };
+
+  Domain domain_prev { f, 20.0 };
+  build_channel( domain_prev, 2.0 );
+
+  MeshGenerator generator {};
+  Mesh& mesh_prev = generator.new_mesh( domain_prev );
+  CHECK( generator.triangulation(mesh_prev).generate_elements() );
+
+  // An unchanged domain reuses the entire mesh
+  Domain domain_same { f, 20.0 };
+  build_channel( domain_same, 2.0 );
+
+  WarmStartReport report_same {};
+  Mesh& mesh_same 
+    = generator.warm_start_mesh( domain_same, mesh_prev, 2.0, &report_same );
+
+  CHECK( report_same.n_reused_boundary_edges 
+      == mesh_prev.n_boundary_edges() );
+  CHECK( report_same.n_reused_elements == mesh_prev.n_elements() );
+  CHECK( mesh_same.n_vertices() == mesh_prev.n_vertices() );
+  CHECK( ABS(report_same.reused_area_fraction() - 1.0) < 1.0E-10 );
+
+  // A displaced obstacle: only the band around the previous and 
+  // the new obstacle is regenerated
+  Domain domain_new { f, 20.0 };
+  build_channel( domain_new, 5.0 );
+
+  WarmStartReport report {};
+  Mesh& mesh_new 
+    = generator.warm_start_mesh( domain_new, mesh_prev, 2.0, &report );
+
+  CHECK( generator.remove_mesh( mesh_prev ) );
+  CHECK( generator.remove_mesh( mesh_same ) );
+
+  size_t n_obstacle_edges = 0;
+  for ( const auto& e_ptr : mesh_new.boundary_edges() )
+    if ( e_ptr->marker() == 2 ) 
+      ++n_obstacle_edges;
+
+  CHECK( report.n_reused_boundary_edges 
+      == report.n_boundary_edges - n_obstacle_edges );
+  CHECK( report.n_reused_elements > 0 );
+  CHECK( report.n_reused_elements < report.n_previous_elements );
+  CHECK( report.reused_area_fraction() > 0.5 );
+  CHECK( report.reused_area_fraction() < 1.0 );
+
+  CHECK( generator.triangulation(mesh_new).generate_elements() );
+  CHECK( EntityChecks::check_mesh_validity( mesh_new ) );
+
+  double area = 0.0;
+  for ( const auto& t_ptr : mesh_new.triangles() )
+    area += t_ptr->area();
+
+  CHECK( ABS(area - domain_new.area()) < 1.0E-10 * area );
+
+} // warm_start()
+
+/*********************************************************************
+* Test the warm start of a large coarse mesh, where only a small 
+* obstacle is displaced
+*********************************************************************/
+void warm_start_local_change()
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return MIN( 3.0, 0.2 + 0.15 * (p - Vec2d{20.0,20.0}).norm() ); };
+
+  auto build_domain = [](Domain& domain, double x)
+  {
+    Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+    Vertex& v2 = domain.add_vertex( 40.0,  0.0 );
+    Vertex& v3 = domain.add_vertex( 40.0, 40.0 );
+    Vertex& v4 = domain.add_vertex(  0.0, 40.0 );
+
+    Boundary& b_ext = domain.add_exterior_boundary();
+    b_ext.add_edge( v1, v2, 1 );
+    b_ext.add_edge( v2, v3, 1 );
+    b_ext.add_edge( v3, v4, 1 );
+    b_ext.add_edge( v4, v1, 1 );
+
+    Vertex& w1 = domain.add_vertex( x,     19.5 );
+    Vertex& w2 = domain.add_vertex( x,     20.5 );
+    Vertex& w3 = domain.add_vertex( x+1.0, 20.5 );
+    Vertex& w4 = domain.add_vertex( x+1.0, 19.5 );
+
+    Boundary& b_int = domain.add_interior_boundary();
+    b_int.add_edge( w1, w2, 2 );
+    b_int.add_edge( w2, w3, 2 );
+    b_int.add_edge( w3, w4, 2 );
+    b_int.add_edge( w4, w1, 2 );
+  };
+
+  Domain domain_prev { f, 80.0 };
+  build_domain( domain_prev, 19.5 );
+
+  MeshGenerator generator {};
+  Mesh& mesh_prev = generator.new_mesh( domain_prev );
+  CHECK( generator.triangulation(mesh_prev).generate_elements() );
+
+  Domain domain_new { f, 80.0 };
+  build_domain( domain_new, 19.8 );
+
+  WarmStartReport report {};
+  Mesh& mesh_new 
+    = generator.warm_start_mesh( domain_new, mesh_prev, 2.0, &report );
+
+  CHECK( generator.remove_mesh( mesh_prev ) );
+
+  // Only elements in the vicinity of the obstacle are tested against 
+  // the changed edges
+  CHECK( report.n_changed_edges > 0 );
+  CHECK( report.n_segment_tests < report.n_previous_elements );
+  CHECK( report.reused_area_fraction() > 0.9 );
+
+  CHECK( generator.triangulation(mesh_new).generate_elements() );
+  CHECK( EntityChecks::check_mesh_validity( mesh_new ) );
+
+  double area = 0.0;
+  for ( const auto& t_ptr : mesh_new.triangles() )
+    area += t_ptr->area();
+
+  CHECK( ABS(area - domain_new.area()) < 1.0E-10 * area );
+
+} // warm_start_local_change()
+
+/*********************************************************************
+* Test periodic boundary pairs
+*********************************************************************/
+void periodic_pairs()
+{
+  // The size function grows towards the top, such that independent
+  // discretizations of the bottom and top would not match
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return 0.1 + 0.05 * p.x + 0.15 * p.y; };
+
+  Domain domain { f, 20.0 };
+
+  Vertex& v1 = domain.add_vertex( 0.0, 0.0 );
+  Vertex& v2 = domain.add_vertex( 4.0, 0.0 );
+  Vertex& v3 = domain.add_vertex( 4.0, 2.0 );
+  Vertex& v4 = domain.add_vertex( 0.0, 2.0 );
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 3 );
+  b_ext.add_edge( v3, v4, 2 );
+  b_ext.add_edge( v4, v1, 4 );
+
+  domain.add_periodic_pair( 1, 2, 
+    MeshTransformation::translation( {0.0, 2.0} ) );
+  domain.add_periodic_pair( 4, 3, 
+    MeshTransformation::translation( {4.0, 0.0} ) );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( EntityChecks::check_mesh_validity( mesh ) );
+
+  std::vector<size_t> n_edges ( 5, 0 );
+  for ( const auto& e_ptr : mesh.boundary_edges() )
+    ++n_edges[ e_ptr->marker() ];
+
+  CHECK( n_edges[1] == n_edges[2] );
+  CHECK( n_edges[3] == n_edges[4] );
+
+  auto pairs = MeshCleanup::get_periodic_vertex_pairs( mesh, domain );
+
+  CHECK( pairs.size() == n_edges[1] + n_edges[4] + 2 );
+
+  for ( const auto& p : pairs )
+  {
+    const PeriodicPair* periodic = domain.periodic_target(p.target_marker);
+    CHECK( periodic != nullptr );
+    CHECK( periodic->source_marker == p.source_marker );
+
+    const Vec2d d 
+      = periodic->transformation( p.source->xy() ) - p.target->xy();
+    CHECK( d.norm() < 1.0E-10 );
+
+    const Vec2d d_inv 
+      = periodic->transformation.inverse()( p.target->xy() ) 
+      - p.source->xy();
+    CHECK( d_inv.norm() < 1.0E-10 );
+  }
+
+} // periodic_pairs()
+
+/*********************************************************************
+* Test the valence equalization of quad meshes
+*********************************************************************/
+void valence_modification()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.5; };
+
+  Domain domain { f, 20.0 };
+  build_channel( domain, 2.0 );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh).modify() );
+  CHECK( generator.quad_refinement(mesh).refine() );
+  CHECK( mesh.n_triangles() == 0 );
+
+  auto irregularity = [](const Mesh& m)
+  {
+    int E = 0;
+    for ( const auto& v_ptr : m.vertices() )
+    {
+      const int d = ValenceStrategy::irregularity( *v_ptr );
+      E += d * d;
+    }
+    return E;
+  };
+
+  const int E_before = irregularity( mesh );
+
+  ValenceStrategy& valence = generator.valence_modification(mesh);
+  CHECK( valence.modify() );
+  CHECK( valence.n_swaps() + valence.n_splits() + valence.n_collapses() > 0 );
+
+  const int E_after = irregularity( mesh );
+  CHECK( E_after < E_before );
+
+  double area = 0.0;
+  for ( const auto& q_ptr : mesh.quads() )
+  {
+    CHECK( q_ptr->area() > 0.0 );
+    area += q_ptr->area();
+  }
+
+  CHECK( mesh.n_triangles() == 0 );
+  CHECK( ABS(area - domain.area()) < 1.0E-10 * area );
+  CHECK( EntityChecks::check_mesh_validity( mesh ) );
+  CHECK( EntityChecks::check_mesh_validity( mesh, 
+                                            MeshCheckMode::EdgeTable ) );
+
+  // A second pass finds no further improvements
+  CHECK( valence.modify() );
+  CHECK( valence.n_swaps() + valence.n_splits() + valence.n_collapses() == 0 );
+  CHECK( irregularity( mesh ) == E_after );
+
+  CHECK( generator.mixed_smoothing(mesh).smooth(2) );
+
+  // Operations, that result in invalid quads, are reverted
+  CHECK( generator.remove_mesh( mesh ) );
+
+  Mesh& mesh_strict = generator.new_mesh( domain );
+  CHECK( generator.triangulation(mesh_strict).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh_strict).modify() );
+  CHECK( generator.quad_refinement(mesh_strict).refine() );
+
+  const size_t n_quads = mesh_strict.n_quads();
+
+  ValenceStrategy& strict = generator.valence_modification(mesh_strict);
+  CHECK( strict.max_angle( 0.5 * M_PI ).modify() );
+  CHECK( strict.n_swaps() + strict.n_splits() + strict.n_collapses() == 0 );
+  CHECK( mesh_strict.n_quads() == n_quads );
+  CHECK( EntityChecks::check_mesh_validity( mesh_strict ) );
+
+} // valence_modification()
+
+/*********************************************************************
+* Exposes the candidate operations of the valence strategy
+*********************************************************************/
+class ValenceCandidates : public ValenceStrategy
+{
+public:
+  using ValenceStrategy::ValenceStrategy;
+  using ValenceStrategy::Operation;
+  using ValenceStrategy::Patch;
+  using ValenceStrategy::collect_splits;
+  using ValenceStrategy::apply_split;
+  using ValenceStrategy::revert_patch;
+  using ValenceStrategy::candidates_;
+};
+
+/*********************************************************************
+* Test that split candidates remain valid after a reverted candidate
+* on the same quad star
+*********************************************************************/
+void valence_split_revert()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.5; };
+
+  Domain domain { f, 20.0 };
+  build_channel( domain, 2.0 );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh).modify() );
+  CHECK( generator.quad_refinement(mesh).refine() );
+
+  ValenceCandidates valence { mesh, domain };
+
+  // Find a vertex with at least two split candidates
+  Vertex* v = nullptr;
+
+  for ( const auto& v_ptr : mesh.vertices() )
+  {
+    valence.candidates_.clear();
+    valence.collect_splits( *v_ptr );
+
+    if ( valence.candidates_.size() > 1 )
+    {
+      v = v_ptr.get();
+      break;
+    }
+  }
+
+  CHECK( v != nullptr );
+  if ( !v ) return;
+
+  const std::vector<ValenceCandidates::Operation> candidates 
+    = valence.candidates_;
+
+  const size_t n_quads = mesh.n_quads();
+  const size_t n_edges = mesh.n_interior_edges();
+
+  // Apply and revert the first candidate, which reorders the star
+  ValenceCandidates::Patch patch_1 {};
+  CHECK( valence.apply_split( candidates[0], patch_1 ) );
+  valence.revert_patch( patch_1 );
+  mesh.clear_waste();
+
+  CHECK( mesh.n_quads() == n_quads );
+  CHECK( mesh.n_interior_edges() == n_edges );
+
+  // The second candidate still splits along its own ring vertices
+  const ValenceCandidates::Operation& op = candidates[1];
+
+  ValenceCandidates::Patch patch_2 {};
+  CHECK( valence.apply_split( op, patch_2 ) );
+
+  Vertex* w = patch_2.new_vertex;
+  CHECK( w != nullptr );
+  if ( !w ) return;
+
+  CHECK( mesh.get_edge( *w, *op.x1 ) != nullptr );
+  CHECK( mesh.get_edge( *w, *op.x2 ) != nullptr );
+  CHECK( mesh.get_edge( *v, *op.x1 ) != nullptr );
+  CHECK( mesh.get_edge( *v, *op.x2 ) != nullptr );
+  CHECK( w->facets().size() == op.k + 1 );
+  CHECK( mesh.n_quads() == n_quads + 1 );
+
+  bool found_quad = false;
+  for ( const Facet* q : w->facets() )
+    if (  q->get_vertex_index( *v ) >= 0 
+       && q->get_vertex_index( *op.x1 ) >= 0 
+       && q->get_vertex_index( *op.x2 ) >= 0 )
+      found_quad = true;
+
+  CHECK( found_quad );
+
+  valence.revert_patch( patch_2 );
+  mesh.clear_waste();
+
+  CHECK( mesh.n_quads() == n_quads );
+  CHECK( mesh.n_interior_edges() == n_edges );
+
+  // Candidates, whose ring vertices are not part of the star, 
+  // are rejected
+  ValenceCandidates::Operation stale = op;
+  stale.x2 = v;
+
+  ValenceCandidates::Patch patch_3 {};
+  CHECK( !valence.apply_split( stale, patch_3 ) );
+  CHECK( patch_3.new_quads.empty() );
+
+  MeshCleanup::assign_mesh_indices( mesh );
+  MeshCleanup::setup_facet_connectivity( mesh );
+  CHECK( EntityChecks::check_mesh_validity( mesh ) );
+
+} // valence_split_revert()
+
+/*********************************************************************
+* Test the monitoring of the advancing front health
+*********************************************************************/
+void front_monitor()
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return 0.1 + 0.3 * ABS(p.y - 3.0); };
+
+  // Reference run: the monitor only counts
+  Domain domain { f, 20.0 };
+  build_tube_bank( domain );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  TriangulationStrategy& triangulation = generator.triangulation(mesh);
+  CHECK( triangulation.generate_elements() );
+  CHECK( !triangulation.aborted() );
+
+  const FrontMonitor& monitor = triangulation.front_monitor();
+  CHECK( monitor.n_failed_base_edges() > 0 );
+  CHECK( monitor.n_wide_searches() > 1 );
+
+  const size_t n_elements = mesh.n_elements();
+  const size_t n_failed   = monitor.n_failed_base_edges();
+
+  CHECK( generator.remove_mesh( mesh ) );
+
+  // The limit of failed base edges applies to failures in a row,
+  // not to the total number of failures of a healthy run
+  Mesh& mesh_limit = generator.new_mesh( domain );
+
+  TriangulationStrategy& limited = generator.triangulation(mesh_limit);
+  limited.front_monitor()
+    .reaction( FrontHealthReaction::Abort )
+    .max_failed_base_edges( n_failed / 2 );
+
+  CHECK( limited.generate_elements() );
+  CHECK( !limited.aborted() );
+  CHECK( mesh_limit.n_elements() == n_elements );
+  CHECK( limited.front_monitor().n_failed_base_edges() == n_failed );
+
+  CHECK( generator.remove_mesh( mesh_limit ) );
+
+  // Abort after the first wide search
+  Mesh& mesh_abort = generator.new_mesh( domain );
+
+  TriangulationStrategy& aborting = generator.triangulation(mesh_abort);
+  aborting.front_monitor()
+    .reaction( FrontHealthReaction::Abort )
+    .max_wide_searches( 1 );
+
+  CHECK( !aborting.generate_elements() );
+  CHECK( aborting.aborted() );
+  CHECK( mesh_abort.n_elements() < n_elements );
+
+  const FrontHealth& health = aborting.front_monitor().health();
+  CHECK( health.n_wide_searches == 2 );
+  CHECK( health.n_front_edges > 0 );
+  CHECK( health.min_front_angle > 0.0 );
+  CHECK( health.front_ratio() > 1.0 );
+  CHECK( ABS( health.remaining_area + mesh_abort.area() - domain.area() ) 
+         < 1.0E-8 * domain.area() );
+
+} // front_monitor()
+
+/*********************************************************************
+* Test the local retreat of an unhealthy advancing front
+*********************************************************************/
+void front_retreat()
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return 0.1 + 0.3 * ABS(p.y - 3.0); };
+
+  Domain domain { f, 20.0 };
+  build_tube_bank( domain );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  // Retreat instead of a second wide search
+  TriangulationStrategy& triangulation = generator.triangulation(mesh);
+  triangulation.max_retreats( 10 ).check_front( true );
+  triangulation.front_monitor()
+    .reaction( FrontHealthReaction::Retreat )
+    .max_wide_searches( 1 );
+
+  CHECK( triangulation.generate_elements() );
+  CHECK( !triangulation.aborted() );
+  CHECK( triangulation.n_retreats() > 0 );
+  CHECK( triangulation.n_retreats() <= 10 );
+
+  CHECK( EntityChecks::check_mesh_validity(mesh) );
+  CHECK( ABS( mesh.area() - domain.area() ) < 1.0E-8 * domain.area() );
+
+  CHECK( generator.remove_mesh( mesh ) );
+
+  // Without any retreats, the meshing is aborted
+  Mesh& mesh_abort = generator.new_mesh( domain );
+
+  TriangulationStrategy& aborting = generator.triangulation(mesh_abort);
+  aborting.front_monitor()
+    .reaction( FrontHealthReaction::Retreat )
+    .max_wide_searches( 1 );
+
+  CHECK( !aborting.generate_elements() );
+  CHECK( aborting.aborted() );
+  CHECK( aborting.n_retreats() == 0 );
+
+} // front_retreat()
+
+/*********************************************************************
+* Test the triangulation with a spatially coherent front order
+*********************************************************************/
+void coherent_front_order()
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return 0.1 + 0.05 * p.x; };
+
+  Domain domain { f, 20.0 };
+  build_tube_bank( domain );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  TriangulationStrategy& triangulation = generator.triangulation(mesh);
+  CHECK( triangulation.front_order() == FrontOrder::Length );
+
+  triangulation.front_order( FrontOrder::Coherent );
+  CHECK( triangulation.front_order() == FrontOrder::Coherent );
+
+  CHECK( triangulation.generate_elements() );
+  CHECK( EntityChecks::check_mesh_validity(mesh) );
+  CHECK( ABS( mesh.area() - domain.area() ) < 1.0E-8 * domain.area() );
+
+} // coherent_front_order()
+
+/*********************************************************************
+* Test the cost-ordered validation cascade of new mesh entities
+*********************************************************************/
+void validation_cascade()
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return 0.1 + 0.05 * p.x; };
+
+  Domain domain { f, 20.0 };
+  build_tube_bank( domain );
+
+  MeshGenerator generator {};
+
+  // Reference mesh with the static order of checks
+  Mesh& mesh_static = generator.new_mesh( domain );
+  TriangulationStrategy& tri_static = generator.triangulation(mesh_static);
+  CHECK( !tri_static.triangle_checks().adaptive() );
+  CHECK( !tri_static.vertex_checks().adaptive() );
+
+  CHECK( tri_static.generate_elements() );
+
+  std::vector<Vec2d> xy_static {};
+  for ( const auto& v_ptr : mesh_static.vertices() )
+    xy_static.push_back( v_ptr->xy() );
+
+  const ValidationCascade& c_static = tri_static.triangle_checks();
+  CHECK( c_static.order()[3] == 3 );
+  CHECK( c_static.order()[7] == 7 );
+
+  CHECK( generator.remove_mesh( mesh_static ) );
+
+  // Adaptively ordered checks yield the identical mesh
+  Mesh& mesh = generator.new_mesh( domain );
+  TriangulationStrategy& triangulation = generator.triangulation(mesh);
+  triangulation.triangle_checks().adaptive( true );
+  triangulation.triangle_checks().reorder_interval( 16 );
+  triangulation.triangle_checks().timing_interval( 4 );
+
+  CHECK( triangulation.generate_elements() );
+  CHECK( mesh.n_vertices() == xy_static.size() );
+
+  size_t i_vertex = 0;
+  for ( const auto& v_ptr : mesh.vertices() )
+    if ( i_vertex < xy_static.size() )
+      CHECK( v_ptr->xy() == xy_static[i_vertex++] );
+
+  // The cheap checks stay in front, and the statistics are consistent
+  const ValidationCascade& checks = triangulation.triangle_checks();
+
+  CHECK( checks.n_candidates() > mesh.n_triangles() );
+  CHECK( checks.n_rejected() > 0 );
+  CHECK( checks.order()[0] == 0 );
+  CHECK( checks.order()[1] == 1 );
+  CHECK( checks.order()[2] == 2 );
+
+  size_t n_rejected = 0;
+  for ( size_t i = 0; i < checks.size(); ++i )
+  {
+    const CheckStatistics& s = checks.statistics(i);
+    CHECK( s.n_rejected <= s.n_evaluated );
+    CHECK( s.n_evaluated <= checks.n_candidates() );
+    n_rejected += s.n_rejected;
+  }
+
+  CHECK( n_rejected == checks.n_rejected() );
+  CHECK( checks.statistics(0).n_evaluated == checks.n_candidates() );
+  CHECK( checks.statistics(3).rejection_rate() > 0.0 );
+
+  // Only a fraction of the evaluations is timed
+  const CheckStatistics& s_timed = checks.statistics(checks.order()[3]);
+  CHECK( s_timed.n_timed > 0 );
+  CHECK( s_timed.n_timed <= s_timed.n_evaluated / 4 + 1 );
+
+  std::ostringstream os {};
+  checks.write( os );
+  CHECK( os.str().find( "front intersection" ) != std::string::npos );
+
+  // The statistics are reset for every meshing run
+  CHECK( generator.remove_mesh( mesh ) );
+
+  Mesh& mesh_runs = generator.new_mesh( domain );
+  TriangulationStrategy& runs = generator.triangulation(mesh_runs);
+
+  runs.n_elements( 50 );
+  runs.generate_elements();
+  const size_t n_first_run = runs.triangle_checks().n_candidates();
+
+  runs.n_elements( 1 );
+  runs.generate_elements();
+
+  CHECK( n_first_run > 50 );
+  CHECK( runs.triangle_checks().n_candidates() < n_first_run );
+
+} // validation_cascade()
+
+/*********************************************************************
+* Test the generation of second order elements, whose boundary nodes
+* are located on the circular domain boundaries
+*********************************************************************/
+void high_order_elements()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.3; };
+
+  Domain domain { f, 10.0 };
+
+  Boundary& b_ext = domain.add_exterior_boundary();
+  Boundary& b_int = domain.add_interior_boundary();
+  b_ext.set_shape_circle( 1, {0.0, 0.0}, 2.0, 12 );
+  b_int.set_shape_circle( 2, {0.0, 0.0}, 0.5, 8 );
+
+  CHECK( b_ext.curve() == BdryCurve::CIRCLE );
+  CHECK( b_int.curve() == BdryCurve::CIRCLE );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh).modify() );
+  CHECK( generator.mixed_smoothing(mesh).smooth(2) );
+  CHECK( mesh.n_quads() > 0 );
+  CHECK( mesh.n_triangles() > 0 );
+
+  const double exact_area = M_PI * ( 2.0 * 2.0 - 0.5 * 0.5 );
+
+  // Without projected vertices, the boundary edge nodes remain on 
+  // the chords of edges between unprojected vertices
+  MeshHighOrder linear_bdry { mesh, domain };
+  linear_bdry.project_vertices( false );
+
+  CHECK( linear_bdry.generate() );
+  CHECK( linear_bdry.n_moved_vertices() == 0 );
+  CHECK( linear_bdry.n_curved_edges() < mesh.n_boundary_edges() );
+
+  // Vertices are projected onto the boundary curves by default
+  MeshHighOrder high_order { mesh, domain };
+  CHECK( high_order.project_vertices() );
+
+  CHECK( high_order.generate() );
+  CHECK( high_order.matches( mesh ) );
+  CHECK( high_order.n_invalid_elements() == 0 );
+  CHECK( high_order.min_jacobian_ratio() > 0.0 );
+  CHECK( high_order.n_moved_vertices() > 0 );
+  CHECK( high_order.n_curved_edges() == mesh.n_boundary_edges() );
+  CHECK( high_order.n_nodes() == mesh.n_edges() + mesh.n_quads() );
+
+  // All boundary vertices and boundary nodes are located on the circles
+  auto on_circle = [](const Vec2d& xy)
+  {
+    const double r = xy.norm();
+    return ( ABS(r - 2.0) < 1.0E-10 || ABS(r - 0.5) < 1.0E-10 );
+  };
+
+  for ( const auto& v_ptr : mesh.vertices() )
+    if ( v_ptr->on_boundary() )
+      CHECK( on_circle( v_ptr->xy() ) );
+
+  size_t n_bdry_nodes = 0;
+  for ( const Vec2d& xy : high_order.nodes() )
+    if ( on_circle( xy ) )
+      ++n_bdry_nodes;
+
+  CHECK( n_bdry_nodes == mesh.n_boundary_edges() );
+
+  // The curved elements resolve the domain much better than 
+  // the linear elements
+  double linear_area = 0.0;
+  for ( const auto& q_ptr : mesh.quads() )
+    linear_area += q_ptr->area();
+  for ( const auto& t_ptr : mesh.triangles() )
+    linear_area += t_ptr->area();
+
+  const double linear_error = ABS( linear_area - exact_area );
+  const double curved_error = ABS( high_order.area() - exact_area );
+
+  CHECK( curved_error < 0.05 * linear_error );
+
+  // Export
+  std::ostringstream os {};
+  high_order.write( os );
+  CHECK( os.str().find( "P2TRIANGLES" ) != std::string::npos );
+  CHECK( os.str().find( "Q9QUADS" ) != std::string::npos );
+
+  std::string source_dir { TQMESH_SOURCE_DIR };
+  std::string filepath 
+  { source_dir + "/auxiliary/test_data/MeshGeneratorTests.high_order" };
+
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::TXT,
+                               { &high_order } ) );
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::VTU,
+                               { &high_order } ) );
+
+  // Q8 quads without center nodes
+  MeshHighOrder serendipity { mesh, domain };
+  serendipity.quad_centers( false );
+
+  CHECK( serendipity.generate() );
+  CHECK( serendipity.n_moved_vertices() == 0 );
+  CHECK( serendipity.n_nodes() == mesh.n_edges() );
+  CHECK( ABS( serendipity.area() - high_order.area() ) < 1.0E-10 );
+
+  // A spline through the vertices of a polygon approximates
+  // the underlying circle much better than the polygon
+  Domain domain_spline { f, 10.0 };
+  Boundary& b_spline = domain_spline.add_exterior_boundary();
+
+  std::vector<Vec2d> coords {};
+  for ( size_t i = 0; i < 16; ++i )
+  {
+    const double a = 2.0 * M_PI * static_cast<double>(i) / 16.0;
+    coords.push_back( { std::cos(a), std::sin(a) } );
+  }
+
+  b_spline.set_shape_from_coordinates( coords, std::vector<int>(16, 1) );
+  b_spline.set_curve_spline();
+
+  const Edge& e = **b_spline.begin();
+  const double sagitta = 1.0 - e.xy().norm();
+  const double spline_error = ABS( 1.0 - b_spline.curve_point(e, 0.5).norm() );
+
+  CHECK( spline_error < 0.1 * sagitta );
+
+} // high_order_elements()
+
+/*********************************************************************
+* Test the coloring of mesh elements for a conflict-free assembly
+*********************************************************************/
+void element_coloring()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.5; };
+
+  Domain domain { f, 25.0 };
+  build_tube_bank( domain );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh).modify() );
+  CHECK( mesh.n_quads() > 0 );
+  CHECK( mesh.n_triangles() > 0 );
+
+  auto class_ratio = [](const MeshColoring& coloring)
+  {
+    const auto& sizes = coloring.class_sizes();
+    const auto minmax = std::minmax_element( sizes.begin(), sizes.end() );
+    return static_cast<double>(*minmax.second) 
+         / static_cast<double>(*minmax.first);
+  };
+
+  // First fit coloring over shared vertices
+  MeshColoring first_fit { mesh };
+  first_fit.balanced( false );
+
+  const size_t n_colors = first_fit.compute();
+
+  CHECK( n_colors > 3 );
+  CHECK( first_fit.matches( mesh ) );
+  CHECK( first_fit.is_valid() );
+
+  // Balanced coloring uses the same number of colors with classes 
+  // of similar sizes
+  MeshColoring coloring { mesh };
+
+  CHECK( coloring.compute() == n_colors );
+  CHECK( coloring.is_valid() );
+  CHECK( class_ratio( coloring ) < class_ratio( first_fit ) );
+  CHECK( class_ratio( coloring ) < 1.5 );
+
+  size_t n_colored = 0;
+  for ( size_t s : coloring.class_sizes() )
+    n_colored += s;
+  CHECK( n_colored == mesh.n_elements() );
+
+  // Coloring over shared edges 
+  MeshColoring edge_coloring { mesh };
+  edge_coloring.adjacency( ColoringAdjacency::Edge );
+
+  CHECK( edge_coloring.compute() <= 5 );
+  CHECK( edge_coloring.is_valid() );
+  CHECK( edge_coloring.n_colors() < n_colors );
+
+  // Reordering makes the color classes contiguous
+  CHECK( coloring.reorder() );
+  CHECK( coloring.is_valid() );
+
+  int last_color = -1;
+  for ( const auto& q_ptr : mesh.quads() )
+  {
+    CHECK( coloring.color( *q_ptr ) >= last_color );
+    last_color = coloring.color( *q_ptr );
+  }
+
+  last_color = -1;
+  for ( const auto& t_ptr : mesh.triangles() )
+  {
+    CHECK( coloring.color( *t_ptr ) >= last_color );
+    last_color = coloring.color( *t_ptr );
+  }
+
+  // Export
+  std::ostringstream os {};
+  coloring.write( os );
+  CHECK( os.str().find( "ELEMENTCOLORS" ) != std::string::npos );
+  CHECK( os.str().find( "COLORCLASSES" ) != std::string::npos );
+
+  std::string source_dir { TQMESH_SOURCE_DIR };
+  std::string filepath 
+  { source_dir + "/auxiliary/test_data/MeshGeneratorTests.element_coloring" };
+
+  MeshExportOptions options {};
+  options.coloring = &coloring;
+
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::TXT,
+                               options ) );
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::VTU,
+                               options ) );
+
+  // Combined export with second order elements
+  MeshHighOrder high_order { mesh, domain };
+  high_order.generate();
+  CHECK( high_order.matches( mesh ) );
+
+  options.high_order = &high_order;
+
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::TXT,
+                               options ) );
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::VTU,
+                               options ) );
+
+  std::ifstream infile { filepath + ".txt" };
+  std::stringstream content {};
+  content << infile.rdbuf();
+
+  CHECK( content.str().find( "P2TRIANGLES" ) != std::string::npos );
+  CHECK( content.str().find( "ELEMENTCOLORS" ) != std::string::npos );
+
+} // element_coloring()
+
+/*********************************************************************
+* Test the median-dual control volume metrics
+*********************************************************************/
+void median_dual()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.5; };
+
+  Domain domain { f, 25.0 };
+  build_tube_bank( domain );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh).modify() );
+  CHECK( mesh.n_quads() > 0 );
+
+  MeshDual dual { mesh };
+  dual.compute();
+
+  CHECK( dual.matches( mesh ) );
+  CHECK( dual.volumes().size() == mesh.n_vertices() );
+  CHECK( dual.face_normals().size() == mesh.n_edges() );
+  CHECK( dual.boundary_normals().size() == mesh.n_boundary_edges() );
+
+  // The dual cells cover the mesh
+  double area = 0.0;
+  for ( const auto& q_ptr : mesh.quads() )
+    area += q_ptr->area();
+  for ( const auto& t_ptr : mesh.triangles() )
+    area += t_ptr->area();
+
+  double dual_area = 0.0;
+  for ( double v : dual.volumes() )
+  {
+    CHECK( v > 0.0 );
+    dual_area += v;
+  }
+
+  CHECK( ABS(dual_area - area) < 1.0E-10 * area );
+
+  // Every dual cell is closed
+  std::vector<Vec2d> closure ( mesh.n_vertices(), {0.0, 0.0} );
+
+  for ( size_t i = 0; i < dual.edges().size(); ++i )
+  {
+    closure[ dual.edges()[i][0] ] += dual.face_normals()[i];
+    closure[ dual.edges()[i][1] ] -= dual.face_normals()[i];
+  }
+
+  for ( size_t i = 0; i < dual.boundary_edges().size(); ++i )
+  {
+    closure[ dual.boundary_edges()[i][0] ] += 0.5 * dual.boundary_normals()[i];
+    closure[ dual.boundary_edges()[i][1] ] += 0.5 * dual.boundary_normals()[i];
+  }
+
+  double max_closure = 0.0;
+  for ( const Vec2d& c : closure )
+    max_closure = MAX( max_closure, c.norm() );
+
+  CHECK( max_closure < 1.0E-10 );
+
+  // Chunked computation yields identical results
+  MeshDual dual_chunked { mesh };
+  dual_chunked.n_threads( 4 ).min_chunk_size( 64 );
+  dual_chunked.compute();
+
+  CHECK( dual_chunked.volumes() == dual.volumes() );
+  CHECK( dual_chunked.edges() == dual.edges() );
+
+  bool equal_normals = true;
+  for ( size_t i = 0; i < dual.face_normals().size(); ++i )
+    if ( ( dual.face_normals()[i] - dual_chunked.face_normals()[i] ).norm() 
+         > 0.0 )
+      equal_normals = false;
+
+  CHECK( equal_normals );
+
+  std::ostringstream os {};
+  dual.write( os );
+  CHECK( os.str().find( "DUALBOUNDARYFACES" ) != std::string::npos );
+
+  // Export along with the mesh
+  std::string source_dir { TQMESH_SOURCE_DIR };
+  std::string filepath 
+  { source_dir + "/auxiliary/test_data/MeshGeneratorTests.median_dual" };
+
+  MeshExportOptions options {};
+  options.dual = &dual;
+
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::TXT,
+                               options ) );
+  CHECK( generator.write_mesh( mesh, filepath, MeshExportType::VTU,
+                               options ) );
+
+  std::ifstream infile { filepath + ".txt" };
+  std::stringstream content {};
+  content << infile.rdbuf();
+
+  CHECK( content.str().find( "DUALVOLUMES" ) != std::string::npos );
+
+} // median_dual()
+
+/*********************************************************************
+* Test the Delaunay refinement by circumcenter insertion
+*********************************************************************/
+void delaunay_refinement()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.5; };
+
+  Domain domain { f, 25.0 };
+  build_tube_bank( domain );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  CHECK( generator.triangulation(mesh).generate_elements() );
+
+  const int color = mesh.triangles()[0].color();
+  const size_t n_bdry_edges = mesh.n_boundary_edges();
+
+  double area = 0.0;
+  for ( const auto& t_ptr : mesh.triangles() )
+    area += t_ptr->area();
+
+  // Refine to half of the size function
+  DelaunayRefinementStrategy& refinement 
+    = generator.delaunay_refinement(mesh);
+
+  refinement.size_factor( 0.5 );
+
+  CHECK( refinement.refine() );
+  CHECK( refinement.n_insertions() > 0 );
+  CHECK( refinement.n_boundary_splits() > 0 );
+  CHECK( mesh.n_boundary_edges() 
+         == n_bdry_edges + refinement.n_boundary_splits() );
+  CHECK( EntityChecks::check_mesh_validity(mesh, MeshCheckMode::EdgeTable) );
+
+  double refined_area = 0.0;
+  bool size_met    = true;
+  bool quality_met = true;
+  bool color_kept  = true;
+
+  for ( const auto& t_ptr : mesh.triangles() )
+  {
+    const Triangle& t = *t_ptr;
+    refined_area += t.area();
+
+    if ( t.max_edge_length() > 0.25 * ( 1.0 + 1.0E-8 ) )
+      size_met = false;
+
+    if (  t.min_edge_length() > 0.05 
+       && t.circumradius() > M_SQRT2 * t.min_edge_length() )
+      quality_met = false;
+
+    if ( t.color() != color )
+      color_kept = false;
+  }
+
+  CHECK( ABS(refined_area - area) < 1.0E-10 * area );
+  CHECK( size_met );
+  CHECK( quality_met );
+  CHECK( color_kept );
+
+  // The facet connectivity of the split boundary edges is updated
+  bool bdry_connected = true;
+
+  for ( const auto& e_ptr : mesh.boundary_edges() )
+  {
+    const Facet* f = e_ptr->facet_l();
+
+    if (  !f || !e_ptr->v1().on_boundary()
+       || f->get_edge_index( e_ptr->v1(), e_ptr->v2() ) < 0 )
+      bdry_connected = false;
+  }
+
+  CHECK( bdry_connected );
+
+  // Quad meshes can not be refined by vertex insertion
+  Domain domain_q { f, 25.0 };
+  build_tube_bank( domain_q );
+
+  Mesh& mesh_q = generator.new_mesh( domain_q );
+  CHECK( generator.triangulation(mesh_q).generate_elements() );
+  CHECK( generator.tri2quad_modification(mesh_q).modify() );
+  CHECK( !generator.delaunay_refinement(mesh_q).refine() );
+
+} // delaunay_refinement()
+
+/*********************************************************************
+* Test the Delaunay refinement of a merged mesh with two colors
+*********************************************************************/
+void delaunay_refinement_colors()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 1.0; };
+
+  Domain domain_1 { f, 20.0 };
+  Domain domain_2 { f, 20.0 };
+
+  Vertex& v1_1 = domain_1.add_vertex(  0.0,  0.0 );
+  Vertex& v2_1 = domain_1.add_vertex(  5.0,  0.0 );
+  Vertex& v3_1 = domain_1.add_vertex(  5.0,  5.0 );
+  Vertex& v4_1 = domain_1.add_vertex(  0.0,  5.0 );
+
+  Vertex& v1_2 = domain_2.add_vertex(  5.0,  0.0 );
+  Vertex& v2_2 = domain_2.add_vertex( 10.0,  0.0 );
+  Vertex& v3_2 = domain_2.add_vertex( 10.0,  5.0 );
+  Vertex& v4_2 = domain_2.add_vertex(  5.0,  5.0 );
+
+  Boundary& bdry_1 = domain_1.add_exterior_boundary();
+  Boundary& bdry_2 = domain_2.add_exterior_boundary();
+  
+  bdry_1.add_edge( v1_1, v2_1, 1 );
+  bdry_1.add_edge( v2_1, v3_1, 1 );
+  bdry_1.add_edge( v3_1, v4_1, 1 );
+  bdry_1.add_edge( v4_1, v1_1, 1 );
+
+  bdry_2.add_edge( v1_2, v2_2, 1 );
+  bdry_2.add_edge( v2_2, v3_2, 1 );
+  bdry_2.add_edge( v3_2, v4_2, 1 );
+  bdry_2.add_edge( v4_2, v1_2, 1 );
+
+  MeshGenerator generator {};
+  Mesh& mesh_1 = generator.new_mesh( domain_1, 1, 1 );
+  Mesh& mesh_2 = generator.new_mesh( domain_2, 2, 2 );
+
+  CHECK( generator.triangulation(mesh_1).generate_elements() );
+  CHECK( generator.triangulation(mesh_2).generate_elements() );
+  CHECK( generator.merge_meshes( mesh_1, mesh_2 ) );
+
+  // Refine the merged mesh to half of the size function
+  DelaunayRefinementStrategy& refinement 
+    = generator.delaunay_refinement(mesh_1);
+
+  refinement.size_factor( 0.5 );
+
+  CHECK( refinement.refine() );
+  CHECK( refinement.n_insertions() > 0 );
+  CHECK( refinement.n_interface_splits() > 0 );
+  CHECK( EntityChecks::check_mesh_validity(mesh_1, 
+                                           MeshCheckMode::EdgeTable) );
+
+  // The colored areas are kept
+  double area_1 = 0.0;
+  double area_2 = 0.0;
+  bool   colors_kept = true;
+
+  for ( const auto& t_ptr : mesh_1.triangles() )
+  {
+    const Triangle& t = *t_ptr;
+
+    if ( t.color() == 1 && t.xy().x < 5.0 )
+      area_1 += t.area();
+    else if ( t.color() == 2 && t.xy().x > 5.0 )
+      area_2 += t.area();
+    else
+      colors_kept = false;
+  }
+
+  CHECK( colors_kept );
+  CHECK( ABS(area_1 - 25.0) < 1.0E-10 );
+  CHECK( ABS(area_2 - 25.0) < 1.0E-10 );
+
+} // delaunay_refinement_colors()
+
+/*********************************************************************
+* Test the mesh generation with a uniform size background grid
+*********************************************************************/
+void uniform_size_grid()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 2.5; };
+
+  Domain domain { f, 20.0 };
+
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex(  5.0,  0.0 );
+  Vertex& v3 = domain.add_vertex(  5.0,  5.0 );
+  Vertex& v4 = domain.add_vertex(  0.0,  5.0 );
+
+  Boundary& bdry = domain.add_exterior_boundary();
+  bdry.add_edge( v1, v2, 1 );
+  bdry.add_edge( v2, v3, 1 );
+  bdry.add_edge( v3, v4, 1 );
+  bdry.add_edge( v4, v1, 1 );
+
+  // Look up the uniform size from a background grid
+  domain.init_uniform_size_grid( 1.0 );
+  CHECK( domain.uniform_size_grid().n_uniform_cells() == 25 );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  CHECK(
+    generator.quad_layer_generation(mesh)
+      .n_layers( 1 )
+      .first_height( 0.20 )
+      .growth_rate( 1.0 )
+      .starting_position( 0.0, 0.0 )
+      .ending_position( 0.0, 0.0 )
+      .generate_elements()
+  );
+
+  CHECK( generator.triangulation(mesh)
+           .check_front( true ).generate_elements() );
+  CHECK( mesh.n_quads() == 8 );
+  CHECK( EntityChecks::check_mesh_validity( mesh ) );
+  CHECK( EntityChecks::check_mesh_validity( mesh, 
+                                            MeshCheckMode::EdgeTable ) );
+
+} // uniform_size_grid()
+
 } // namespace MeshGeneratorTests
 
 /*********************************************************************
@@ -346,6 +2172,72 @@ void run_tests_MeshGenerator()
   //adjust_logging_output_stream("MeshGeneratorTests.multiple_neighbors.log");
   //MeshGeneratorTests::multiple_neighbors();
 
+  adjust_logging_output_stream("MeshGeneratorTests.deterministic_output.log");
+  MeshGeneratorTests::deterministic_output();
+
+  adjust_logging_output_stream("MeshGeneratorTests.quad_layer_markers.log");
+  MeshGeneratorTests::quad_layer_markers();
+
+  adjust_logging_output_stream("MeshGeneratorTests.quad_layer_adjacent_walls.log");
+  MeshGeneratorTests::quad_layer_adjacent_walls();
+
+  adjust_logging_output_stream("MeshGeneratorTests.triangle_layers.log");
+  MeshGeneratorTests::triangle_layers();
+
+  adjust_logging_output_stream("MeshGeneratorTests.triangle_score.log");
+  MeshGeneratorTests::triangle_score();
+
+  adjust_logging_output_stream("MeshGeneratorTests.strategy_workspaces.log");
+  MeshGeneratorTests::strategy_workspaces();
+
+  adjust_logging_output_stream("MeshGeneratorTests.tiled_mesh.log");
+  MeshGeneratorTests::tiled_mesh();
+
+  adjust_logging_output_stream("MeshGeneratorTests.warm_start.log");
+  MeshGeneratorTests::warm_start();
+
+  adjust_logging_output_stream("MeshGeneratorTests.warm_start_local_change.log");
+  MeshGeneratorTests::warm_start_local_change();
+
+  adjust_logging_output_stream("MeshGeneratorTests.periodic_pairs.log");
+  MeshGeneratorTests::periodic_pairs();
+
+  adjust_logging_output_stream("MeshGeneratorTests.valence_modification.log");
+  MeshGeneratorTests::valence_modification();
+
+  adjust_logging_output_stream("MeshGeneratorTests.valence_split_revert.log");
+  MeshGeneratorTests::valence_split_revert();
+
+  adjust_logging_output_stream("MeshGeneratorTests.front_monitor.log");
+  MeshGeneratorTests::front_monitor();
+
+  adjust_logging_output_stream("MeshGeneratorTests.front_retreat.log");
+  MeshGeneratorTests::front_retreat();
+
+  adjust_logging_output_stream("MeshGeneratorTests.coherent_front_order.log");
+  MeshGeneratorTests::coherent_front_order();
+
+  adjust_logging_output_stream("MeshGeneratorTests.validation_cascade.log");
+  MeshGeneratorTests::validation_cascade();
+
+  adjust_logging_output_stream("MeshGeneratorTests.high_order_elements.log");
+  MeshGeneratorTests::high_order_elements();
+
+  adjust_logging_output_stream("MeshGeneratorTests.element_coloring.log");
+  MeshGeneratorTests::element_coloring();
+
+  adjust_logging_output_stream("MeshGeneratorTests.median_dual.log");
+  MeshGeneratorTests::median_dual();
+
+  adjust_logging_output_stream("MeshGeneratorTests.delaunay_refinement.log");
+  MeshGeneratorTests::delaunay_refinement();
+
+  adjust_logging_output_stream("MeshGeneratorTests.delaunay_refinement_colors.log");
+  MeshGeneratorTests::delaunay_refinement_colors();
+
+  adjust_logging_output_stream("MeshGeneratorTests.uniform_size_grid.log");
+  MeshGeneratorTests::uniform_size_grid();
+
   // Reset debug logging ostream
   adjust_logging_output_stream("COUT");
 
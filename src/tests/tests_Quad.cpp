@@ -60,6 +60,64 @@ void initialization()
 
 } // initialization()
 
+/*********************************************************************
+* Test quad proximity checks with advancing front edges
+*********************************************************************/
+void front_proximity()
+{
+  Vertices vertices { 20.0 };
+  Quads    quads { 20.0 };
+
+  Vertex& v1 = vertices.push_back(  0.0,  0.0 );
+  Vertex& v2 = vertices.push_back(  2.0,  0.0 );
+  Vertex& v3 = vertices.push_back(  2.0,  2.0 );
+  Vertex& v4 = vertices.push_back(  0.0,  2.0 );
+
+  Quad& q1 = quads.push_back( v1, v2, v3, v4 );
+
+  // Distance kernel must match the point-segment distances
+  const std::array<Vec2d,4> q_xy { v1.xy(), v2.xy(), v3.xy(), v4.xy() };
+
+  for ( const Vec2d& p : { Vec2d{ 3.0, 1.0}, Vec2d{-1.0,-1.0}, 
+                           Vec2d{ 1.0, 0.5}, Vec2d{ 2.5, 2.5} } )
+  {
+    const double d_ref = MIN( 
+      MIN( distance_point_edge_sqr(p, v1.xy(), v2.xy()),
+           distance_point_edge_sqr(p, v2.xy(), v3.xy()) ),
+      MIN( distance_point_edge_sqr(p, v3.xy(), v4.xy()),
+           distance_point_edge_sqr(p, v4.xy(), v1.xy()) ) );
+
+    CHECK( EQ( QuadGeometry::calc_edge_distance_sqr(p, q_xy), d_ref ) );
+  }
+
+  // Front with a single long edge far away from the quad
+  Vertex& w1 = vertices.push_back(  -5.0,  6.0 );
+  Vertex& w2 = vertices.push_back(   7.0,  6.0 );
+  Vertex& w3 = vertices.push_back(   2.2,  1.0 );
+  Vertex& w4 = vertices.push_back(   4.0,  1.0 );
+  Vertex& w5 = vertices.push_back(   1.0, -3.0 );
+  Vertex& w6 = vertices.push_back(   1.0,  1.0 );
+
+  Front front { };
+  front.add_edge( w1, w2 );
+
+  CHECK( !q1.is_too_close( front, 20.0, 0.25 ) );
+  CHECK( !q1.intersects_front( front, 20.0 ) );
+
+  // Edge with a vertex close to the right side of the quad
+  front.add_edge( w3, w4 );
+
+  CHECK( q1.is_too_close( front, 20.0, 0.25 ) );
+  CHECK( !q1.is_too_close( front, 20.0, 0.01 ) );
+  CHECK( !q1.intersects_front( front, 20.0 ) );
+
+  // Edge that crosses the quad
+  front.add_edge( w5, w6 );
+
+  CHECK( q1.intersects_front( front, 20.0 ) );
+
+} // front_proximity()
+
 } // namespace QuadTests
 
 
@@ -69,5 +127,6 @@ void initialization()
 void run_tests_Quad()
 {
   QuadTests::initialization();
+  QuadTests::front_proximity();
 
 } // run_tests_Quad()
@@ -9,6 +9,8 @@
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <numeric>
+#include <sstream>
 
 #include <TQMeshConfig.h>
 
@@ -23,6 +25,7 @@
 #include "Vertex.h"
 #include "Edge.h"
 #include "Domain.h"
+#include "MeshGenerator.h"
 
 namespace SizeFunctionTests 
 {
@@ -104,6 +107,295 @@ void evaluation()
 
 } // evaluation()
 
+/*********************************************************************
+* Test the detection of uniform size regions
+*********************************************************************/
+void uniform_size_grid()
+{
+  UserSizeFunction f = [](const Vec2d& p) 
+  { return (p.x < 5.0) ? 0.5 : 0.5 + 0.1*(p.x-5.0); };
+
+  Domain domain { f };
+
+  Boundary&  b_ext = domain.add_exterior_boundary();
+
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex( 10.0,  0.0 );
+  Vertex& v3 = domain.add_vertex( 10.0, 10.0 );
+  Vertex& v4 = domain.add_vertex(  0.0, 10.0 );
+
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  domain.add_fixed_vertex( 2.0, 8.0, 0.1, 1.0 );
+
+  // Reference values of the full size function evaluation
+  std::vector<Vec2d>  points {};
+  std::vector<double> h_ref  {};
+
+  for ( int j = 0; j < 40; ++j )
+    for ( int i = 0; i < 40; ++i )
+    {
+      const Vec2d xy { 0.125 + 0.25*i, 0.125 + 0.25*j };
+      points.push_back( xy );
+      h_ref.push_back( domain.size_function( xy ) );
+    }
+
+  const double tol = 1.0E-2;
+  domain.init_uniform_size_grid( 0.5, tol );
+
+  const UniformSizeGrid& grid = domain.uniform_size_grid();
+
+  CHECK( grid.n_cells() == 400 );
+  CHECK( grid.n_uniform_cells() > 0 );
+  CHECK( grid.n_uniform_cells() < 200 );
+
+  double h = 0.0;
+
+  // Constant region away from the fixed vertex
+  CHECK( grid.lookup( {2.0, 2.0}, h ) );
+  CHECK( EQ(h, 0.5) );
+
+  // Fixed vertex vicinity, graded region and outside of the grid
+  CHECK( !grid.lookup( {2.0, 8.0}, h ) );
+  CHECK( !grid.lookup( {3.5, 8.0}, h ) );
+  CHECK( !grid.lookup( {7.0, 2.0}, h ) );
+  CHECK( !grid.lookup( {-1.0, 2.0}, h ) );
+
+  // Deviation to the full evaluation stays within the tolerance
+  for ( size_t i = 0; i < points.size(); ++i )
+  {
+    const double h_i = domain.size_function( points[i] );
+    CHECK( ABS(h_i - h_ref[i]) <= tol * h_ref[i] );
+  }
+
+  // Removing the grid restores the full evaluation
+  domain.clear_uniform_size_grid();
+  CHECK( grid.empty() );
+  CHECK( EQ(domain.size_function( points[0] ), h_ref[0]) );
+
+  // New boundaries and fixed vertices invalidate the grid
+  domain.init_uniform_size_grid( 0.5, tol );
+  CHECK( !grid.empty() );
+  domain.add_fixed_vertex( 8.0, 2.0, 0.1, 1.0 );
+  CHECK( grid.empty() );
+
+  domain.init_uniform_size_grid( 0.5, tol );
+  CHECK( !grid.empty() );
+  domain.add_interior_boundary();
+  CHECK( grid.empty() );
+
+} // uniform_size_grid()
+
+/*********************************************************************
+* Test the Lipschitz margin of the uniform size regions
+*********************************************************************/
+void uniform_size_grid_margin()
+{
+  // Thin refinement band, which falls in between the samples
+  const double L = 8.0;
+
+  UserSizeFunction f = [L](const Vec2d& p) 
+  { return 0.5 - 0.4 * MAX(0.0, 1.0 - L/0.4 * ABS(p.x - 1.3)); };
+
+  Domain domain { f };
+
+  Boundary&  b_ext = domain.add_exterior_boundary();
+
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex( 10.0,  0.0 );
+  Vertex& v3 = domain.add_vertex( 10.0, 10.0 );
+  Vertex& v4 = domain.add_vertex(  0.0, 10.0 );
+
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  const UniformSizeGrid& grid = domain.uniform_size_grid();
+  double h = 0.0;
+
+  // Without a margin, the band is missed by the samples
+  domain.init_uniform_size_grid( 0.5, 1.0E-2, 4 );
+  CHECK( grid.lookup( {1.3, 5.0}, h ) );
+  CHECK( EQ(h, 0.5) );
+
+  // The Lipschitz margin turns the samples into strict bounds
+  domain.init_uniform_size_grid( 0.5, 1.0E-2, 4, L );
+  CHECK( EQ(grid.margin(), L * 0.125 * M_SQRT1_2) );
+  CHECK( !grid.lookup( {1.3, 5.0}, h ) );
+
+} // uniform_size_grid_margin()
+
+/*********************************************************************
+* Test the profiling of size function evaluations
+*********************************************************************/
+void profiler()
+{
+  UserSizeFunction f = [](const Vec2d& p) { return 0.3 + 0.1*p.x; };
+
+  Domain domain { f, 10.0 };
+
+  Boundary&  b_ext = domain.add_exterior_boundary();
+
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex(  4.0,  0.0 );
+  Vertex& v3 = domain.add_vertex(  4.0,  4.0 );
+  Vertex& v4 = domain.add_vertex(  0.0,  4.0 );
+
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  SizeFunctionProfiler& profiler = domain.size_function_profiler();
+
+  // Profiling is disabled by default
+  domain.size_function( {1.0, 1.0} );
+  CHECK( profiler.n_calls() == 0 );
+
+  profiler.enable( true );
+  profiler.init_heat_map( {-0.5, -0.5}, {4.5, 4.5}, 10, 10 );
+
+  MeshGenerator generator {};
+  Mesh& mesh = generator.new_mesh( domain );
+
+  CHECK( profiler.n_calls(SizeFunctionPhase::FrontRefinement) > 0 );
+  CHECK( profiler.n_calls(SizeFunctionPhase::CandidateCreation) == 0 );
+
+  CHECK( generator.triangulation(mesh).generate_elements() );
+  CHECK( generator.laplace_smoothing(mesh).smooth(2) );
+
+  CHECK( profiler.n_calls(SizeFunctionPhase::CandidateCreation) > 0 );
+  CHECK( profiler.n_calls(SizeFunctionPhase::Ranking) > 0 );
+  CHECK( profiler.n_calls(SizeFunctionPhase::Export) == 0 );
+
+  std::string source_dir { TQMESH_SOURCE_DIR };
+  std::string file_name 
+  { source_dir + "/auxiliary/test_data/SizeFunctionTests.profiler" };
+
+  CHECK( generator.write_mesh( mesh, file_name, MeshExportType::TXT ) );
+
+  CHECK( profiler.n_calls(SizeFunctionPhase::Export) 
+         >= mesh.vertices().size() );
+
+  // All evaluations are located in the heat map
+  const std::vector<size_t>& heat_map = profiler.heat_map();
+  const size_t n_map = std::accumulate(heat_map.begin(), heat_map.end(), 
+                                       size_t{0});
+
+  CHECK( n_map == profiler.n_calls() );
+  CHECK( profiler.n_outside_heat_map() == 0 );
+  CHECK( profiler.time() > 0.0 );
+
+  std::ofstream outfile;
+  outfile.open( file_name + ".profile.txt" );
+  profiler.write_report( outfile );
+  profiler.export_heat_map( outfile );
+  outfile.close();
+
+  // Reset the counters
+  profiler.reset();
+  CHECK( profiler.n_calls() == 0 );
+  CHECK( profiler.heat_map().size() == 100 );
+
+} // profiler()
+
+/*********************************************************************
+* Test the adaptive tree approximation of the user size function
+*********************************************************************/
+void size_function_tree()
+{
+  size_t n_calls = 0;
+
+  UserSizeFunction f = [&n_calls](const Vec2d& p) 
+  { 
+    ++n_calls;
+    const double r_sqr = (p.x-2.0)*(p.x-2.0) + (p.y-3.0)*(p.y-3.0);
+    return 0.5 - 0.4 * exp( -r_sqr ); 
+  };
+
+  Domain domain { f, 20.0 };
+
+  Boundary&  b_ext = domain.add_exterior_boundary();
+
+  Vertex& v1 = domain.add_vertex(  0.0,  0.0 );
+  Vertex& v2 = domain.add_vertex( 10.0,  0.0 );
+  Vertex& v3 = domain.add_vertex( 10.0,  5.0 );
+  Vertex& v4 = domain.add_vertex(  0.0,  5.0 );
+
+  b_ext.add_edge( v1, v2, 1 );
+  b_ext.add_edge( v2, v3, 1 );
+  b_ext.add_edge( v3, v4, 1 );
+  b_ext.add_edge( v4, v1, 1 );
+
+  // Reference values of the full size function evaluation
+  std::vector<Vec2d>  points {};
+  std::vector<double> h_ref  {};
+
+  for ( int j = 0; j < 25; ++j )
+    for ( int i = 0; i < 50; ++i )
+    {
+      const Vec2d xy { 0.1 + 0.2*i, 0.1 + 0.2*j };
+      points.push_back( xy );
+      h_ref.push_back( domain.size_function( xy ) );
+    }
+
+  const double tol = 1.0E-3;
+  domain.init_size_function_tree( tol, 10, 2 );
+
+  const SizeFunctionTree& tree = domain.size_function_tree();
+
+  CHECK( !tree.empty() );
+  CHECK( tree.n_unresolved_cells() == 0 );
+  CHECK( tree.max_error() <= tol );
+  CHECK( tree.n_samples() == n_calls - points.size() );
+
+  // The tree is refined around the feature only
+  CHECK( tree.depth() > 4 );
+  CHECK( tree.n_leaves() < (size_t{1} << (2*tree.depth())) / 10 );
+
+  double h = 0.0;
+  CHECK( tree.lookup( {2.0, 3.0}, h ) );
+  CHECK( ABS(h - 0.1) <= tol * 0.1 );
+  CHECK( !tree.lookup( {-1.0, 2.0}, h ) );
+
+  // Evaluations inside of the tree do not call the user function
+  const size_t n_init = n_calls;
+
+  for ( size_t i = 0; i < points.size(); ++i )
+  {
+    const double h_i = domain.size_function( points[i] );
+    CHECK( ABS(h_i - h_ref[i]) <= 2.0 * tol * h_ref[i] );
+  }
+
+  CHECK( n_calls == n_init );
+
+  std::ostringstream os {};
+  tree.write( os );
+  CHECK( os.str().find( "unresolved cells:   0" ) != std::string::npos );
+
+  // A coarse maximum depth leaves unresolved cells
+  domain.init_size_function_tree( tol, 3, 2 );
+  CHECK( tree.n_unresolved_cells() > 0 );
+  CHECK( tree.max_error() > tol );
+
+  // Removing the tree restores the full evaluation
+  domain.clear_size_function_tree();
+  CHECK( tree.empty() );
+  CHECK( EQ(domain.size_function( points[0] ), h_ref[0]) );
+  CHECK( n_calls > n_init );
+
+  // New boundaries invalidate the tree
+  domain.init_size_function_tree( tol, 3, 2 );
+  CHECK( !tree.empty() );
+  domain.add_interior_boundary();
+  CHECK( tree.empty() );
+
+} // size_function_tree()
+
 
 
 } // namespace SizeFunctionTests
@@ -114,6 +406,22 @@ void evaluation()
 *********************************************************************/
 void run_tests_SizeFunction()
 {
+  adjust_logging_output_stream("SizeFunctionTests.evaluation.log");
   SizeFunctionTests::evaluation();
 
+  adjust_logging_output_stream("SizeFunctionTests.uniform_size_grid.log");
+  SizeFunctionTests::uniform_size_grid();
+
+  adjust_logging_output_stream("SizeFunctionTests.uniform_size_grid_margin.log");
+  SizeFunctionTests::uniform_size_grid_margin();
+
+  adjust_logging_output_stream("SizeFunctionTests.profiler.log");
+  SizeFunctionTests::profiler();
+
+  adjust_logging_output_stream("SizeFunctionTests.size_function_tree.log");
+  SizeFunctionTests::size_function_tree();
+
+  // Reset debug logging ostream
+  adjust_logging_output_stream("COUT");
+
 } // run_tests_SizeFunction()
@@ -210,6 +210,43 @@ void intersects_triangle()
 
 } // intersects_triangle()
 
+/*********************************************************************
+* Test intersection with advancing front edges
+*********************************************************************/
+void intersects_front()
+{
+  Vertices   vertices { };
+  Triangles  triangles { };
+
+  Vertex& v1 = vertices.push_back(  0.0,  0.0 );
+  Vertex& v2 = vertices.push_back(  2.0,  0.0 );
+  Vertex& v3 = vertices.push_back(  2.0,  2.0 );
+
+  Triangle& t1 = triangles.push_back( v1, v2, v3 );
+
+  // Front with a single edge, that is close but does not intersect
+  Vertex& w1 = vertices.push_back( -1.0,  0.5 );
+  Vertex& w2 = vertices.push_back(  1.0,  2.5 );
+
+  Front front { };
+  front.add_edge( w1, w2 );
+
+  CHECK( !t1.intersects_front( front, 20.0 ) );
+
+  // Long edge with a centroid far away from the triangle, 
+  // that ends within the triangle
+  Vertex& w3 = vertices.push_back(  1.5,-20.0 );
+  Vertex& w4 = vertices.push_back(  1.5,  0.5 );
+
+  front.add_edge( w3, w4 );
+
+  CHECK( t1.intersects_front( front, 20.0 ) );
+
+  (void) v1,v2,v3,w1,w2,w3,w4;
+  (void) t1;
+
+} // intersects_front()
+
 } // namespace TriangleTests
 
 
@@ -222,5 +259,6 @@ void run_tests_Triangle()
   TriangleTests::intersects_vertex();
   TriangleTests::intersects_domain();
   TriangleTests::intersects_triangle();
+  TriangleTests::intersects_front();
 
 } // run_tests_Triangle()
@@ -83,9 +83,10 @@ public:
              c.quad_tree().max_items(),
              c.quad_tree().max_depth() }  
   {
-    items_ = std::move(c.items_);
-    qtree_ = std::move(c.qtree_);
-    waste_ = std::move(c.waste_);
+    items_     = std::move(c.items_);
+    qtree_     = std::move(c.qtree_);
+    waste_     = std::move(c.waste_);
+    n_created_ = c.n_created_;
   }
 
   /*------------------------------------------------------------------
@@ -99,6 +100,11 @@ public:
   ------------------------------------------------------------------*/
   size_type size() const { return items_.size(); }
 
+  /*------------------------------------------------------------------
+  | Get the number of items that have been created in this container
+  ------------------------------------------------------------------*/
+  size_t n_created() const { return n_created_; }
+
   /*------------------------------------------------------------------
   | Get reference to the  container qtreee
   ------------------------------------------------------------------*/
@@ -143,9 +149,10 @@ public:
     std::unique_ptr<T> u_ptr = std::make_unique<T>(args...);
     T* ptr = u_ptr.get();
     iterator iter = items_.insert( pos, std::move(u_ptr) );
-    ptr->pos_          = iter;
-    ptr->in_container_ = true;
-    ptr->container_    = this;
+    ptr->pos_            = iter;
+    ptr->in_container_   = true;
+    ptr->container_      = this;
+    ptr->creation_index_ = n_created_++;
     bool in_qtree = qtree_.add( ptr );
 
     // Failed to add element to qtree -> cleanup
@@ -289,6 +296,7 @@ private:
   List               items_;
   QuadTree<T,double> qtree_;
   List               waste_;
+  size_t             n_created_ {0};
 
 
 }; // Container
@@ -314,6 +322,11 @@ public:
   const Iterator& pos() const { return pos_; }
   bool in_container() const { return in_container_; }
 
+  // The creation index is a stable key, that does not depend on 
+  // memory addresses or the order of the container's list. 
+  // It is used to break ties, wherever entities are sorted.
+  size_t creation_index() const { return creation_index_; }
+
   // Destructor for container garbage collector
   virtual void container_destructor() {}
 
@@ -322,6 +335,7 @@ protected:
   Iterator             pos_           {};
   bool                 in_container_  {false};
   Container<Derived>*  container_     {nullptr};
+  size_t               creation_index_ {0};
 
 }; 
 